@@ -0,0 +1,216 @@
+// Player snapshot bandwidth/encode-time benchmark.
+//
+// Simulates N players moving at the server tick rate and encodes, every tick, one PlayerSnapshot
+// frame per recipient the way PlayerManager::buildSnapshotsForRecipients does: remote players
+// quantized, the recipient itself precise, deltas against the frame the client acked
+// `ackDelayTicks` ago (kept in a 32-frame history, like the server). Every frame is then decoded
+// the way the client does and must reproduce the encoded states; a mismatch fails the run.
+//
+// usage: SnapshotCodecBench [seconds=10] [ackDelayTicks=6] [idlePercent=30]
+
+#include "../network/SnapshotCodec.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+namespace Codec = Shared::SnapshotCodec;
+
+constexpr uint32_t kTickRateHz = 60;
+constexpr size_t kHistoryFrames = 32;
+// The pre-codec frame: 21-byte header plus a fixed 85-byte entry per player.
+constexpr size_t kLegacyHeaderBytes = 1 + 4 + 8 + 4 + 4;
+constexpr size_t kLegacyEntryBytes = 8 + (8 * 4) + 3 + 2 + 4 + 1 + 4 + 1 + 4 + 4;
+
+struct SimPlayer {
+    PlayerSnapshot state{};
+    float heading = 0.0f;
+    bool idle = false;
+};
+
+struct History {
+    struct Frame {
+        bool valid = false;
+        uint32_t tick = 0;
+        std::vector<Codec::PlayerState> players;
+    };
+    std::array<Frame, kHistoryFrames> frames;
+};
+
+void StepPlayers(std::vector<SimPlayer>& players, std::mt19937& rng, float dt) {
+    std::uniform_real_distribution<float> turn(-1.5f, 1.5f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for (SimPlayer& p : players) {
+        PlayerSnapshot& s = p.state;
+        if (p.idle) {
+            s.vx = s.vz = 0.0f;
+            s.onGround = 1;
+            continue;
+        }
+        p.heading += turn(rng) * dt;
+        const float speed = 5.6f;
+        s.vx = std::cos(p.heading) * speed;
+        s.vz = std::sin(p.heading) * speed;
+        s.px += s.vx * dt;
+        s.pz += s.vz * dt;
+        s.yaw = std::remainder(p.heading * 57.29578f, 360.0f);
+        s.pitch = std::sin(p.heading * 0.7f) * 20.0f;
+        s.onGround = (unit(rng) > 0.02f) ? 1 : 0;
+        s.timeSinceGrounded = s.onGround ? 0.0f : s.timeSinceGrounded + dt;
+    }
+}
+
+bool SameStates(const std::vector<Codec::PlayerState>& a, const std::vector<Codec::PlayerState>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].id != b[i].id || Codec::DiffFields(a[i], b[i]) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RunCase(size_t playerCount, double seconds, uint32_t ackDelayTicks, int idlePercent) {
+    std::mt19937 rng(static_cast<uint32_t>(playerCount));
+    std::uniform_real_distribution<float> spread(-96.0f, 96.0f);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    std::vector<SimPlayer> players(playerCount);
+    for (size_t i = 0; i < playerCount; ++i) {
+        SimPlayer& p = players[i];
+        p.state.id = static_cast<uint64_t>(i + 1);
+        p.state.px = spread(rng);
+        p.state.py = 40.0f;
+        p.state.pz = spread(rng);
+        p.state.health = 100.0f;
+        p.state.isAlive = 1;
+        p.state.weaponId = 1;
+        p.heading = spread(rng);
+        p.idle = percent(rng) < idlePercent;
+    }
+
+    std::vector<History> histories(playerCount);
+    std::vector<Codec::PlayerState> remote;
+    std::vector<std::vector<uint8_t>> frames(playerCount);
+    std::vector<uint8_t> fullFrame;
+    std::vector<Codec::PlayerState> decoded;
+
+    const uint32_t ticks = static_cast<uint32_t>(seconds * kTickRateHz);
+    const float dt = 1.0f / static_cast<float>(kTickRateHz);
+    uint64_t deltaBytes = 0;
+    uint64_t fullBytes = 0;
+    double encodeUs = 0.0;
+    double decodeUs = 0.0;
+
+    for (uint32_t tick = 1; tick <= ticks; ++tick) {
+        StepPlayers(players, rng, dt);
+
+        const auto encodeStart = std::chrono::steady_clock::now();
+        remote.clear();
+        for (const SimPlayer& p : players) {
+            remote.push_back(Codec::Quantize(p.state, false));
+        }
+        for (size_t r = 0; r < playerCount; ++r) {
+            History& history = histories[r];
+            const uint32_t ackTick = (tick > ackDelayTicks) ? tick - ackDelayTicks : 0;
+            const History::Frame& acked = history.frames[ackTick % kHistoryFrames];
+            const bool hasBaseline = ackTick != 0 && acked.valid && acked.tick == ackTick;
+
+            History::Frame& slot = history.frames[tick % kHistoryFrames];
+            slot.valid = true;
+            slot.tick = tick;
+            slot.players.assign(remote.begin(), remote.end());
+            slot.players[r] = Codec::Quantize(players[r].state, true);
+
+            Codec::FrameHeader header;
+            header.serverTick = tick;
+            header.selfPlayerId = players[r].state.id;
+            header.lastProcessedInputTick = tick;
+            header.hasBaseline = hasBaseline;
+            header.baselineTick = ackTick;
+            frames[r].clear();
+            Codec::EncodeFrame(header, slot.players, hasBaseline ? &acked.players : nullptr, frames[r]);
+            deltaBytes += frames[r].size();
+        }
+        encodeUs += std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - encodeStart
+        ).count();
+
+        // Decode against the same baselines the client would hold.
+        const auto decodeStart = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < playerCount; ++r) {
+            const History& history = histories[r];
+            const uint32_t ackTick = (tick > ackDelayTicks) ? tick - ackDelayTicks : 0;
+            const History::Frame& acked = history.frames[ackTick % kHistoryFrames];
+            const History::Frame& sent = history.frames[tick % kHistoryFrames];
+            Codec::FrameHeader header;
+            const bool ok = Codec::DecodeFrameHeader(frames[r].data(), frames[r].size(), header) &&
+                Codec::DecodeFrame(frames[r].data(), frames[r].size(), header.hasBaseline ? &acked.players : nullptr, header, decoded);
+            if (!ok || header.serverTick != tick || header.selfPlayerId != players[r].state.id ||
+                !SameStates(decoded, sent.players)) {
+                std::fprintf(stderr, "round trip mismatch: players=%zu tick=%u recipient=%zu\n", playerCount, tick, r);
+                return false;
+            }
+        }
+        decodeUs += std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - decodeStart
+        ).count();
+
+        // Same frame without a baseline, for the quantization-only column.
+        Codec::FrameHeader header;
+        header.serverTick = tick;
+        header.selfPlayerId = players[0].state.id;
+        fullFrame.clear();
+        Codec::EncodeFrame(header, histories[0].frames[tick % kHistoryFrames].players, nullptr, fullFrame);
+        fullBytes += fullFrame.size() * playerCount;
+    }
+
+    const double clientSeconds = seconds * static_cast<double>(playerCount);
+    const double legacyPerClient = static_cast<double>(kLegacyHeaderBytes + kLegacyEntryBytes * playerCount) * kTickRateHz;
+    const double fullPerClient = static_cast<double>(fullBytes) / clientSeconds;
+    const double deltaPerClient = static_cast<double>(deltaBytes) / clientSeconds;
+    std::printf(
+        "%8zu %14.0f %14.0f %14.0f %8.1fx %12.1f %12.3f %12.1f\n",
+        playerCount,
+        legacyPerClient,
+        fullPerClient,
+        deltaPerClient,
+        legacyPerClient / std::max(1.0, deltaPerClient),
+        encodeUs / ticks,
+        encodeUs / ticks / static_cast<double>(playerCount),
+        decodeUs / ticks
+    );
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double seconds = (argc > 1) ? std::atof(argv[1]) : 10.0;
+    const uint32_t ackDelayTicks = (argc > 2) ? static_cast<uint32_t>(std::atoi(argv[2])) : 6u;
+    const int idlePercent = (argc > 3) ? std::atoi(argv[3]) : 30;
+
+    std::printf(
+        "seconds=%.1f ackDelayTicks=%u idlePercent=%d tickRate=%u\n",
+        seconds, ackDelayTicks, idlePercent, kTickRateHz
+    );
+    std::printf(
+        "%8s %14s %14s %14s %9s %12s %12s %12s\n",
+        "players", "legacy B/s", "quantized B/s", "delta B/s", "saving", "encode us/t", "us/recip", "decode us/t"
+    );
+    for (size_t playerCount : { 32u, 64u, 128u }) {
+        if (!RunCase(playerCount, seconds, ackDelayTicks, idlePercent)) {
+            return 1;
+        }
+    }
+    return 0;
+}
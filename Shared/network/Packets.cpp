@@ -1,4 +1,5 @@
 #include "Packets.hpp"
+#include "SnapshotCodec.hpp"
 #include <cstring>
 #include <cassert>
 #include <cmath>
@@ -180,7 +181,7 @@ std::optional<ConnectResponse> ConnectResponse::deserialize(const std::vector<ui
 // -------------------- PlayerInput --------------------
 std::vector<uint8_t> PlayerInput::serialize() const {
     std::vector<uint8_t> out;
-    out.reserve(1 + 4 + 1 + 1 + 2 + 4 * 4);
+    out.reserve(1 + 4 + 1 + 1 + 2 + 4 * 4 + 1 + 4);
     write_u8(out, static_cast<uint8_t>(PacketType::PlayerInput));
     write_u32(out, inputTick);
     write_u8(out, inputFlags);
@@ -190,6 +191,8 @@ std::vector<uint8_t> PlayerInput::serialize() const {
     write_f32(out, pitch);
     write_f32(out, moveX);
     write_f32(out, moveZ);
+    write_u8(out, hasSnapshotAck);
+    write_u32(out, ackedSnapshotTick);
     return out;
 }
 
@@ -208,6 +211,8 @@ std::optional<PlayerInput> PlayerInput::deserialize(const std::vector<uint8_t>&
     if (!read_f32(buf, off, p.pitch)) return std::nullopt;
     if (!read_f32(buf, off, p.moveX)) return std::nullopt;
     if (!read_f32(buf, off, p.moveZ)) return std::nullopt;
+    if (!read_u8(buf, off, p.hasSnapshotAck)) return std::nullopt;
+    if (!read_u32(buf, off, p.ackedSnapshotTick)) return std::nullopt;
     if (!std::isfinite(p.yaw) || !std::isfinite(p.pitch) || !std::isfinite(p.moveX) || !std::isfinite(p.moveZ)) {
         return std::nullopt;
     }
@@ -216,10 +221,11 @@ std::optional<PlayerInput> PlayerInput::deserialize(const std::vector<uint8_t>&
 
 std::vector<uint8_t> ShootRequest::serialize() const {
     std::vector<uint8_t> out;
-    out.reserve(1 + 4 + 4 + 2 + 12 + 12 + 4 + 1);
+    out.reserve(1 + 4 + 4 + 1 + 2 + 12 + 12 + 4 + 1);
     write_u8(out, static_cast<uint8_t>(PacketType::ShootRequest));
     write_u32(out, clientShotId);
     write_u32(out, clientTick);
+    write_u8(out, clientTickFraction);
     write_u16(out, weaponId);
     write_f32(out, posX); write_f32(out, posY); write_f32(out, posZ);
     write_f32(out, dirX); write_f32(out, dirY); write_f32(out, dirZ);
@@ -237,6 +243,7 @@ std::optional<ShootRequest> ShootRequest::deserialize(const std::vector<uint8_t>
     ShootRequest r;
     if (!read_u32(buf, off, r.clientShotId)) return std::nullopt;
     if (!read_u32(buf, off, r.clientTick)) return std::nullopt;
+    if (!read_u8(buf, off, r.clientTickFraction)) return std::nullopt;
     if (!read_u16(buf, off, r.weaponId)) return std::nullopt;
     if (!read_f32(buf, off, r.posX)) return std::nullopt;
     if (!read_f32(buf, off, r.posY)) return std::nullopt;
@@ -330,73 +337,40 @@ std::optional<PlayerPosition> PlayerPosition::deserialize(const std::vector<uint
 
 // -------------------- PlayerSnapshotFrame --------------------
 std::vector<uint8_t> PlayerSnapshotFrame::serialize() const {
-    std::vector<uint8_t> out;
-    constexpr size_t kEntrySize = 8 + (8 * 4) + 3 + 2 + 4 + 1 + 4 + 1 + 4 + 4;
-    out.reserve(1 + 4 + 8 + 4 + 4 + players.size() * kEntrySize);
-    write_u8(out, static_cast<uint8_t>(PacketType::PlayerSnapshot));
-    write_u32(out, serverTick);
-    write_u64(out, selfPlayerId);
-    write_u32(out, lastProcessedInputTick);
-    write_u32(out, static_cast<uint32_t>(players.size()));
-    for (const PlayerSnapshot& p : players) {
-        write_u64(out, p.id);
-        write_f32(out, p.px); write_f32(out, p.py); write_f32(out, p.pz);
-        write_f32(out, p.vx); write_f32(out, p.vy); write_f32(out, p.vz);
-        write_f32(out, p.yaw); write_f32(out, p.pitch);
-        write_u8(out, p.onGround);
-        write_u8(out, p.flyMode);
-        write_u8(out, p.allowFlyMode);
-        write_u16(out, p.weaponId);
-        write_f32(out, p.health);
-        write_u8(out, p.isAlive);
-        write_f32(out, p.respawnSeconds);
-        write_u8(out, p.jumpPressedLastTick);
-        write_f32(out, p.timeSinceGrounded);
-        write_f32(out, p.jumpBufferTimer);
+    Shared::SnapshotCodec::FrameHeader header;
+    header.serverTick = serverTick;
+    header.selfPlayerId = selfPlayerId;
+    header.lastProcessedInputTick = lastProcessedInputTick;
+
+    std::vector<PlayerSnapshot> sorted = players;
+    std::sort(sorted.begin(), sorted.end(), [](const PlayerSnapshot& a, const PlayerSnapshot& b) {
+        return a.id < b.id;
+    });
+    std::vector<Shared::SnapshotCodec::PlayerState> states;
+    states.reserve(sorted.size());
+    for (const PlayerSnapshot& p : sorted) {
+        states.push_back(Shared::SnapshotCodec::Quantize(p, p.id == selfPlayerId));
     }
+
+    std::vector<uint8_t> out;
+    Shared::SnapshotCodec::EncodeFrame(header, states, nullptr, out);
     return out;
 }
 
 std::optional<PlayerSnapshotFrame> PlayerSnapshotFrame::deserialize(const std::vector<uint8_t>& buf) {
-    size_t off = 0;
-    uint8_t type = 0;
-    uint32_t count = 0;
-    constexpr size_t kEntrySize = 8 + (8 * 4) + 3 + 2 + 4 + 1 + 4 + 1 + 4 + 4;
-
-    if (!read_u8(buf, off, type)) return std::nullopt;
-    if (type != static_cast<uint8_t>(PacketType::PlayerSnapshot)) return std::nullopt;
+    Shared::SnapshotCodec::FrameHeader header;
+    std::vector<Shared::SnapshotCodec::PlayerState> states;
+    if (!Shared::SnapshotCodec::DecodeFrame(buf.data(), buf.size(), nullptr, header, states)) {
+        return std::nullopt;
+    }
 
     PlayerSnapshotFrame frame;
-    if (!read_u32(buf, off, frame.serverTick)) return std::nullopt;
-    if (!read_u64(buf, off, frame.selfPlayerId)) return std::nullopt;
-    if (!read_u32(buf, off, frame.lastProcessedInputTick)) return std::nullopt;
-    if (!read_u32(buf, off, count)) return std::nullopt;
-    if (count > ((buf.size() - off) / kEntrySize)) return std::nullopt;
-
-    frame.players.clear();
-    frame.players.reserve(count);
-    for (uint32_t i = 0; i < count; ++i) {
-        PlayerSnapshot p{};
-        if (!read_u64(buf, off, p.id)) return std::nullopt;
-        if (!read_f32(buf, off, p.px)) return std::nullopt;
-        if (!read_f32(buf, off, p.py)) return std::nullopt;
-        if (!read_f32(buf, off, p.pz)) return std::nullopt;
-        if (!read_f32(buf, off, p.vx)) return std::nullopt;
-        if (!read_f32(buf, off, p.vy)) return std::nullopt;
-        if (!read_f32(buf, off, p.vz)) return std::nullopt;
-        if (!read_f32(buf, off, p.yaw)) return std::nullopt;
-        if (!read_f32(buf, off, p.pitch)) return std::nullopt;
-        if (!read_u8(buf, off, p.onGround)) return std::nullopt;
-        if (!read_u8(buf, off, p.flyMode)) return std::nullopt;
-        if (!read_u8(buf, off, p.allowFlyMode)) return std::nullopt;
-        if (!read_u16(buf, off, p.weaponId)) return std::nullopt;
-        if (!read_f32(buf, off, p.health)) return std::nullopt;
-        if (!read_u8(buf, off, p.isAlive)) return std::nullopt;
-        if (!read_f32(buf, off, p.respawnSeconds)) return std::nullopt;
-        if (!read_u8(buf, off, p.jumpPressedLastTick)) return std::nullopt;
-        if (!read_f32(buf, off, p.timeSinceGrounded)) return std::nullopt;
-        if (!read_f32(buf, off, p.jumpBufferTimer)) return std::nullopt;
-        frame.players.push_back(p);
+    frame.serverTick = header.serverTick;
+    frame.selfPlayerId = header.selfPlayerId;
+    frame.lastProcessedInputTick = header.lastProcessedInputTick;
+    frame.players.reserve(states.size());
+    for (const Shared::SnapshotCodec::PlayerState& state : states) {
+        frame.players.push_back(Shared::SnapshotCodec::Dequantize(state, state.id == header.selfPlayerId));
     }
     return frame;
 }
@@ -615,7 +589,7 @@ std::optional<BlockPlaceResult> BlockPlaceResult::deserialize(const std::vector<
     if (!read_u8(buf, off, accepted)) return std::nullopt;
     if (!read_u8(buf, off, rejectRaw)) return std::nullopt;
     if (!read_u16(buf, off, chunkCount)) return std::nullopt;
-    if (rejectRaw > static_cast<uint8_t>(BlockPlaceRejectReason::ServerError)) return std::nullopt;
+    if (rejectRaw > static_cast<uint8_t>(BlockPlaceRejectReason::ChunkNotLoaded)) return std::nullopt;
     if (chunkCount > ((buf.size() - off) / 12)) return std::nullopt;
 
     result.accepted = accepted ? 1u : 0u;
@@ -709,7 +683,7 @@ std::optional<BlockBreakResult> BlockBreakResult::deserialize(const std::vector<
     if (!read_u8(buf, off, accepted)) return std::nullopt;
     if (!read_u8(buf, off, rejectRaw)) return std::nullopt;
     if (!read_u16(buf, off, chunkCount)) return std::nullopt;
-    if (rejectRaw > static_cast<uint8_t>(BlockBreakRejectReason::ServerError)) return std::nullopt;
+    if (rejectRaw > static_cast<uint8_t>(BlockBreakRejectReason::ChunkNotLoaded)) return std::nullopt;
     if (chunkCount > ((buf.size() - off) / 12)) return std::nullopt;
 
     result.accepted = accepted ? 1u : 0u;
@@ -850,8 +824,13 @@ std::optional<InventorySnapshot> InventorySnapshot::deserialize(const std::vecto
 // -------------------- WorldItemSnapshot --------------------
 std::vector<uint8_t> WorldItemSnapshot::serialize() const {
     std::vector<uint8_t> out;
+    serialize(out);
+    return out;
+}
+
+void WorldItemSnapshot::serialize(std::vector<uint8_t>& out) const {
     constexpr size_t kEntrySize = 8 + 2 + 2 + (6 * 4);
-    out.reserve(1 + 4 + 2 + (items.size() * kEntrySize));
+    out.reserve(out.size() + 1 + 4 + 2 + (items.size() * kEntrySize));
     write_u8(out, static_cast<uint8_t>(PacketType::WorldItemSnapshot));
     write_u32(out, serverTick);
     write_u16(out, static_cast<uint16_t>(items.size()));
@@ -866,7 +845,6 @@ std::vector<uint8_t> WorldItemSnapshot::serialize() const {
         write_f32(out, item.vy);
         write_f32(out, item.vz);
     }
-    return out;
 }
 
 std::optional<WorldItemSnapshot> WorldItemSnapshot::deserialize(const std::vector<uint8_t>& buf) {
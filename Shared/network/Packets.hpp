@@ -18,7 +18,7 @@ constexpr uint8_t kPlayerInputFlagSprint = 1u << 5;
 constexpr uint8_t kPlayerInputFlagFlyUp = 1u << 6;
 constexpr uint8_t kPlayerInputFlagFlyDown = 1u << 7;
 
-constexpr uint16_t kVoxelOpsProtocolVersion = 10;
+constexpr uint16_t kVoxelOpsProtocolVersion = 13;
 constexpr size_t kMaxConnectIdentityChars = 64;
 constexpr size_t kMaxConnectUsernameChars = 32;
 constexpr size_t kMaxConnectMessageChars = 120;
@@ -62,6 +62,9 @@ struct PlayerInput {
     float pitch = 0.f;
     float moveX = 0.f;
     float moveZ = 0.f;
+    // Newest PlayerSnapshot serverTick the client has decoded; the server deltas against it.
+    uint8_t hasSnapshotAck = 0;
+    uint32_t ackedSnapshotTick = 0;
 
     std::vector<uint8_t> serialize() const;
     static std::optional<PlayerInput> deserialize(const std::vector<uint8_t>& buf);
@@ -70,6 +73,7 @@ struct PlayerInput {
 struct ShootRequest {
     uint32_t clientShotId = 0;
     uint32_t clientTick = 0;
+    uint8_t  clientTickFraction = 0; // 1/256ths of a tick past clientTick (interpolated view time)
     uint16_t weaponId = 0;
     float    posX = 0.f, posY = 0.f, posZ = 0.f;
     float    dirX = 0.f, dirY = 0.f, dirZ = 0.f;
@@ -125,16 +129,32 @@ struct PlayerSnapshot{
     float jumpBufferTimer = 0.0f;
 };
 
+// Wire form is produced by Shared::SnapshotCodec; serialize()/deserialize() cover full frames only.
 struct PlayerSnapshotFrame {
     uint32_t serverTick = 0;
     uint64_t selfPlayerId = 0;
     uint32_t lastProcessedInputTick = 0;
-    std::vector<PlayerSnapshot> players;
+    std::vector<PlayerSnapshot> players; // ascending id; only players relevant to selfPlayerId
 
     std::vector<uint8_t> serialize() const;
     static std::optional<PlayerSnapshotFrame> deserialize(const std::vector<uint8_t>& buf);
 };
 
+// Snapshot interest tiers by distance from selfPlayerId. A remote player is refreshed every
+// interval ticks and repeats its last sent entry in between; beyond kSnapshotFarRadius it is not
+// sent at all.
+constexpr float kSnapshotNearRadius = 48.0f;  // every tick (60 Hz)
+constexpr float kSnapshotMidRadius = 128.0f;  // every 2nd tick (30 Hz)
+constexpr float kSnapshotFarRadius = 256.0f;  // every 4th tick (15 Hz)
+constexpr uint32_t kSnapshotMidIntervalTicks = 2;
+constexpr uint32_t kSnapshotFarIntervalTicks = 4;
+
+inline uint32_t SnapshotRefreshIntervalTicks(float distanceSq) {
+    if (distanceSq <= kSnapshotNearRadius * kSnapshotNearRadius) return 1;
+    if (distanceSq <= kSnapshotMidRadius * kSnapshotMidRadius) return kSnapshotMidIntervalTicks;
+    return kSnapshotFarIntervalTicks;
+}
+
 struct ChunkRequest {
     int32_t chunkX = 0;
     int32_t chunkY = 0;
@@ -199,7 +219,8 @@ enum class BlockPlaceRejectReason : uint8_t {
     Unregistered = 2,
     OutOfBounds = 3,
     PlayerOccupied = 4,
-    ServerError = 5
+    ServerError = 5,
+    ChunkNotLoaded = 6 // target chunk is not resident on the server; retry after it streams in
 };
 
 struct BlockPlaceRequest {
@@ -240,7 +261,8 @@ enum class BlockBreakRejectReason : uint8_t {
     Unregistered = 2,
     OutOfBounds = 3,
     PlayerOccupied = 4,
-    ServerError = 5
+    ServerError = 5,
+    ChunkNotLoaded = 6 // target chunk is not resident on the server; retry after it streams in
 };
 
 struct BlockBreakRequest {
@@ -312,5 +334,7 @@ struct WorldItemSnapshot {
     std::vector<WorldItemState> items;
 
     std::vector<uint8_t> serialize() const;
+    // Appends the same bytes to `out`, reusing its capacity.
+    void serialize(std::vector<uint8_t>& out) const;
     static std::optional<WorldItemSnapshot> deserialize(const std::vector<uint8_t>& buf);
 };
@@ -0,0 +1,455 @@
+#include "SnapshotCodec.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Shared::SnapshotCodec {
+
+namespace {
+
+constexpr double kPositionScale = 4096.0;            // 1/4096 m inside a chunk
+constexpr int64_t kPositionUnitsPerChunk = static_cast<int64_t>(kChunkSpan) * 4096;
+constexpr float kVelocityScale = 256.0f;              // 1/256 m/s, +-128 m/s
+constexpr float kHealthScale = 100.0f;
+constexpr float kRespawnScale = 100.0f;
+constexpr float kJumpTimerScale = 10000.0f;
+constexpr float kAngleScale = 32768.0f / 180.0f;      // 360 degrees wrap exactly at 2^16
+
+inline float FiniteOrZero(float v) {
+    return std::isfinite(v) ? v : 0.0f;
+}
+
+inline uint32_t FloatBits(float v) {
+    uint32_t bits = 0;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+inline float BitsFloat(uint32_t bits) {
+    float v = 0.0f;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+inline int64_t FloorDiv(int64_t a, int64_t b) {
+    int64_t q = a / b;
+    if ((a % b != 0) && ((a < 0) != (b < 0))) {
+        --q;
+    }
+    return q;
+}
+
+inline uint16_t QuantizeUnsigned(float v, float scale) {
+    const float scaled = std::round(FiniteOrZero(v) * scale);
+    return static_cast<uint16_t>(std::clamp(scaled, 0.0f, 65535.0f));
+}
+
+inline uint16_t QuantizeSigned(float v, float scale) {
+    const float scaled = std::round(FiniteOrZero(v) * scale);
+    return static_cast<uint16_t>(static_cast<int16_t>(std::clamp(scaled, -32768.0f, 32767.0f)));
+}
+
+inline uint16_t QuantizeAngle(float degrees) {
+    const float wrapped = std::fmod(FiniteOrZero(degrees), 360.0f);
+    const long q = std::lround(wrapped * kAngleScale);
+    return static_cast<uint16_t>(static_cast<unsigned long>(q) & 0xFFFFu);
+}
+
+inline float DequantizeAngle(uint16_t q) {
+    return static_cast<float>(static_cast<int16_t>(q)) / kAngleScale;
+}
+
+inline uint32_t ZigZag(int32_t v) {
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+inline int32_t UnZigZag(uint32_t v) {
+    return static_cast<int32_t>((v >> 1) ^ (~(v & 1u) + 1u));
+}
+
+inline void WriteU8(std::vector<uint8_t>& out, uint8_t v) {
+    out.push_back(v);
+}
+
+inline void WriteU16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back(static_cast<uint8_t>(v & 0xFFu));
+    out.push_back(static_cast<uint8_t>((v >> 8) & 0xFFu));
+}
+
+inline void WriteU32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<uint8_t>((v >> (8 * i)) & 0xFFu));
+    }
+}
+
+inline void WriteU64(std::vector<uint8_t>& out, uint64_t v) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<uint8_t>((v >> (8 * i)) & 0xFFu));
+    }
+}
+
+inline void WriteVarU64(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80u) {
+        out.push_back(static_cast<uint8_t>((v & 0x7Fu) | 0x80u));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+struct Reader {
+    const uint8_t* data;
+    size_t size;
+    size_t offset;
+
+    size_t remaining() const { return size - offset; }
+
+    bool u8(uint8_t& out) {
+        if (remaining() < 1) return false;
+        out = data[offset++];
+        return true;
+    }
+    bool u16(uint16_t& out) {
+        if (remaining() < 2) return false;
+        out = static_cast<uint16_t>(data[offset] | (data[offset + 1] << 8));
+        offset += 2;
+        return true;
+    }
+    bool u32(uint32_t& out) {
+        if (remaining() < 4) return false;
+        out = 0;
+        for (int i = 0; i < 4; ++i) {
+            out |= static_cast<uint32_t>(data[offset + i]) << (8 * i);
+        }
+        offset += 4;
+        return true;
+    }
+    bool u64(uint64_t& out) {
+        if (remaining() < 8) return false;
+        out = 0;
+        for (int i = 0; i < 8; ++i) {
+            out |= static_cast<uint64_t>(data[offset + i]) << (8 * i);
+        }
+        offset += 8;
+        return true;
+    }
+    bool varU64(uint64_t& out) {
+        out = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t b = 0;
+            if (!u8(b)) return false;
+            out |= static_cast<uint64_t>(b & 0x7Fu) << shift;
+            if ((b & 0x80u) == 0) return true;
+        }
+        return false;
+    }
+};
+
+// Lower-bound walk over a sorted baseline; `cursor` only moves forward.
+const PlayerState* FindInBaseline(const std::vector<PlayerState>* baseline, size_t& cursor, uint64_t id) {
+    if (baseline == nullptr) {
+        return nullptr;
+    }
+    while (cursor < baseline->size() && (*baseline)[cursor].id < id) {
+        ++cursor;
+    }
+    if (cursor < baseline->size() && (*baseline)[cursor].id == id) {
+        return &(*baseline)[cursor];
+    }
+    return nullptr;
+}
+
+} // namespace
+
+PlayerState Quantize(const PlayerSnapshot& snapshot, bool precise) {
+    PlayerState state;
+    state.id = snapshot.id;
+
+    const float position[3] = { snapshot.px, snapshot.py, snapshot.pz };
+    const float velocity[3] = { snapshot.vx, snapshot.vy, snapshot.vz };
+    for (int axis = 0; axis < 3; ++axis) {
+        if (precise) {
+            state.position[axis] = FloatBits(position[axis]);
+            state.velocity[axis] = FloatBits(velocity[axis]);
+            continue;
+        }
+        const int64_t units = static_cast<int64_t>(
+            std::llround(static_cast<double>(FiniteOrZero(position[axis])) * kPositionScale)
+        );
+        const int64_t chunk = FloorDiv(units, kPositionUnitsPerChunk);
+        state.chunk[axis] = static_cast<int32_t>(chunk);
+        state.position[axis] = static_cast<uint32_t>(units - chunk * kPositionUnitsPerChunk);
+        state.velocity[axis] = QuantizeSigned(velocity[axis], kVelocityScale);
+    }
+
+    state.yaw = QuantizeAngle(snapshot.yaw);
+    state.pitch = QuantizeAngle(snapshot.pitch);
+    state.flags =
+        (snapshot.onGround ? kStateFlagOnGround : 0u) |
+        (snapshot.flyMode ? kStateFlagFlyMode : 0u) |
+        (snapshot.allowFlyMode ? kStateFlagAllowFlyMode : 0u) |
+        (snapshot.isAlive ? kStateFlagAlive : 0u) |
+        (snapshot.jumpPressedLastTick ? kStateFlagJumpPressedLastTick : 0u);
+    state.weaponId = snapshot.weaponId;
+    state.health = QuantizeUnsigned(snapshot.health, kHealthScale);
+    state.respawn = QuantizeUnsigned(snapshot.respawnSeconds, kRespawnScale);
+    if (precise) {
+        state.jumpTimers[0] = FloatBits(snapshot.timeSinceGrounded);
+        state.jumpTimers[1] = FloatBits(snapshot.jumpBufferTimer);
+    }
+    else {
+        state.jumpTimers[0] = QuantizeUnsigned(snapshot.timeSinceGrounded, kJumpTimerScale);
+        state.jumpTimers[1] = QuantizeUnsigned(snapshot.jumpBufferTimer, kJumpTimerScale);
+    }
+    return state;
+}
+
+PlayerSnapshot Dequantize(const PlayerState& state, bool precise) {
+    PlayerSnapshot snapshot{};
+    snapshot.id = state.id;
+
+    float position[3] = {};
+    float velocity[3] = {};
+    for (int axis = 0; axis < 3; ++axis) {
+        if (precise) {
+            position[axis] = BitsFloat(state.position[axis]);
+            velocity[axis] = BitsFloat(state.velocity[axis]);
+            continue;
+        }
+        position[axis] = static_cast<float>(
+            static_cast<double>(state.chunk[axis]) * kChunkSpan +
+            static_cast<double>(state.position[axis]) / kPositionScale
+        );
+        velocity[axis] = static_cast<float>(static_cast<int16_t>(state.velocity[axis])) / kVelocityScale;
+    }
+    snapshot.px = position[0]; snapshot.py = position[1]; snapshot.pz = position[2];
+    snapshot.vx = velocity[0]; snapshot.vy = velocity[1]; snapshot.vz = velocity[2];
+
+    snapshot.yaw = DequantizeAngle(state.yaw);
+    snapshot.pitch = DequantizeAngle(state.pitch);
+    snapshot.onGround = (state.flags & kStateFlagOnGround) ? 1u : 0u;
+    snapshot.flyMode = (state.flags & kStateFlagFlyMode) ? 1u : 0u;
+    snapshot.allowFlyMode = (state.flags & kStateFlagAllowFlyMode) ? 1u : 0u;
+    snapshot.isAlive = (state.flags & kStateFlagAlive) ? 1u : 0u;
+    snapshot.jumpPressedLastTick = (state.flags & kStateFlagJumpPressedLastTick) ? 1u : 0u;
+    snapshot.weaponId = state.weaponId;
+    snapshot.health = static_cast<float>(state.health) / kHealthScale;
+    snapshot.respawnSeconds = static_cast<float>(state.respawn) / kRespawnScale;
+    if (precise) {
+        snapshot.timeSinceGrounded = BitsFloat(state.jumpTimers[0]);
+        snapshot.jumpBufferTimer = BitsFloat(state.jumpTimers[1]);
+    }
+    else {
+        snapshot.timeSinceGrounded = static_cast<float>(state.jumpTimers[0]) / kJumpTimerScale;
+        snapshot.jumpBufferTimer = static_cast<float>(state.jumpTimers[1]) / kJumpTimerScale;
+    }
+    return snapshot;
+}
+
+uint8_t DiffFields(const PlayerState& current, const PlayerState& baseline) {
+    uint8_t mask = 0;
+    if (current.chunk != baseline.chunk || current.position != baseline.position) mask |= kFieldPosition;
+    if (current.velocity != baseline.velocity) mask |= kFieldVelocity;
+    if (current.yaw != baseline.yaw || current.pitch != baseline.pitch) mask |= kFieldLook;
+    if (current.flags != baseline.flags) mask |= kFieldFlags;
+    if (current.weaponId != baseline.weaponId) mask |= kFieldWeapon;
+    if (current.health != baseline.health) mask |= kFieldHealth;
+    if (current.respawn != baseline.respawn) mask |= kFieldRespawn;
+    if (current.jumpTimers != baseline.jumpTimers) mask |= kFieldJumpTimers;
+    return mask;
+}
+
+void EncodeFrame(
+    const FrameHeader& header,
+    const std::vector<PlayerState>& players,
+    const std::vector<PlayerState>* baseline,
+    std::vector<uint8_t>& out
+) {
+    const bool hasBaseline = header.hasBaseline && baseline != nullptr;
+    out.reserve(out.size() + kFrameHeaderBytes + 4 + 5 + players.size() * 8);
+    WriteU8(out, static_cast<uint8_t>(PacketType::PlayerSnapshot));
+    WriteU32(out, header.serverTick);
+    WriteU64(out, header.selfPlayerId);
+    WriteU32(out, header.lastProcessedInputTick);
+    WriteU8(out, hasBaseline ? kFrameHasBaseline : 0u);
+    if (hasBaseline) {
+        WriteU32(out, header.baselineTick);
+    }
+    WriteVarU64(out, players.size());
+
+    uint64_t previousId = 0;
+    size_t baselineCursor = 0;
+    for (const PlayerState& player : players) {
+        WriteVarU64(out, player.id - previousId);
+        previousId = player.id;
+
+        const PlayerState* base = FindInBaseline(hasBaseline ? baseline : nullptr, baselineCursor, player.id);
+        const bool precise = (player.id == header.selfPlayerId);
+        const uint8_t mask = base ? DiffFields(player, *base) : kAllFields;
+        WriteU8(out, mask);
+
+        if (mask & kFieldPosition) {
+            if (precise) {
+                for (uint32_t bits : player.position) WriteU32(out, bits);
+            }
+            else {
+                for (int axis = 0; axis < 3; ++axis) {
+                    const int32_t from = base ? base->chunk[axis] : 0;
+                    WriteVarU64(out, ZigZag(static_cast<int32_t>(
+                        static_cast<uint32_t>(player.chunk[axis]) - static_cast<uint32_t>(from)
+                    )));
+                }
+                for (uint32_t local : player.position) WriteU16(out, static_cast<uint16_t>(local));
+            }
+        }
+        if (mask & kFieldVelocity) {
+            for (uint32_t v : player.velocity) {
+                if (precise) WriteU32(out, v);
+                else WriteU16(out, static_cast<uint16_t>(v));
+            }
+        }
+        if (mask & kFieldLook) {
+            WriteU16(out, player.yaw);
+            WriteU16(out, player.pitch);
+        }
+        if (mask & kFieldFlags) WriteU8(out, player.flags);
+        if (mask & kFieldWeapon) WriteU16(out, player.weaponId);
+        if (mask & kFieldHealth) WriteU16(out, player.health);
+        if (mask & kFieldRespawn) WriteU16(out, player.respawn);
+        if (mask & kFieldJumpTimers) {
+            for (uint32_t t : player.jumpTimers) {
+                if (precise) WriteU32(out, t);
+                else WriteU16(out, static_cast<uint16_t>(t));
+            }
+        }
+    }
+}
+
+bool DecodeFrameHeader(const uint8_t* data, size_t size, FrameHeader& outHeader) {
+    if (data == nullptr) {
+        return false;
+    }
+    Reader in{ data, size, 0 };
+    uint8_t type = 0;
+    uint8_t frameFlags = 0;
+    if (!in.u8(type) || type != static_cast<uint8_t>(PacketType::PlayerSnapshot) ||
+        !in.u32(outHeader.serverTick) ||
+        !in.u64(outHeader.selfPlayerId) ||
+        !in.u32(outHeader.lastProcessedInputTick) ||
+        !in.u8(frameFlags)) {
+        return false;
+    }
+    outHeader.hasBaseline = (frameFlags & kFrameHasBaseline) != 0;
+    outHeader.baselineTick = 0;
+    if (outHeader.hasBaseline && !in.u32(outHeader.baselineTick)) {
+        return false;
+    }
+    return true;
+}
+
+bool DecodeFrame(
+    const uint8_t* data,
+    size_t size,
+    const std::vector<PlayerState>* baseline,
+    FrameHeader& outHeader,
+    std::vector<PlayerState>& outPlayers
+) {
+    outPlayers.clear();
+    if (!DecodeFrameHeader(data, size, outHeader)) {
+        return false;
+    }
+    if (outHeader.hasBaseline && baseline == nullptr) {
+        return false;
+    }
+    if (!outHeader.hasBaseline) {
+        baseline = nullptr;
+    }
+
+    Reader in{ data, size, kFrameHeaderBytes + (outHeader.hasBaseline ? 4u : 0u) };
+    uint64_t count = 0;
+    if (!in.varU64(count)) {
+        return false;
+    }
+    // Every entry costs at least an id byte and a mask byte.
+    if (count > in.remaining() / 2) {
+        return false;
+    }
+    outPlayers.reserve(static_cast<size_t>(count));
+
+    uint64_t previousId = 0;
+    size_t baselineCursor = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t idDelta = 0;
+        uint8_t mask = 0;
+        if (!in.varU64(idDelta) || idDelta == 0 || !in.u8(mask)) {
+            return false;
+        }
+        const uint64_t id = previousId + idDelta;
+        previousId = id;
+
+        const PlayerState* base = FindInBaseline(baseline, baselineCursor, id);
+        if (base == nullptr && mask != kAllFields) {
+            return false;
+        }
+        PlayerState player = base ? *base : PlayerState{};
+        player.id = id;
+        const bool precise = (id == outHeader.selfPlayerId);
+
+        if (mask & kFieldPosition) {
+            if (precise) {
+                for (uint32_t& bits : player.position) {
+                    if (!in.u32(bits)) return false;
+                }
+            }
+            else {
+                for (int axis = 0; axis < 3; ++axis) {
+                    uint64_t zigzag = 0;
+                    if (!in.varU64(zigzag) || zigzag > 0xFFFFFFFFull) return false;
+                    const int32_t from = base ? base->chunk[axis] : 0;
+                    player.chunk[axis] = static_cast<int32_t>(
+                        static_cast<uint32_t>(from) + static_cast<uint32_t>(UnZigZag(static_cast<uint32_t>(zigzag)))
+                    );
+                }
+                for (uint32_t& local : player.position) {
+                    uint16_t v = 0;
+                    if (!in.u16(v)) return false;
+                    local = v;
+                }
+            }
+        }
+        if (mask & kFieldVelocity) {
+            for (uint32_t& v : player.velocity) {
+                if (precise) {
+                    if (!in.u32(v)) return false;
+                }
+                else {
+                    uint16_t q = 0;
+                    if (!in.u16(q)) return false;
+                    v = q;
+                }
+            }
+        }
+        if (mask & kFieldLook) {
+            if (!in.u16(player.yaw) || !in.u16(player.pitch)) return false;
+        }
+        if ((mask & kFieldFlags) && !in.u8(player.flags)) return false;
+        if ((mask & kFieldWeapon) && !in.u16(player.weaponId)) return false;
+        if ((mask & kFieldHealth) && !in.u16(player.health)) return false;
+        if ((mask & kFieldRespawn) && !in.u16(player.respawn)) return false;
+        if (mask & kFieldJumpTimers) {
+            for (uint32_t& t : player.jumpTimers) {
+                if (precise) {
+                    if (!in.u32(t)) return false;
+                }
+                else {
+                    uint16_t q = 0;
+                    if (!in.u16(q)) return false;
+                    t = q;
+                }
+            }
+        }
+        outPlayers.push_back(player);
+    }
+    return in.offset == size;
+}
+
+} // namespace Shared::SnapshotCodec
@@ -0,0 +1,104 @@
+#pragma once
+#include "Packets.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Wire codec for PacketType::PlayerSnapshot.
+///
+/// Players are quantized into PlayerState, then written as a per-field dirty mask plus the dirty
+/// fields. When the client has acked an earlier frame, fields that did not change since that
+/// frame are skipped. A player missing from the baseline is written in full.
+///
+/// Layout (little-endian):
+///   u8  PacketType::PlayerSnapshot
+///   u32 serverTick
+///   u64 selfPlayerId
+///   u32 lastProcessedInputTick
+///   u8  frameFlags (kFrameHasBaseline)
+///   u32 baselineTick (only when kFrameHasBaseline)
+///   varint playerCount
+///   per player, ascending id:
+///     varint idDelta (from the previous id, first from 0)
+///     u8 fieldMask
+///     dirty fields in bit order
+///
+/// Remote players use chunk-relative fixed point. The recipient's own entry keeps raw float bits
+/// for position, velocity and jump timers so that client reconciliation replays exact state.
+namespace Shared::SnapshotCodec {
+
+constexpr size_t kFrameHeaderBytes = 1 + 4 + 8 + 4 + 1;
+constexpr uint8_t kFrameHasBaseline = 1u << 0;
+
+constexpr uint8_t kFieldPosition = 1u << 0;   // remote: varint chunk delta + 3 x u16 local; self: 3 x f32
+constexpr uint8_t kFieldVelocity = 1u << 1;   // remote: 3 x i16 (1/256 m/s); self: 3 x f32
+constexpr uint8_t kFieldLook = 1u << 2;       // yaw, pitch as 16-bit angles
+constexpr uint8_t kFieldFlags = 1u << 3;      // u8 of kStateFlag*
+constexpr uint8_t kFieldWeapon = 1u << 4;     // u16
+constexpr uint8_t kFieldHealth = 1u << 5;     // u16, 1/100 hp
+constexpr uint8_t kFieldRespawn = 1u << 6;    // u16, 1/100 s
+constexpr uint8_t kFieldJumpTimers = 1u << 7; // remote: 2 x u16 (1/10000 s); self: 2 x f32
+constexpr uint8_t kAllFields = 0xFFu;
+
+constexpr uint8_t kStateFlagOnGround = 1u << 0;
+constexpr uint8_t kStateFlagFlyMode = 1u << 1;
+constexpr uint8_t kStateFlagAllowFlyMode = 1u << 2;
+constexpr uint8_t kStateFlagAlive = 1u << 3;
+constexpr uint8_t kStateFlagJumpPressedLastTick = 1u << 4;
+
+// Must match CHUNK_SIZE on both ends.
+constexpr int32_t kChunkSpan = 16;
+
+struct FrameHeader {
+    uint32_t serverTick = 0;
+    uint64_t selfPlayerId = 0;
+    uint32_t lastProcessedInputTick = 0;
+    bool hasBaseline = false;
+    uint32_t baselineTick = 0;
+};
+
+// One player as it travels on the wire. Two states compare equal exactly when the client would
+// decode the same values from them, which is what the dirty mask is computed against.
+struct PlayerState {
+    uint64_t id = 0;
+    std::array<int32_t, 3> chunk{};       // unused for precise entries
+    std::array<uint32_t, 3> position{};   // u16 local fixed point, or raw f32 bits
+    std::array<uint32_t, 3> velocity{};   // i16 fixed point in the low bits, or raw f32 bits
+    uint16_t yaw = 0;
+    uint16_t pitch = 0;
+    uint8_t flags = 0;
+    uint16_t weaponId = 0;
+    uint16_t health = 0;
+    uint16_t respawn = 0;
+    std::array<uint32_t, 2> jumpTimers{}; // u16 fixed point, or raw f32 bits
+};
+
+PlayerState Quantize(const PlayerSnapshot& snapshot, bool precise);
+PlayerSnapshot Dequantize(const PlayerState& state, bool precise);
+
+// Fields of `current` that differ from `baseline`.
+uint8_t DiffFields(const PlayerState& current, const PlayerState& baseline);
+
+// Appends one encoded frame to `out`. `players` and `baseline` must be sorted by ascending id;
+// pass baseline == nullptr (and header.hasBaseline == false) for a full frame.
+void EncodeFrame(
+    const FrameHeader& header,
+    const std::vector<PlayerState>& players,
+    const std::vector<PlayerState>* baseline,
+    std::vector<uint8_t>& out
+);
+
+// Reads only the fixed header so the caller can look up the baseline it names.
+bool DecodeFrameHeader(const uint8_t* data, size_t size, FrameHeader& outHeader);
+
+// Decodes a whole frame against `baseline` (the states of header.baselineTick, or nullptr).
+bool DecodeFrame(
+    const uint8_t* data,
+    size_t size,
+    const std::vector<PlayerState>* baseline,
+    FrameHeader& outHeader,
+    std::vector<PlayerState>& outPlayers
+);
+
+} // namespace Shared::SnapshotCodec
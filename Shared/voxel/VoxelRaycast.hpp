@@ -0,0 +1,264 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+// Voxel ray traversal shared by the client and the server. The walk is an Amanatides-Woo DDA
+// that keeps the current chunk cached and jumps straight across unloaded chunks, all-air chunks
+// and empty 4x4x4 bricks instead of visiting their voxels one by one.
+//
+// A World adapter exposes the chunk storage:
+//
+//     using Chunk = ...;
+//     const Chunk* findChunk(const glm::ivec3& chunkPos) const;    // nullptr when not loaded (air)
+//     uint64_t brickOccupancy(const Chunk& chunk) const;           // bit BrickIndex(...) set = brick may hold a solid block
+//     bool isSolid(const Chunk& chunk, int x, int y, int z) const; // chunk-local coordinates
+//
+// findChunk must not create or generate chunks: a ray is a read-only query.
+namespace Shared::Voxel {
+
+constexpr int kChunkSize = 16;
+constexpr int kBrickSize = 4;
+constexpr int kBricksPerAxis = kChunkSize / kBrickSize;
+static_assert(kBricksPerAxis * kBricksPerAxis * kBricksPerAxis == 64, "brick occupancy must fit a uint64_t");
+
+// Brick of the chunk-local block (x, y, z).
+inline constexpr int BrickIndex(int x, int y, int z) noexcept {
+    return (x / kBrickSize) + kBricksPerAxis * ((y / kBrickSize) + kBricksPerAxis * (z / kBrickSize));
+}
+
+inline constexpr uint64_t BrickBit(int x, int y, int z) noexcept {
+    return uint64_t{ 1 } << BrickIndex(x, y, z);
+}
+
+// Whether any block of `brick` is solid; isSolid(x, y, z) takes chunk-local coordinates.
+template <typename IsSolidFn>
+inline bool BrickHasSolid(int brick, IsSolidFn&& isSolid) {
+    const int baseX = (brick % kBricksPerAxis) * kBrickSize;
+    const int baseY = ((brick / kBricksPerAxis) % kBricksPerAxis) * kBrickSize;
+    const int baseZ = (brick / (kBricksPerAxis * kBricksPerAxis)) * kBrickSize;
+    for (int z = baseZ; z < baseZ + kBrickSize; ++z) {
+        for (int y = baseY; y < baseY + kBrickSize; ++y) {
+            for (int x = baseX; x < baseX + kBrickSize; ++x) {
+                if (isSolid(x, y, z)) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+// Occupancy mask of a whole chunk; isSolid(x, y, z) takes chunk-local coordinates.
+template <typename IsSolidFn>
+inline uint64_t ComputeBrickOccupancy(IsSolidFn&& isSolid) {
+    uint64_t mask = 0;
+    for (int z = 0; z < kChunkSize; ++z) {
+        for (int y = 0; y < kChunkSize; ++y) {
+            for (int x = 0; x < kChunkSize; ++x) {
+                const uint64_t bit = BrickBit(x, y, z);
+                if ((mask & bit) == 0 && isSolid(x, y, z)) {
+                    mask |= bit;
+                }
+            }
+        }
+    }
+    return mask;
+}
+
+struct VoxelRay {
+    glm::vec3 origin{ 0.0f };
+    glm::vec3 direction{ 0.0f, 0.0f, 1.0f }; // need not be normalized
+    float maxDistance = 0.0f;
+};
+
+struct VoxelRayHit {
+    bool hit = false;
+    glm::ivec3 block{ 0 };  // world block coordinates
+    glm::ivec3 chunk{ 0 };
+    glm::ivec3 normal{ 0 }; // face the ray entered through; zero when the ray starts inside the block
+    float distance = 0.0f;  // along the normalized direction, to where the ray enters the block
+    glm::vec3 point{ 0.0f };
+};
+
+namespace Detail {
+
+inline int FloorDivChunk(int v) noexcept {
+    return (v >= 0) ? (v / kChunkSize) : -((-v + kChunkSize - 1) / kChunkSize);
+}
+
+struct DdaState {
+    glm::ivec3 block{ 0 };
+    glm::ivec3 step{ 0 };
+    glm::vec3 tMax{ 0.0f };
+    glm::vec3 tDelta{ 0.0f };
+    float tEnter = 0.0f;
+    int enterAxis = -1;
+
+    void stepOnce() noexcept {
+        int axis = 0;
+        if (tMax.x < tMax.y) {
+            axis = (tMax.x < tMax.z) ? 0 : 2;
+        }
+        else {
+            axis = (tMax.y < tMax.z) ? 1 : 2;
+        }
+        tEnter = tMax[axis];
+        block[axis] += step[axis];
+        tMax[axis] += tDelta[axis];
+        enterAxis = axis;
+    }
+
+    // Advances to the first block outside the axis-aligned cell [cellMin, cellMin + cellSize)
+    // that contains the current block, as if stepOnce() had been called until then.
+    bool leaveCell(const glm::ivec3& cellMin, int cellSize) noexcept {
+        int crossingsInside[3] = { 0, 0, 0 };
+        float exitT = std::numeric_limits<float>::infinity();
+        int exitAxis = -1;
+        for (int i = 0; i < 3; ++i) {
+            if (step[i] == 0) {
+                continue;
+            }
+            crossingsInside[i] = (step[i] > 0) ? (cellMin[i] + cellSize - 1 - block[i]) : (block[i] - cellMin[i]);
+            const float t = tMax[i] + static_cast<float>(crossingsInside[i]) * tDelta[i];
+            if (t < exitT) {
+                exitT = t;
+                exitAxis = i;
+            }
+        }
+        if (exitAxis < 0) {
+            return false;
+        }
+        for (int i = 0; i < 3; ++i) {
+            int crossings = 0;
+            if (i == exitAxis) {
+                crossings = crossingsInside[i] + 1;
+            }
+            else if (step[i] != 0 && tMax[i] <= exitT) {
+                const float passed = std::floor((exitT - tMax[i]) / tDelta[i]) + 1.0f;
+                crossings = (passed < static_cast<float>(crossingsInside[i])) ? static_cast<int>(passed) : crossingsInside[i];
+            }
+            if (crossings > 0) { // tDelta is infinite on an axis the ray does not move along
+                block[i] += step[i] * crossings;
+                tMax[i] += static_cast<float>(crossings) * tDelta[i];
+            }
+        }
+        tEnter = exitT;
+        enterAxis = exitAxis;
+        return true;
+    }
+};
+
+} // namespace Detail
+
+// Nearest solid block along the ray within maxDistance, including the block the ray starts in.
+template <typename World>
+bool Raycast(const World& world, const glm::vec3& origin, const glm::vec3& direction, float maxDistance, VoxelRayHit& out) {
+    out = VoxelRayHit{};
+    if (!std::isfinite(maxDistance) || maxDistance < 0.0f) {
+        return false;
+    }
+    const float dirLenSq = glm::dot(direction, direction);
+    if (!std::isfinite(dirLenSq) || dirLenSq < 1e-8f || !std::isfinite(origin.x + origin.y + origin.z)) {
+        return false;
+    }
+
+    const glm::vec3 dir = direction / std::sqrt(dirLenSq);
+    Detail::DdaState dda;
+    dda.block = glm::ivec3(glm::floor(origin));
+    for (int i = 0; i < 3; ++i) {
+        if (dir[i] != 0.0f) {
+            dda.step[i] = (dir[i] > 0.0f) ? 1 : -1;
+            const float nextBoundary = (dda.step[i] > 0) ? (static_cast<float>(dda.block[i]) + 1.0f) : static_cast<float>(dda.block[i]);
+            dda.tMax[i] = (nextBoundary - origin[i]) / dir[i];
+            dda.tDelta[i] = std::abs(1.0f / dir[i]);
+        }
+        else {
+            dda.tMax[i] = std::numeric_limits<float>::infinity();
+            dda.tDelta[i] = std::numeric_limits<float>::infinity();
+        }
+    }
+
+    // Every iteration crosses at least one block boundary, and a segment of length L crosses at
+    // most 3 * (ceil(L) + 1) of them; the cap only guards against float pathologies.
+    const float boundedDistance = (maxDistance < 65536.0f) ? maxDistance : 65536.0f;
+    const int maxIterations = 3 * (static_cast<int>(std::ceil(boundedDistance)) + 2);
+
+    using Chunk = typename World::Chunk;
+    const Chunk* chunk = nullptr;
+    uint64_t bricks = 0;
+    glm::ivec3 chunkPos(0);
+    bool chunkCached = false;
+
+    for (int iteration = 0; iteration < maxIterations && dda.tEnter <= maxDistance; ++iteration) {
+        const glm::ivec3 blockChunk(
+            Detail::FloorDivChunk(dda.block.x),
+            Detail::FloorDivChunk(dda.block.y),
+            Detail::FloorDivChunk(dda.block.z)
+        );
+        if (!chunkCached || blockChunk != chunkPos) {
+            chunkPos = blockChunk;
+            chunk = world.findChunk(chunkPos);
+            bricks = (chunk != nullptr) ? world.brickOccupancy(*chunk) : 0;
+            chunkCached = true;
+        }
+
+        const glm::ivec3 chunkOrigin = chunkPos * kChunkSize;
+        if (bricks == 0) {
+            if (!dda.leaveCell(chunkOrigin, kChunkSize)) {
+                return false;
+            }
+            continue;
+        }
+
+        const glm::ivec3 local = dda.block - chunkOrigin;
+        if ((bricks & BrickBit(local.x, local.y, local.z)) == 0) {
+            const glm::ivec3 brickMin = chunkOrigin + (local / kBrickSize) * kBrickSize;
+            if (!dda.leaveCell(brickMin, kBrickSize)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (world.isSolid(*chunk, local.x, local.y, local.z)) {
+            out.hit = true;
+            out.block = dda.block;
+            out.chunk = chunkPos;
+            if (dda.enterAxis >= 0) {
+                out.normal[dda.enterAxis] = -dda.step[dda.enterAxis];
+            }
+            out.distance = dda.tEnter;
+            out.point = origin + dir * dda.tEnter;
+            return true;
+        }
+        dda.stepOnce();
+    }
+    return false;
+}
+
+// Traces rays[i] into hits[i]. Rays are independent, so parallelFor(count, fn) may call fn(index)
+// for every index in [0, count) from any number of threads; each call keeps its own chunk cache.
+template <typename World, typename ParallelFor>
+void RaycastBatch(const World& world, std::span<const VoxelRay> rays, std::span<VoxelRayHit> hits, ParallelFor&& parallelFor) {
+    const size_t count = (rays.size() < hits.size()) ? rays.size() : hits.size();
+    parallelFor(count, [&](size_t index) {
+        const VoxelRay& ray = rays[index];
+        Raycast(world, ray.origin, ray.direction, ray.maxDistance, hits[index]);
+    });
+}
+
+template <typename World>
+void RaycastBatch(const World& world, std::span<const VoxelRay> rays, std::span<VoxelRayHit> hits) {
+    RaycastBatch(world, rays, hits, [](size_t count, auto&& fn) {
+        for (size_t index = 0; index < count; ++index) {
+            fn(index);
+        }
+    });
+}
+
+} // namespace Shared::Voxel
@@ -0,0 +1,382 @@
+// Server player collision benchmark.
+//
+// Steps N simulated players through Shared::Movement::Simulate on generated terrain at the server
+// tick rate, answering every sweep, step-up and ground probe in one of three ways:
+//
+//   locked   the read path before lock-free chunk reads, rebuilt from the same voxels: each query
+//            takes the chunk map's shared lock, and each voxel read takes its chunk's shared lock
+//            and stamps a steady_clock access time.
+//   seqlock  ChunkManager::queryAabbCollision per probe (lock-free ServerChunk::getBlock).
+//   grid     one ChunkManager::captureCollisionGrid per player per tick and bit tests per probe,
+//            the way PlayerManager::simulatePhysicsFor does it with kCaptureCollisionGrid on.
+//            The server defaults to seqlock; flip the switch only if this path measures faster.
+//
+// Player inputs depend only on the player and the tick, so every mode and thread count walks the
+// same paths; the "match" column checks that final positions agree with the locked run.
+//
+// usage: ChunkCollisionBench [--players=64] [--seconds=10] [--radius=4] [--seed=1337] [--threads=1,4]
+
+#include "../graphics/ChunkManager.hpp"
+#include "../../Shared/player/MovementSimulation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t kTickRateHz = 60;
+constexpr float kCollisionSkin = 0.001f; // same as ChunkManager.cpp
+
+enum class ReadPath { Locked, Seqlock, Grid };
+
+const char* ReadPathName(ReadPath path) {
+    switch (path) {
+    case ReadPath::Locked: return "locked";
+    case ReadPath::Seqlock: return "seqlock";
+    default: return "grid";
+    }
+}
+
+int FloorDivChunk(int v) {
+    return (v >= 0) ? (v / CHUNK_SIZE) : -((-v + CHUNK_SIZE - 1) / CHUNK_SIZE);
+}
+
+// Chunk storage as it was before lock-free reads: dense blocks behind a per-chunk shared_mutex,
+// with a per-read access timestamp, all behind one map-wide shared_mutex.
+class LockedWorld {
+public:
+    explicit LockedWorld(const ChunkManager& chunkManager)
+        : m_chunkManager(chunkManager)
+    {
+        for (const auto& [pos, source] : chunkManager.snapshotChunkMap()) {
+            auto chunk = std::make_unique<Chunk>();
+            for (int z = 0; z < CHUNK_SIZE; ++z) {
+                for (int y = 0; y < CHUNK_SIZE; ++y) {
+                    for (int x = 0; x < CHUNK_SIZE; ++x) {
+                        chunk->blocks[ServerChunk::blockIndex(x, y, z)] = source->getBlock(x, y, z);
+                    }
+                }
+            }
+            m_chunks.emplace(pos, std::move(chunk));
+        }
+    }
+
+    bool collides(const glm::vec3& pos, float radius, float height) const {
+        const int ix0 = static_cast<int>(std::floor(pos.x - radius + kCollisionSkin));
+        const int iy0 = static_cast<int>(std::floor(pos.y + kCollisionSkin));
+        const int iz0 = static_cast<int>(std::floor(pos.z - radius + kCollisionSkin));
+        const int ix1 = static_cast<int>(std::floor(pos.x + radius - kCollisionSkin));
+        const int iy1 = static_cast<int>(std::floor(pos.y + height - kCollisionSkin));
+        const int iz1 = static_cast<int>(std::floor(pos.z + radius - kCollisionSkin));
+
+        // the old scan timed its map lock wait for the slow-lock log
+        const auto lockStart = std::chrono::steady_clock::now();
+        std::shared_lock<std::shared_mutex> mapLock(m_mapMutex);
+        m_lockWaitNs.fetch_add(uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - lockStart
+        ).count()), std::memory_order_relaxed);
+
+        glm::ivec3 cachedChunkPos(0);
+        const Chunk* cachedChunk = nullptr;
+        bool hasCachedChunk = false;
+        for (int x = ix0; x <= ix1; ++x) {
+            for (int y = iy0; y <= iy1; ++y) {
+                for (int z = iz0; z <= iz1; ++z) {
+                    const glm::ivec3 chunkPos(FloorDivChunk(x), FloorDivChunk(y), FloorDivChunk(z));
+                    if (!m_chunkManager.inBounds(chunkPos)) {
+                        continue;
+                    }
+                    if (!hasCachedChunk || chunkPos != cachedChunkPos) {
+                        const auto it = m_chunks.find(chunkPos);
+                        cachedChunk = (it != m_chunks.end()) ? it->second.get() : nullptr;
+                        cachedChunkPos = chunkPos;
+                        hasCachedChunk = true;
+                    }
+                    if (!cachedChunk) {
+                        return true; // missing chunks block, like the server
+                    }
+                    const glm::ivec3 local = glm::ivec3(x, y, z) - chunkPos * CHUNK_SIZE;
+                    if (cachedChunk->getBlock(local) != BlockID::Air) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+    struct Chunk {
+        mutable std::shared_mutex mutex;
+        mutable std::atomic<int64_t> lastAccessNs{ 0 };
+        std::array<BlockID, CHUNK_VOLUME> blocks{};
+
+        BlockID getBlock(const glm::ivec3& local) const {
+            std::shared_lock<std::shared_mutex> lk(mutex);
+            lastAccessNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+            ).count(), std::memory_order_relaxed);
+            return blocks[ServerChunk::blockIndex(local.x, local.y, local.z)];
+        }
+    };
+
+    const ChunkManager& m_chunkManager;
+    mutable std::shared_mutex m_mapMutex;
+    mutable std::atomic<uint64_t> m_lockWaitNs{ 0 };
+    std::unordered_map<glm::ivec3, std::unique_ptr<Chunk>, IVec3Hash, IVec3Eq> m_chunks;
+};
+
+struct SimPlayer {
+    Shared::Movement::State state;
+};
+
+uint32_t HashPlayerTick(uint32_t player, uint32_t tick) {
+    uint32_t h = player * 0x9E3779B1u ^ (tick + 0x7F4A7C15u) * 0x85EBCA6Bu;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    return h;
+}
+
+// Sprinting in a direction that changes every second, with a jump every 45 ticks.
+Shared::Movement::InputState InputFor(uint32_t player, uint32_t tick) {
+    const float heading = static_cast<float>(HashPlayerTick(player, tick / kTickRateHz) % 3600u) * (6.2831853f / 3600.0f);
+    Shared::Movement::InputState input;
+    input.moveX = std::cos(heading);
+    input.moveZ = std::sin(heading);
+    input.flags = kPlayerInputFlagForward | kPlayerInputFlagSprint;
+    if ((tick + player) % 45u == 0) {
+        input.flags |= kPlayerInputFlagJump;
+    }
+    return input;
+}
+
+std::vector<SimPlayer> SpawnPlayers(const ChunkManager& chunkManager, size_t count, int radiusChunks, uint32_t seed) {
+    std::mt19937 rng(seed);
+    const int extent = std::max(1, radiusChunks * CHUNK_SIZE - 8);
+    std::uniform_int_distribution<int> spread(-extent, extent);
+
+    std::vector<SimPlayer> players(count);
+    for (SimPlayer& player : players) {
+        const int x = spread(rng);
+        const int z = spread(rng);
+        int surfaceY = WORLD_MIN_Y;
+        for (int y = WORLD_MAX_Y + CHUNK_SIZE - 1; y >= WORLD_MIN_Y; --y) {
+            const std::optional<BlockID> block = chunkManager.tryGetBlockGlobal(glm::ivec3(x, y, z));
+            if (block && *block != BlockID::Air) {
+                surfaceY = y + 1;
+                break;
+            }
+        }
+        player.state.position = glm::vec3(static_cast<float>(x) + 0.5f, static_cast<float>(surfaceY), static_cast<float>(z) + 0.5f);
+        player.state.onGround = true;
+    }
+    return players;
+}
+
+// Mirrors the reach box PlayerManager::simulatePhysicsFor captures before stepping a player.
+void CaptureTickGrid(const ChunkManager& chunkManager, const Shared::Movement::State& state, float dt, VoxelCollisionGrid& outGrid) {
+    const auto& movement = Shared::PlayerData::GetMovementSettings();
+    const float horizontalSpeed = std::max(glm::length(glm::vec2(state.velocity.x, state.velocity.z)), movement.sprintSpeed);
+    const float riseSpeed = std::max({ 0.0f, state.velocity.y, movement.jumpVelocity * movement.sprintJumpVelocityMultiplier });
+    const float fallSpeed = std::clamp(-(state.velocity.y + movement.gravity * dt), 0.0f, movement.terminalVelocity);
+    const float horizontalReach = horizontalSpeed * dt;
+    chunkManager.captureCollisionGrid(
+        state.position,
+        movement.collisionRadius,
+        movement.collisionHeight,
+        glm::vec3(-horizontalReach, -fallSpeed * dt, -horizontalReach),
+        glm::vec3(horizontalReach, riseSpeed * dt + movement.maxStepHeight, horizontalReach),
+        outGrid
+    );
+}
+
+struct RunResult {
+    double seconds = 0.0;
+    uint64_t probes = 0;
+    std::vector<SimPlayer> players;
+};
+
+RunResult RunPath(
+    ReadPath path,
+    const ChunkManager& chunkManager,
+    const LockedWorld& lockedWorld,
+    const std::vector<SimPlayer>& spawn,
+    uint32_t ticks,
+    unsigned threadCount
+) {
+    RunResult result;
+    result.players = spawn;
+    std::atomic<uint64_t> probes{ 0 };
+
+    const auto& movement = Shared::PlayerData::GetMovementSettings();
+    const float dt = 1.0f / static_cast<float>(kTickRateHz);
+    Shared::Movement::Options options;
+    options.allowStepUp = true;
+    options.requireSprintForStepUp = true;
+
+    // Players are independent, so each thread steps its own slice through every tick.
+    const auto worker = [&](size_t begin, size_t end) {
+        uint64_t localProbes = 0;
+        VoxelCollisionGrid grid;
+        for (uint32_t tick = 0; tick < ticks; ++tick) {
+            for (size_t i = begin; i < end; ++i) {
+                Shared::Movement::State& state = result.players[i].state;
+                // one storage reader pin per player step, as in PlayerManager::simulatePhysicsFor
+                const ServerChunk::ReadScope readScope;
+                if (path == ReadPath::Grid) {
+                    CaptureTickGrid(chunkManager, state, dt, grid);
+                }
+                Shared::Movement::Simulate(
+                    state,
+                    InputFor(static_cast<uint32_t>(i), tick),
+                    dt,
+                    movement,
+                    options,
+                    [&](const glm::vec3& testPos) {
+                        ++localProbes;
+                        switch (path) {
+                        case ReadPath::Locked:
+                            return lockedWorld.collides(testPos, movement.collisionRadius, movement.collisionHeight);
+                        case ReadPath::Seqlock:
+                            return chunkManager.queryAabbCollision(testPos, movement.collisionRadius, movement.collisionHeight, true).collided;
+                        default:
+                            return chunkManager.queryAabbCollision(grid, testPos, movement.collisionRadius, movement.collisionHeight, true).collided;
+                        }
+                    }
+                );
+            }
+        }
+        probes.fetch_add(localProbes, std::memory_order_relaxed);
+    };
+
+    const size_t count = result.players.size();
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker, count * t / threadCount, count * (t + 1) / threadCount);
+    }
+    worker(0, count / threadCount);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.probes = probes.load(std::memory_order_relaxed);
+    return result;
+}
+
+bool SamePositions(const std::vector<SimPlayer>& a, const std::vector<SimPlayer>& b) {
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].state.position != b[i].state.position) {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct Options {
+    size_t players = 64;
+    double seconds = 10.0;
+    int radius = 4;
+    uint32_t seed = 1337;
+    std::vector<unsigned> threadCounts{ 1, 4 };
+};
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const size_t eq = arg.find('=');
+        if (arg.rfind("--", 0) != 0 || eq == std::string::npos) {
+            return false;
+        }
+        const std::string key = arg.substr(2, eq - 2);
+        const std::string value = arg.substr(eq + 1);
+        if (key == "players") {
+            options.players = size_t(std::max(1, std::atoi(value.c_str())));
+        }
+        else if (key == "seconds") {
+            options.seconds = std::max(0.1, std::atof(value.c_str()));
+        }
+        else if (key == "radius") {
+            options.radius = std::clamp(std::atoi(value.c_str()), 1, WORLD_MAX_X);
+        }
+        else if (key == "seed") {
+            options.seed = uint32_t(std::atoi(value.c_str()));
+        }
+        else if (key == "threads") {
+            options.threadCounts.clear();
+            for (size_t begin = 0; begin <= value.size();) {
+                size_t end = value.find(',', begin);
+                if (end == std::string::npos) end = value.size();
+                const int count = std::atoi(value.substr(begin, end - begin).c_str());
+                if (count > 0) options.threadCounts.push_back(unsigned(count));
+                begin = end + 1;
+            }
+            if (options.threadCounts.empty()) {
+                return false;
+            }
+        }
+        else {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "usage: ChunkCollisionBench [--players=64] [--seconds=10] [--radius=4] [--seed=1337] [--threads=1,4]\n");
+        return 1;
+    }
+
+    ChunkManager chunkManager(options.seed);
+    chunkManager.generateInitialChunks_TwoPass(options.radius);
+    const LockedWorld lockedWorld(chunkManager);
+    const std::vector<SimPlayer> spawn = SpawnPlayers(chunkManager, options.players, options.radius, options.seed);
+    const uint32_t ticks = static_cast<uint32_t>(options.seconds * kTickRateHz);
+
+    std::printf(
+        "players=%zu seconds=%.1f ticks=%u radius=%d seed=%u\n",
+        options.players, options.seconds, ticks, options.radius, options.seed
+    );
+    std::printf(
+        "%-8s %4s %12s %12s %12s %9s %6s\n",
+        "path", "thr", "us/tick", "probes/tick", "Mprobes/s", "speedup", "match"
+    );
+    for (const unsigned threads : options.threadCounts) {
+        RunPath(ReadPath::Locked, chunkManager, lockedWorld, spawn, std::min(ticks, kTickRateHz), threads); // warm-up
+        RunResult baseline;
+        for (const ReadPath path : { ReadPath::Locked, ReadPath::Seqlock, ReadPath::Grid }) {
+            RunResult run = RunPath(path, chunkManager, lockedWorld, spawn, ticks, threads);
+            if (path == ReadPath::Locked) {
+                baseline = run;
+            }
+            std::printf(
+                "%-8s %4u %12.1f %12.1f %12.2f %8.2fx %6s\n",
+                ReadPathName(path),
+                threads,
+                run.seconds * 1e6 / ticks,
+                double(run.probes) / ticks,
+                double(run.probes) / run.seconds / 1e6,
+                baseline.seconds / run.seconds,
+                SamePositions(run.players, baseline.players) ? "yes" : "NO"
+            );
+        }
+    }
+    return 0;
+}
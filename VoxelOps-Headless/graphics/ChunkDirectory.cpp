@@ -0,0 +1,126 @@
+#include "ChunkDirectory.hpp"
+
+ChunkDirectory::ChunkDirectory(const glm::ivec3& minChunk, const glm::ivec3& maxChunk)
+    : m_min(minChunk), m_extent(maxChunk - minChunk + glm::ivec3(1))
+{
+    const bool validExtent = m_extent.x > 0 && m_extent.y > 0 && m_extent.z > 0;
+    const uint64_t slotCount = validExtent
+        ? static_cast<uint64_t>(m_extent.x) * static_cast<uint64_t>(m_extent.y) * static_cast<uint64_t>(m_extent.z)
+        : 0;
+
+    if (validExtent && slotCount <= kMaxDenseSlots) {
+        m_slotCount = static_cast<size_t>(slotCount);
+        m_slots = std::make_unique<std::atomic<ServerChunk*>[]>(m_slotCount);
+        for (size_t i = 0; i < m_slotCount; ++i) {
+            m_slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+    else {
+        m_shards = std::make_unique<Shard[]>(kShardCount);
+    }
+}
+
+ChunkDirectory::~ChunkDirectory() {
+    if (m_slots) {
+        for (size_t i = 0; i < m_slotCount; ++i) {
+            delete m_slots[i].load(std::memory_order_relaxed);
+        }
+    }
+    if (m_shards) {
+        for (size_t s = 0; s < kShardCount; ++s) {
+            for (auto& [pos, chunk] : m_shards[s].chunks) delete chunk;
+        }
+    }
+}
+
+bool ChunkDirectory::slotIndex(const glm::ivec3& pos, size_t& outIndex) const noexcept {
+    const glm::ivec3 rel = pos - m_min;
+    if (static_cast<unsigned>(rel.x) >= static_cast<unsigned>(m_extent.x) ||
+        static_cast<unsigned>(rel.y) >= static_cast<unsigned>(m_extent.y) ||
+        static_cast<unsigned>(rel.z) >= static_cast<unsigned>(m_extent.z)) {
+        return false;
+    }
+    outIndex = static_cast<size_t>(rel.x) +
+        static_cast<size_t>(m_extent.x) * (static_cast<size_t>(rel.y) + static_cast<size_t>(m_extent.y) * static_cast<size_t>(rel.z));
+    return true;
+}
+
+glm::ivec3 ChunkDirectory::positionForSlot(size_t index) const noexcept {
+    const size_t ex = static_cast<size_t>(m_extent.x);
+    const size_t ey = static_cast<size_t>(m_extent.y);
+    return m_min + glm::ivec3(
+        static_cast<int>(index % ex),
+        static_cast<int>((index / ex) % ey),
+        static_cast<int>(index / (ex * ey))
+    );
+}
+
+ChunkDirectory::Shard& ChunkDirectory::shardFor(const glm::ivec3& pos) const noexcept {
+    return m_shards[IVec3Hash{}(pos) % kShardCount];
+}
+
+ServerChunk* ChunkDirectory::find(const glm::ivec3& pos) const noexcept {
+    if (m_slots) {
+        size_t index = 0;
+        if (!slotIndex(pos, index)) return nullptr;
+        return m_slots[index].load(std::memory_order_acquire);
+    }
+
+    Shard& shard = shardFor(pos);
+    std::shared_lock<std::shared_mutex> lk(shard.mutex);
+    auto it = shard.chunks.find(pos);
+    return (it != shard.chunks.end()) ? it->second : nullptr;
+}
+
+bool ChunkDirectory::publish(const glm::ivec3& pos, std::unique_ptr<ServerChunk> chunk) {
+    if (!chunk) return false;
+
+    if (m_slots) {
+        size_t index = 0;
+        if (!slotIndex(pos, index)) return false;
+        ServerChunk* expected = nullptr;
+        // release: a reader that sees the pointer also sees the fully built chunk
+        if (!m_slots[index].compare_exchange_strong(expected, chunk.get(), std::memory_order_acq_rel)) {
+            return false;
+        }
+        chunk.release();
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    Shard& shard = shardFor(pos);
+    std::lock_guard<std::shared_mutex> lk(shard.mutex);
+    auto [it, inserted] = shard.chunks.try_emplace(pos, chunk.get());
+    if (!inserted) return false;
+    chunk.release();
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool ChunkDirectory::retire(const glm::ivec3& pos) {
+    ServerChunk* removed = nullptr;
+    if (m_slots) {
+        size_t index = 0;
+        if (!slotIndex(pos, index)) return false;
+        removed = m_slots[index].exchange(nullptr, std::memory_order_acq_rel);
+    }
+    else {
+        Shard& shard = shardFor(pos);
+        std::lock_guard<std::shared_mutex> lk(shard.mutex);
+        auto it = shard.chunks.find(pos);
+        if (it != shard.chunks.end()) {
+            removed = it->second;
+            shard.chunks.erase(it);
+        }
+    }
+
+    if (!removed) return false;
+    m_count.fetch_sub(1, std::memory_order_relaxed);
+    retireChunk(removed);
+    return true;
+}
+
+void ChunkDirectory::retireChunk(ServerChunk* chunk) {
+    std::lock_guard<std::mutex> lk(m_retiredMutex);
+    m_retired.emplace_back(chunk);
+}
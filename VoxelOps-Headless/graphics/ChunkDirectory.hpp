@@ -0,0 +1,93 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "../voxels/ServerChunk.hpp"
+
+struct IVec3Hash {
+    std::size_t operator()(glm::ivec3 const& v) const noexcept {
+        uint64_t x = static_cast<uint32_t>(v.x);
+        uint64_t y = static_cast<uint32_t>(v.y);
+        uint64_t z = static_cast<uint32_t>(v.z);
+        uint64_t h = (x * 73856093u) ^ (y * 19349663u) ^ (z * 83492791u);
+        return static_cast<std::size_t>(h);
+    }
+};
+struct IVec3Eq {
+    bool operator()(glm::ivec3 const& a, glm::ivec3 const& b) const noexcept {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+};
+
+// Concurrent chunk position -> ServerChunk directory.
+// Bounded worlds use a dense array of atomic chunk pointers, so a lookup is a bounds check plus one
+// acquire load and never takes a lock. Worlds too large for that fall back to a sharded hash map.
+// Chunks are published once (first publish wins) and never replaced. Lookups hand out raw pointers
+// without holding anything, so removed chunks are retired rather than freed until the directory dies.
+class ChunkDirectory {
+public:
+    // Dense slots cover [minChunk, maxChunk] inclusive unless that exceeds kMaxDenseSlots.
+    ChunkDirectory(const glm::ivec3& minChunk, const glm::ivec3& maxChunk);
+    ~ChunkDirectory();
+
+    ChunkDirectory(const ChunkDirectory&) = delete;
+    ChunkDirectory& operator=(const ChunkDirectory&) = delete;
+
+    ServerChunk* find(const glm::ivec3& pos) const noexcept;
+    // Returns false if pos is out of range or already holds a chunk; `chunk` is destroyed then.
+    bool publish(const glm::ivec3& pos, std::unique_ptr<ServerChunk> chunk);
+    // Unpublishes pos. The chunk stays allocated until the directory is destroyed: raw ServerChunk*
+    // are held across the server without any pin, so nothing is reclaimed early and memory grows
+    // with every retire. Fine for occasional unloads, not for a per-tick streaming loop.
+    bool retire(const glm::ivec3& pos);
+
+    size_t size() const noexcept { return m_count.load(std::memory_order_relaxed); }
+    bool isDense() const noexcept { return m_slots != nullptr; }
+
+    // Visits every published chunk. Chunks published or retired concurrently may or may not be seen.
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        if (m_slots) {
+            for (size_t i = 0; i < m_slotCount; ++i) {
+                ServerChunk* chunk = m_slots[i].load(std::memory_order_acquire);
+                if (chunk) fn(positionForSlot(i), chunk);
+            }
+            return;
+        }
+        for (size_t s = 0; s < kShardCount; ++s) {
+            std::shared_lock<std::shared_mutex> lk(m_shards[s].mutex);
+            for (const auto& [pos, chunk] : m_shards[s].chunks) fn(pos, chunk);
+        }
+    }
+
+    static constexpr size_t kMaxDenseSlots = size_t(1) << 22;
+
+private:
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<glm::ivec3, ServerChunk*, IVec3Hash, IVec3Eq> chunks;
+    };
+    static constexpr size_t kShardCount = 64;
+
+    bool slotIndex(const glm::ivec3& pos, size_t& outIndex) const noexcept;
+    glm::ivec3 positionForSlot(size_t index) const noexcept;
+    Shard& shardFor(const glm::ivec3& pos) const noexcept;
+    void retireChunk(ServerChunk* chunk);
+
+    glm::ivec3 m_min{ 0 };
+    glm::ivec3 m_extent{ 0 };
+    size_t m_slotCount = 0;
+    std::unique_ptr<std::atomic<ServerChunk*>[]> m_slots;
+    std::unique_ptr<Shard[]> m_shards;
+    std::atomic<size_t> m_count{ 0 };
+
+    std::mutex m_retiredMutex;
+    std::vector<std::unique_ptr<ServerChunk>> m_retired;
+};
@@ -1,48 +1,49 @@
 #include "ChunkManager.hpp"
 #include "WorldGen.hpp"
+#include "../network/ChunkSaver.hpp"
 #include <iostream>
 #include <cmath>
 #include <cstdint>
 #include <algorithm>
-#include <chrono>
 #include <atomic>
+#include <bit>
 #include <shared_mutex>
 
 namespace {
-constexpr bool kEnableChunkMapMutexDiagnostics = true;
-constexpr int64_t kSlowChunkMapLockWaitUs = 250;
 constexpr float kCollisionSkin = 0.001f;
-std::atomic<uint64_t> g_chunkMapSlowWaitLogCount{ 0 };
 
-void MaybeLogSlowChunkMapLock(const char* fn, int64_t waitUs) {
-    if (!kEnableChunkMapMutexDiagnostics || waitUs < kSlowChunkMapLockWaitUs) {
-        return;
-    }
-    const uint64_t count = g_chunkMapSlowWaitLogCount.fetch_add(1, std::memory_order_relaxed) + 1;
-    if (count <= 40 || (count % 200) == 0) {
-        std::cerr
-            << "[perf/chunk-map] slow lock wait fn=" << fn
-            << " waitUs=" << waitUs
-            << " count=" << count << "\n";
-    }
+// Voxel cells overlapped by a player AABB standing at `pos`.
+void AabbCellRange(const glm::vec3& pos, float radius, float height, glm::ivec3& outMin, glm::ivec3& outMax) {
+    // Keep parity with client collision sampling: touching faces should not count as penetration.
+    outMin = glm::ivec3(
+        static_cast<int>(std::floor(pos.x - radius + kCollisionSkin)),
+        static_cast<int>(std::floor(pos.y + kCollisionSkin)),
+        static_cast<int>(std::floor(pos.z - radius + kCollisionSkin))
+    );
+    outMax = glm::ivec3(
+        static_cast<int>(std::floor(pos.x + radius - kCollisionSkin)),
+        static_cast<int>(std::floor(pos.y + height - kCollisionSkin)),
+        static_cast<int>(std::floor(pos.z + radius - kCollisionSkin))
+    );
 }
 }
 
-ChunkManager::ChunkManager(uint64_t seed) : worldSeed(seed) {
+ChunkManager::ChunkManager(uint64_t seed)
+    : worldSeed(seed),
+    // One slot per in-bounds chunk; inBounds() and the directory extent must agree.
+    chunkDirectory(
+        glm::ivec3(WORLD_MIN_X, floorDiv(WORLD_MIN_Y, CHUNK_SIZE), WORLD_MIN_Z),
+        glm::ivec3(WORLD_MAX_X, floorDiv(WORLD_MAX_Y, CHUNK_SIZE), WORLD_MAX_Z)
+    )
+{
     noise.SetNoiseType(FastNoiseLite::NoiseType_Perlin);
     noise.SetFrequency(0.009f); // hilliness
     // seed noise deterministically from worldSeed
     noise.SetSeed(static_cast<int>(worldSeed & 0x7FFFFFFF));
+}
 
-    // Avoid costly hash-map rehashes while holding mapMutex on streaming spikes.
-    const int minChunkY = floorDiv(WORLD_MIN_Y, CHUNK_SIZE);
-    const int maxChunkY = floorDiv(WORLD_MAX_Y, CHUNK_SIZE);
-    const size_t expectedChunkCount =
-        static_cast<size_t>(WORLD_MAX_X - WORLD_MIN_X + 1) *
-        static_cast<size_t>(maxChunkY - minChunkY + 1) *
-        static_cast<size_t>(WORLD_MAX_Z - WORLD_MIN_Z + 1);
-    chunkMap.reserve(expectedChunkCount);
-    decoratedChunks.reserve(expectedChunkCount);
+ChunkManager::~ChunkManager() {
+    closeChunkStore();
 }
 
 void ChunkManager::generateInitialChunks(int numChunks) {
@@ -58,18 +59,22 @@ void ChunkManager::generateChunkAt(const glm::ivec3& pos) {
 }
 
 void ChunkManager::generateTerrainChunkAt(const glm::ivec3& pos) {
+    // Never shadow a persisted chunk (and its edits) with freshly generated terrain.
+    if (tryLoadChunkFromStore(pos)) return;
     WorldGen::generateTerrainChunkAt(*this, pos);
 }
 
 void ChunkManager::updateDirtyChunks() {
-    std::vector<ServerChunk*> toUpdate;
-    {
-        std::shared_lock<std::shared_mutex> lk(mapMutex);
-        for (auto& [pos, chunk] : chunkMap) {
-            if (chunk->dirty()) toUpdate.push_back(chunk.get());
-        }
+    if (chunkStore) {
+        saveDirtyChunks();
+        return;
     }
 
+    std::vector<ServerChunk*> toUpdate;
+    chunkDirectory.forEach([&](const glm::ivec3&, ServerChunk* chunk) {
+        if (chunk->dirty()) toUpdate.push_back(chunk);
+    });
+
     for (auto* c : toUpdate) {
         // placeholder server-side work (lighting, visibility caches, saving, etc)
         c->clearDirty();
@@ -105,25 +110,19 @@ void ChunkManager::updateChunks(const glm::ivec3& playerWorldPos, int renderDist
         }
     }
 
-    // unload chunks not desired
+    // unload chunks not desired (retired: raw pointers handed out earlier stay valid, and the
+    // memory is held until the directory goes away)
     std::vector<glm::ivec3> toErase;
-    {
-        std::lock_guard<std::shared_mutex> lk(mapMutex);
-        for (auto& [pos, chunk] : chunkMap)
-            if (desired.find(pos) == desired.end()) toErase.push_back(pos);
-        for (auto& pos : toErase) {
-            chunkMap.erase(pos);
-            decoratedChunks.erase(pos);
-        }
+    chunkDirectory.forEach([&](const glm::ivec3& pos, ServerChunk*) {
+        if (desired.find(pos) == desired.end()) toErase.push_back(pos);
+    });
+    for (auto& pos : toErase) {
+        chunkDirectory.retire(pos);
     }
 
     // load missing chunks (generate off-map then insert)
     for (const auto& pos : desired) {
-        // quick check with map lock
-        {
-            std::shared_lock<std::shared_mutex> lk(mapMutex);
-            if (chunkMap.find(pos) != chunkMap.end()) continue;
-        }
+        if (chunkDirectory.find(pos)) continue;
         // not present -> generate synchronously (could be made async)
         generateChunkAt(pos);
     }
@@ -134,13 +133,7 @@ void ChunkManager::setBlockInWorld(const glm::ivec3& worldPos, BlockID id) {
     glm::ivec3 lPos = worldToLocalPos(worldPos);
     if (!inBounds(cPos)) return;
 
-    // find chunk pointer under short lock
-    ServerChunk* chunkPtr = nullptr;
-    {
-        std::shared_lock<std::shared_mutex> lk(mapMutex);
-        auto it = chunkMap.find(cPos);
-        if (it != chunkMap.end()) chunkPtr = it->second.get();
-    }
+    ServerChunk* chunkPtr = chunkDirectory.find(cPos);
     if (!chunkPtr) return;
 
     // chunk methods are thread-safe
@@ -156,25 +149,39 @@ void ChunkManager::setBlockInWorld(const glm::ivec3& worldPos, BlockID id) {
     if (lPos.z == CHUNK_SIZE - 1) markChunkDirty(cPos + glm::ivec3(0, 0, 1));
 }
 
-void ChunkManager::setBlockGlobal(int worldX, int worldY, int worldZ, BlockID id) {
+std::optional<BlockID> ChunkManager::tryGetBlockGlobal(const glm::ivec3& worldPos) const {
+    const glm::ivec3 cp = worldToChunkPos(worldPos);
+    if (!inBounds(cp)) return BlockID::Air;
+
+    const ServerChunk* chunkPtr = chunkDirectory.find(cp);
+    if (!chunkPtr) return std::nullopt;
+    const glm::ivec3 lp = worldPos - cp * CHUNK_SIZE;
+    return chunkPtr->getBlockUnchecked(lp.x, lp.y, lp.z);
+}
+
+bool ChunkManager::setBlockIfLoaded(const glm::ivec3& worldPos, BlockID id) {
+    const glm::ivec3 cp = worldToChunkPos(worldPos);
+    if (!inBounds(cp)) return false;
+
+    ServerChunk* chunkPtr = chunkDirectory.find(cp);
+    if (!chunkPtr) return false;
+    const glm::ivec3 lp = worldPos - cp * CHUNK_SIZE;
+    chunkPtr->applyEdit(lp.x, lp.y, lp.z, id);
+    return true;
+}
+
+void ChunkManager::setOrGenerateBlockGlobal(int worldX, int worldY, int worldZ, BlockID id) {
     glm::ivec3 worldPos(worldX, worldY, worldZ);
     glm::ivec3 chunkPos = worldToChunkPos(worldPos);
     glm::ivec3 localPos = worldToLocalPos(worldPos);
     if (!inBounds(chunkPos)) return;
 
-    ServerChunk* chunkPtr = nullptr;
-    {
-        std::shared_lock<std::shared_mutex> lk(mapMutex);
-        auto it = chunkMap.find(chunkPos);
-        if (it != chunkMap.end()) chunkPtr = it->second.get();
-    }
+    ServerChunk* chunkPtr = chunkDirectory.find(chunkPos);
 
     // For cross-chunk edits during generation (tree borders), materialize terrain if absent.
     if (!chunkPtr) {
         generateTerrainChunkAt(chunkPos);
-        std::shared_lock<std::shared_mutex> lk(mapMutex);
-        auto it = chunkMap.find(chunkPos);
-        if (it != chunkMap.end()) chunkPtr = it->second.get();
+        chunkPtr = chunkDirectory.find(chunkPos);
     }
 
     if (!chunkPtr) return;
@@ -182,49 +189,92 @@ void ChunkManager::setBlockGlobal(int worldX, int worldY, int worldZ, BlockID id
     chunkPtr->markDirty();
 }
 
-BlockID ChunkManager::getBlockGlobal(int worldX, int worldY, int worldZ) {
+BlockID ChunkManager::getOrGenerateBlockGlobal(int worldX, int worldY, int worldZ) {
     glm::ivec3 wp(worldX, worldY, worldZ);
     glm::ivec3 cp = worldToChunkPos(wp);
     glm::ivec3 lp = worldToLocalPos(wp);
     if (!inBounds(cp)) return BlockID::Air;
 
-    ServerChunk* chunkPtr = nullptr;
-    {
-        const auto lockStart = std::chrono::steady_clock::now();
-        std::shared_lock<std::shared_mutex> lk(mapMutex);
-        const auto waitUs = std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::steady_clock::now() - lockStart
-        ).count();
-        MaybeLogSlowChunkMapLock("getBlockGlobal.lookup", waitUs);
-        auto it = chunkMap.find(cp);
-        if (it != chunkMap.end()) chunkPtr = it->second.get();
-    }
+    ServerChunk* chunkPtr = chunkDirectory.find(cp);
 
     // Mirror write path behavior so neighbor reads during border decoration see real terrain.
     if (!chunkPtr) {
         generateTerrainChunkAt(cp);
-        const auto lockStart = std::chrono::steady_clock::now();
-        std::shared_lock<std::shared_mutex> lk(mapMutex);
-        const auto waitUs = std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::steady_clock::now() - lockStart
-        ).count();
-        MaybeLogSlowChunkMapLock("getBlockGlobal.postGenerateLookup", waitUs);
-        auto it = chunkMap.find(cp);
-        if (it != chunkMap.end()) chunkPtr = it->second.get();
+        chunkPtr = chunkDirectory.find(cp);
     }
 
     if (!chunkPtr) return BlockID::Air;
     return chunkPtr->getBlock(lp.x, lp.y, lp.z);
 }
 
+std::shared_future<ServerChunk*> ChunkManager::ensureChunkLoadedAsync(const glm::ivec3& chunkPos) {
+    auto ready = [](ServerChunk* chunk) {
+        std::promise<ServerChunk*> promise;
+        promise.set_value(chunk);
+        return promise.get_future().share();
+    };
+    if (!inBounds(chunkPos)) return ready(nullptr);
+    if (ServerChunk* chunk = chunkDirectory.find(chunkPos)) return ready(chunk);
+
+    ChunkLoadRequestedCallback callback = nullptr;
+    void* callbackContext = nullptr;
+    std::shared_future<ServerChunk*> future;
+    {
+        std::lock_guard<std::mutex> lk(pendingChunkLoadMutex);
+        auto it = pendingChunkLoads.find(chunkPos);
+        if (it != pendingChunkLoads.end()) return it->second;
+
+        // The load may have finished between the lookup above and taking the lock.
+        if (ServerChunk* chunk = chunkDirectory.find(chunkPos)) return ready(chunk);
+
+        PendingChunkLoad& load = pendingChunkLoadQueue.emplace_back();
+        load.pos = chunkPos;
+        future = load.promise.get_future().share();
+        pendingChunkLoads.emplace(chunkPos, future);
+        pendingChunkLoadCount.fetch_add(1, std::memory_order_release);
+        callback = chunkLoadRequestedCallback;
+        callbackContext = chunkLoadRequestedContext;
+    }
+    if (callback) callback(callbackContext);
+    return future;
+}
+
+size_t ChunkManager::runPendingChunkLoads(size_t maxLoads) {
+    size_t ran = 0;
+    while (ran < maxLoads) {
+        PendingChunkLoad load;
+        {
+            std::lock_guard<std::mutex> lk(pendingChunkLoadMutex);
+            if (pendingChunkLoadQueue.empty()) break;
+            load = std::move(pendingChunkLoadQueue.front());
+            pendingChunkLoadQueue.pop_front();
+            pendingChunkLoadCount.fetch_sub(1, std::memory_order_release);
+        }
+
+        ServerChunk* chunk = chunkDirectory.find(load.pos);
+        if (!chunk) {
+            generateTerrainChunkAt(load.pos);
+            chunk = chunkDirectory.find(load.pos);
+        }
+
+        {
+            std::lock_guard<std::mutex> lk(pendingChunkLoadMutex);
+            pendingChunkLoads.erase(load.pos);
+        }
+        load.promise.set_value(chunk);
+        ++ran;
+    }
+    return ran;
+}
+
+void ChunkManager::setChunkLoadRequestedCallback(ChunkLoadRequestedCallback callback, void* context) {
+    std::lock_guard<std::mutex> lk(pendingChunkLoadMutex);
+    chunkLoadRequestedCallback = callback;
+    chunkLoadRequestedContext = context;
+}
+
 bool ChunkManager::hasChunkLoaded(const glm::ivec3& chunkPos) const {
-    const auto lockStart = std::chrono::steady_clock::now();
-    std::shared_lock<std::shared_mutex> lk(mapMutex);
-    const auto waitUs = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now() - lockStart
-    ).count();
-    MaybeLogSlowChunkMapLock("hasChunkLoaded", waitUs);
-    return chunkMap.find(chunkPos) != chunkMap.end();
+    return chunkDirectory.find(chunkPos) != nullptr;
 }
 
 ChunkManager::AabbCollisionQueryResult ChunkManager::queryAabbCollision(
@@ -235,35 +285,19 @@ ChunkManager::AabbCollisionQueryResult ChunkManager::queryAabbCollision(
 ) const {
     AabbCollisionQueryResult result{};
 
-    // Keep parity with client collision sampling: touching faces should not count as penetration.
-    const float minX = pos.x - radius + kCollisionSkin;
-    const float maxX = pos.x + radius - kCollisionSkin;
-    const float minY = pos.y + kCollisionSkin;
-    const float maxY = pos.y + height - kCollisionSkin;
-    const float minZ = pos.z - radius + kCollisionSkin;
-    const float maxZ = pos.z + radius - kCollisionSkin;
-
-    const int ix0 = static_cast<int>(std::floor(minX));
-    const int iy0 = static_cast<int>(std::floor(minY));
-    const int iz0 = static_cast<int>(std::floor(minZ));
-    const int ix1 = static_cast<int>(std::floor(maxX));
-    const int iy1 = static_cast<int>(std::floor(maxY));
-    const int iz1 = static_cast<int>(std::floor(maxZ));
-
-    const auto lockStart = std::chrono::steady_clock::now();
-    std::shared_lock<std::shared_mutex> lk(mapMutex);
-    const auto waitUs = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now() - lockStart
-    ).count();
-    MaybeLogSlowChunkMapLock("queryAabbCollision.scan", waitUs);
+    glm::ivec3 minCell(0);
+    glm::ivec3 maxCell(0);
+    AabbCellRange(pos, radius, height, minCell, maxCell);
 
+    // one reader pin for every probe below
+    const ServerChunk::ReadScope readScope;
     glm::ivec3 cachedChunkPos(0);
     ServerChunk* cachedChunk = nullptr;
     bool hasCachedChunk = false;
 
-    for (int x = ix0; x <= ix1; ++x) {
-        for (int y = iy0; y <= iy1; ++y) {
-            for (int z = iz0; z <= iz1; ++z) {
+    for (int x = minCell.x; x <= maxCell.x; ++x) {
+        for (int y = minCell.y; y <= maxCell.y; ++y) {
+            for (int z = minCell.z; z <= maxCell.z; ++z) {
                 const glm::ivec3 worldPos(x, y, z);
                 const glm::ivec3 chunkPos = worldToChunkPos(worldPos);
                 if (!inBounds(chunkPos)) {
@@ -275,10 +309,7 @@ ChunkManager::AabbCollisionQueryResult ChunkManager::queryAabbCollision(
                     chunkPtr = cachedChunk;
                 }
                 else {
-                    auto it = chunkMap.find(chunkPos);
-                    if (it != chunkMap.end()) {
-                        chunkPtr = it->second.get();
-                    }
+                    chunkPtr = chunkDirectory.find(chunkPos);
                     cachedChunkPos = chunkPos;
                     cachedChunk = chunkPtr;
                     hasCachedChunk = true;
@@ -308,6 +339,123 @@ ChunkManager::AabbCollisionQueryResult ChunkManager::queryAabbCollision(
     return result;
 }
 
+void ChunkManager::captureCollisionGrid(
+    const glm::vec3& pos,
+    float radius,
+    float height,
+    const glm::vec3& reachMin,
+    const glm::vec3& reachMax,
+    VoxelCollisionGrid& outGrid
+) const {
+    glm::ivec3 standMin(0), standMax(0);
+    glm::ivec3 reachLo(0), unused(0), reachHi(0);
+    AabbCellRange(pos, radius, height, standMin, standMax);
+    AabbCellRange(pos + glm::min(reachMin, reachMax), radius, height, reachLo, unused);
+    AabbCellRange(pos + glm::max(reachMin, reachMax), radius, height, unused, reachHi);
+    reachLo = glm::min(reachLo, standMin);
+    reachHi = glm::max(reachHi, standMax);
+
+    constexpr int kMax = VoxelCollisionGrid::kMaxExtent;
+    for (int axis = 0; axis < 3; ++axis) {
+        const int span = reachHi[axis] - reachLo[axis] + 1;
+        if (span <= kMax) {
+            outGrid.origin[axis] = reachLo[axis];
+            outGrid.extent[axis] = span;
+            continue;
+        }
+        // Too far to capture in one go: keep the cells around the current position and let
+        // probes beyond the box take the direct query.
+        const int standSpan = standMax[axis] - standMin[axis] + 1;
+        const int start = standMin[axis] - std::max(0, kMax - standSpan) / 2;
+        outGrid.origin[axis] = std::clamp(start, reachLo[axis], reachHi[axis] - kMax + 1);
+        outGrid.extent[axis] = kMax;
+    }
+    outGrid.solid.fill(0);
+    outGrid.missing.fill(0);
+
+    const ServerChunk::ReadScope readScope;
+    glm::ivec3 cachedChunkPos(0);
+    ServerChunk* cachedChunk = nullptr;
+    bool hasCachedChunk = false;
+
+    for (int z = 0; z < outGrid.extent.z; ++z) {
+        uint64_t solidBits = 0;
+        uint64_t missingBits = 0;
+        for (int y = 0; y < outGrid.extent.y; ++y) {
+            for (int x = 0; x < outGrid.extent.x; ++x) {
+                const glm::ivec3 worldPos = outGrid.origin + glm::ivec3(x, y, z);
+                const glm::ivec3 chunkPos = worldToChunkPos(worldPos);
+                if (!inBounds(chunkPos)) {
+                    continue;
+                }
+
+                if (!hasCachedChunk || chunkPos != cachedChunkPos) {
+                    cachedChunk = chunkDirectory.find(chunkPos);
+                    cachedChunkPos = chunkPos;
+                    hasCachedChunk = true;
+                }
+
+                const uint64_t bit = uint64_t(1) << (x + kMax * y);
+                if (!cachedChunk) {
+                    missingBits |= bit;
+                    continue;
+                }
+                const glm::ivec3 localPos = worldPos - chunkPos * CHUNK_SIZE;
+                if (cachedChunk->getBlock(localPos.x, localPos.y, localPos.z) != BlockID::Air) {
+                    solidBits |= bit;
+                }
+            }
+        }
+        outGrid.solid[z] = solidBits;
+        outGrid.missing[z] = missingBits;
+    }
+}
+
+ChunkManager::AabbCollisionQueryResult ChunkManager::queryAabbCollision(
+    const VoxelCollisionGrid& grid,
+    const glm::vec3& pos,
+    float radius,
+    float height,
+    bool treatMissingChunkAsSolid
+) const {
+    glm::ivec3 minCell(0);
+    glm::ivec3 maxCell(0);
+    AabbCellRange(pos, radius, height, minCell, maxCell);
+    if (!grid.contains(minCell, maxCell)) {
+        return queryAabbCollision(pos, radius, height, treatMissingChunkAsSolid);
+    }
+
+    AabbCollisionQueryResult result{};
+    const glm::ivec3 lo = minCell - grid.origin;
+    const glm::ivec3 hi = maxCell - grid.origin;
+    const uint64_t rowMask = (uint64_t(1) << (hi.x - lo.x + 1)) - 1;
+
+    for (int z = lo.z; z <= hi.z; ++z) {
+        for (int y = lo.y; y <= hi.y; ++y) {
+            const int shift = lo.x + VoxelCollisionGrid::kMaxExtent * y;
+            if ((grid.solid[z] >> shift) & rowMask) {
+                result.collided = true;
+                return result;
+            }
+            const uint64_t missingRow = (grid.missing[z] >> shift) & rowMask;
+            if (missingRow == 0) {
+                continue;
+            }
+            if (!result.missingChunk) {
+                const int x = lo.x + std::countr_zero(missingRow);
+                result.missingChunk = true;
+                result.firstMissingChunk = worldToChunkPos(grid.origin + glm::ivec3(x, y, z));
+            }
+            if (treatMissingChunkAsSolid) {
+                result.collided = true;
+                return result;
+            }
+        }
+    }
+
+    return result;
+}
+
 void ChunkManager::setBlockSafe(ServerChunk& currentChunk, const glm::ivec3& pos, BlockID id) {
     if (pos.x >= 0 && pos.x < CHUNK_SIZE &&
         pos.y >= 0 && pos.y < CHUNK_SIZE &&
@@ -317,7 +465,7 @@ void ChunkManager::setBlockSafe(ServerChunk& currentChunk, const glm::ivec3& pos
     }
     else {
         glm::ivec3 worldPos = currentChunk.getWorldPosition() + pos;
-        setBlockGlobal(worldPos.x, worldPos.y, worldPos.z, id);
+        setOrGenerateBlockGlobal(worldPos.x, worldPos.y, worldPos.z, id);
     }
 }
 
@@ -329,7 +477,7 @@ BlockID ChunkManager::getBlockSafe(ServerChunk& currentChunk, const glm::ivec3&
     }
     else {
         glm::ivec3 worldPos = currentChunk.getWorldPosition() + pos;
-        return getBlockGlobal(worldPos.x, worldPos.y, worldPos.z);
+        return getOrGenerateBlockGlobal(worldPos.x, worldPos.y, worldPos.z);
     }
 }
 
@@ -367,33 +515,21 @@ std::array<bool, 6> ChunkManager::getVisibleChunkFaces(const glm::ivec3& pos) co
 
 void ChunkManager::markChunkDirty(const glm::ivec3& pos) {
     if (!inBounds(pos)) return;
-    ServerChunk* chunkPtr = nullptr;
-    {
-        std::shared_lock<std::shared_mutex> lk(mapMutex);
-        auto it = chunkMap.find(pos);
-        if (it != chunkMap.end()) chunkPtr = it->second.get();
-    }
+    ServerChunk* chunkPtr = chunkDirectory.find(pos);
     if (chunkPtr) chunkPtr->markDirty();
 }
 
 std::unordered_map<glm::ivec3, ServerChunk*, IVec3Hash, IVec3Eq> ChunkManager::snapshotChunkMap() const {
     std::unordered_map<glm::ivec3, ServerChunk*, IVec3Hash, IVec3Eq> snap;
-    std::shared_lock<std::shared_mutex> lk(mapMutex);
-    for (const auto& kv : chunkMap) snap[kv.first] = kv.second.get();
+    snap.reserve(chunkDirectory.size());
+    chunkDirectory.forEach([&](const glm::ivec3& pos, ServerChunk* chunk) { snap[pos] = chunk; });
     return snap;
 }
 
 
 
 ServerChunk* ChunkManager::getChunkIfExists(const glm::ivec3& chunkPos) const {
-    const auto lockStart = std::chrono::steady_clock::now();
-    std::shared_lock<std::shared_mutex> lk(mapMutex);
-    const auto waitUs = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now() - lockStart
-    ).count();
-    MaybeLogSlowChunkMapLock("getChunkIfExists", waitUs);
-    auto it = chunkMap.find(chunkPos);
-    return (it != chunkMap.end()) ? it->second.get() : nullptr;
+    return chunkDirectory.find(chunkPos);
 }
 
 
@@ -401,48 +537,129 @@ ServerChunk* ChunkManager::getChunkIfExists(const glm::ivec3& chunkPos) const {
 ServerChunk* ChunkManager::loadOrGenerateChunk(const glm::ivec3& chunkPos) {
     if (!inBounds(chunkPos)) return nullptr;
 
-    bool needsDecoration = false;
     // quick path: check if present
-    {
-        const auto lockStart = std::chrono::steady_clock::now();
-        std::shared_lock<std::shared_mutex> lk(mapMutex);
-        const auto waitUs = std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::steady_clock::now() - lockStart
-        ).count();
-        MaybeLogSlowChunkMapLock("loadOrGenerateChunk.initialLookup", waitUs);
-        auto it = chunkMap.find(chunkPos);
-        if (it != chunkMap.end()) {
-            needsDecoration = (decoratedChunks.find(chunkPos) == decoratedChunks.end());
-            if (!needsDecoration) {
-                return it->second.get();
-            }
-        }
+    ServerChunk* chunk = chunkDirectory.find(chunkPos);
+    if (chunk && chunk->decorated()) return chunk;
+
+    // Warm-load from the region store before falling back to generation.
+    if (!chunk && tryLoadChunkFromStore(chunkPos)) {
+        chunk = chunkDirectory.find(chunkPos);
+        if (!chunk || chunk->decorated()) return chunk;
     }
 
     // Upgrade terrain-only placeholders to decorated chunks when explicitly streamed.
-    if (needsDecoration) {
+    if (chunk) {
         WorldGen::decorateChunkAt(*this, chunkPos);
-        const auto lockStart = std::chrono::steady_clock::now();
-        std::shared_lock<std::shared_mutex> lk(mapMutex);
-        const auto waitUs = std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::steady_clock::now() - lockStart
-        ).count();
-        MaybeLogSlowChunkMapLock("loadOrGenerateChunk.postDecorateLookup", waitUs);
-        auto it = chunkMap.find(chunkPos);
-        return (it != chunkMap.end()) ? it->second.get() : nullptr;
+        return chunk;
     }
 
     // Streamed chunks should include the same decoration behavior as client world generation.
     generateChunkAt(chunkPos);
 
-    const auto lockStart = std::chrono::steady_clock::now();
-    std::shared_lock<std::shared_mutex> lk(mapMutex);
-    const auto waitUs = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now() - lockStart
-    ).count();
-    MaybeLogSlowChunkMapLock("loadOrGenerateChunk.postGenerateLookup", waitUs);
-    auto it = chunkMap.find(chunkPos);
-    return (it != chunkMap.end()) ? it->second.get() : nullptr;
+    // A concurrent terrain-only generation can win the insert; decorate that instance instead.
+    chunk = chunkDirectory.find(chunkPos);
+    if (chunk && !chunk->decorated()) {
+        WorldGen::decorateChunkAt(*this, chunkPos);
+    }
+    return chunk;
+}
+
+
+
+bool ChunkManager::openChunkStore(const std::filesystem::path& worldDir, const ChunkSaverConfig& saveConfig) {
+    auto store = std::make_unique<ChunkStore>(worldDir);
+    std::error_code ec;
+    if (!std::filesystem::is_directory(worldDir, ec)) {
+        return false;
+    }
+    chunkStore = std::move(store);
+    chunkSaver = std::make_unique<ChunkSaver>(*this, *chunkStore, saveConfig);
+    chunkSaver->start();
+    activeSaver.store(chunkSaver.get(), std::memory_order_release);
+    return true;
 }
 
+void ChunkManager::closeChunkStore() {
+    activeSaver.store(nullptr, std::memory_order_release);
+    if (chunkSaver) {
+        chunkSaver->stop();
+        chunkSaver.reset();
+    }
+    if (!chunkStore) return;
+    // catch anything that went dirty without reaching the saver (e.g. a failed final write)
+    saveDirtyChunks();
+    chunkStore->close();
+    chunkStore.reset();
+}
 
+size_t ChunkManager::saveDirtyChunks() {
+    if (!chunkStore) return 0;
+
+    std::vector<glm::ivec3> dirtyPositions;
+    chunkDirectory.forEach([&](const glm::ivec3& pos, ServerChunk* chunk) {
+        if (chunk->dirty()) dirtyPositions.push_back(pos);
+    });
+    if (dirtyPositions.empty()) return 0;
+
+    std::vector<ChunkStore::SaveRecord> records;
+    records.reserve(dirtyPositions.size());
+    for (const auto& pos : dirtyPositions) {
+        ChunkStore::SaveRecord record;
+        if (snapshotChunkForSave(pos, record)) {
+            records.push_back(std::move(record));
+        }
+    }
+
+    const size_t saved = chunkStore->saveChunks(records);
+    for (const auto& record : records) {
+        if (!record.saved) markChunkDirty(record.chunkPos);
+    }
+    return saved;
+}
+
+bool ChunkManager::snapshotChunkForSave(const glm::ivec3& pos, ChunkStore::SaveRecord& outRecord) {
+    ServerChunk* chunkPtr = chunkDirectory.find(pos);
+    if (!chunkPtr) return false;
+    const bool decorated = chunkPtr->decorated();
+
+    // clear before snapshotting so an edit racing with the save re-marks (and re-queues) the chunk
+    chunkPtr->clearDirty();
+    outRecord.chunkPos = pos;
+    outRecord.decorated = decorated;
+    outRecord.blob = chunkPtr->serializeCompressed();
+    outRecord.saved = false;
+    // Edits that changed the storage width have long settled by the time a chunk is saved.
+    chunkPtr->releaseRetiredStorage();
+    return true;
+}
+
+void ChunkManager::handleChunkDirtied(void* context, const glm::ivec3& chunkPos, int64_t version) {
+    auto* self = static_cast<ChunkManager*>(context);
+    ChunkSaver* saver = self->activeSaver.load(std::memory_order_acquire);
+    if (saver) saver->enqueue(chunkPos, version);
+}
+
+bool ChunkManager::insertChunk(const glm::ivec3& pos, std::unique_ptr<ServerChunk> chunk) {
+    chunk->setDirtyCallback(&ChunkManager::handleChunkDirtied, this);
+    const bool alreadyDirty = chunk->dirty();
+    const int64_t version = chunk->version();
+    // First insert wins: several prep workers can generate the same chunk concurrently, and the
+    // resident instance may already be referenced by raw pointer elsewhere.
+    if (!chunkDirectory.publish(pos, std::move(chunk))) return false;
+    // edits made before publication could not reach the saver
+    if (alreadyDirty) handleChunkDirtied(this, pos, version);
+    return true;
+}
+
+bool ChunkManager::tryLoadChunkFromStore(const glm::ivec3& pos) {
+    if (!chunkStore || !inBounds(pos)) return false;
+
+    auto chunk = std::make_unique<ServerChunk>(pos);
+    bool decorated = false;
+    if (!chunkStore->loadChunk(pos, *chunk, decorated)) return false;
+
+    chunk->setDecorated(decorated);
+    // another thread may have produced this chunk meanwhile; keep the instance already handed out
+    insertChunk(pos, std::move(chunk));
+    return true;
+}
@@ -11,8 +11,14 @@
 #include <cstdint>
 #include <cmath>
 #include <memory>
+#include <atomic>
+#include <filesystem>
+#include <future>
+#include <deque>
 
 #include "../voxels/ServerChunk.hpp"
+#include "../network/ChunkStore.hpp"
+#include "ChunkDirectory.hpp"
 #include "../ExternLibs/FastNoiseLite.h"
 
 // world extents in chunk coordinates (keep in sync with your constants elsewhere)
@@ -23,22 +29,28 @@ constexpr int WORLD_MAX_Z = 20;
 constexpr int WORLD_MIN_Y = -16;
 constexpr int WORLD_MAX_Y = 32;
 
-struct IVec3Hash {
-    std::size_t operator()(glm::ivec3 const& v) const noexcept {
-        uint64_t x = static_cast<uint32_t>(v.x);
-        uint64_t y = static_cast<uint32_t>(v.y);
-        uint64_t z = static_cast<uint32_t>(v.z);
-        uint64_t h = (x * 73856093u) ^ (y * 19349663u) ^ (z * 83492791u);
-        return static_cast<std::size_t>(h);
-    }
-};
-struct IVec3Eq {
-    bool operator()(glm::ivec3 const& a, glm::ivec3 const& b) const noexcept {
-        return a.x == b.x && a.y == b.y && a.z == b.z;
+// Solid/missing occupancy of a small voxel box, captured once so that the many sweep and
+// step-up probes of one movement step are bit tests instead of chunk lookups.
+// Bit (x, y, z) of the box lives in word z at bit x + 8 * y, so an x-row is one shift and mask.
+struct VoxelCollisionGrid {
+    static constexpr int kMaxExtent = 8;
+
+    glm::ivec3 origin{ 0 };
+    glm::ivec3 extent{ 0 };
+    std::array<uint64_t, kMaxExtent> solid{};
+    std::array<uint64_t, kMaxExtent> missing{};
+
+    bool contains(const glm::ivec3& minCell, const glm::ivec3& maxCell) const noexcept {
+        const glm::ivec3 lo = minCell - origin;
+        const glm::ivec3 hi = maxCell - origin;
+        return lo.x >= 0 && lo.y >= 0 && lo.z >= 0 &&
+            hi.x < extent.x && hi.y < extent.y && hi.z < extent.z;
     }
 };
 
 class WorldGen;
+class ChunkSaver;
+struct ChunkSaverConfig;
 
 class ChunkManager {
 public:
@@ -49,7 +61,7 @@ public:
     };
 
     ChunkManager(uint64_t seed = 1337u);
-    ~ChunkManager() = default;
+    ~ChunkManager();
 
     // Non-copyable
     ChunkManager(const ChunkManager&) = delete;
@@ -66,21 +78,65 @@ public:
 
     // Chunk lifecycle / updates
     void updateDirtyChunks();
+    // Not called from the tick: every chunk it unloads is retired, and retired chunks are only
+    // freed with the directory (see ChunkDirectory::retire), so calling it per tick leaks.
     void updateChunks(const glm::ivec3& playerWorldPos, int renderDistance);
 
-    // Block access (thread-safe wrappers that find the chunk then call chunk methods)
-    void setBlockInWorld(const glm::ivec3& worldPos, BlockID blockID);
-    void setBlockGlobal(int worldX, int worldY, int worldZ, BlockID id);
-    BlockID getBlockGlobal(int worldX, int worldY, int worldZ);
+    // Block access (thread-safe wrappers that find the chunk then call chunk methods).
+    //
+    // Pure reads and writes: only touch chunks that are already loaded, never generate, and take
+    // no locks beyond the chunk's own. Safe on the network and simulation threads.
+    // nullopt when the chunk is not loaded; positions outside the world read as air.
+    std::optional<BlockID> tryGetBlockGlobal(const glm::ivec3& worldPos) const;
+    // False (and nothing written) when the chunk is not loaded or outside the world.
+    bool setBlockIfLoaded(const glm::ivec3& worldPos, BlockID id);
+    void setBlockInWorld(const glm::ivec3& worldPos, BlockID blockID); // also marks edge neighbours dirty
     bool hasChunkLoaded(const glm::ivec3& chunkPos) const;
+
+    // Generation on demand: a missing chunk is warm-loaded or generated (terrain only) on the
+    // calling thread first, which can take milliseconds. For world generation and the chunk
+    // prep workers only.
+    void setOrGenerateBlockGlobal(int worldX, int worldY, int worldZ, BlockID id);
+    BlockID getOrGenerateBlockGlobal(int worldX, int worldY, int worldZ);
+
+    // Asynchronous load: returns a future for the chunk at chunkPos (nullptr when out of bounds).
+    // Resident chunks resolve immediately; otherwise the request is queued, deduplicated per
+    // position, and carried out like generateTerrainChunkAt by whoever calls runPendingChunkLoads.
+    std::shared_future<ServerChunk*> ensureChunkLoadedAsync(const glm::ivec3& chunkPos);
+    // Whether queued loads are waiting for a thread to pick them up.
+    bool hasPendingChunkLoads() const noexcept { return pendingChunkLoadCount.load(std::memory_order_acquire) != 0; }
+    // Carries out up to maxLoads queued loads on the calling thread. Returns how many ran.
+    size_t runPendingChunkLoads(size_t maxLoads);
+    // Invoked (from the requesting thread, with no manager locks held) whenever a load is queued.
+    using ChunkLoadRequestedCallback = void (*)(void* context);
+    void setChunkLoadRequestedCallback(ChunkLoadRequestedCallback callback, void* context);
+    AabbCollisionQueryResult queryAabbCollision(
+        const glm::vec3& pos,
+        float radius,
+        float height,
+        bool treatMissingChunkAsSolid
+    ) const;
+    // Captures the voxels an AABB at `pos` can touch while moving by any offset in
+    // [reachMin, reachMax]. Each axis is capped at VoxelCollisionGrid::kMaxExtent cells.
+    void captureCollisionGrid(
+        const glm::vec3& pos,
+        float radius,
+        float height,
+        const glm::vec3& reachMin,
+        const glm::vec3& reachMax,
+        VoxelCollisionGrid& outGrid
+    ) const;
+    // Same answer as the overload above, read from `grid`; probes reaching outside it fall back to it.
     AabbCollisionQueryResult queryAabbCollision(
+        const VoxelCollisionGrid& grid,
         const glm::vec3& pos,
         float radius,
         float height,
         bool treatMissingChunkAsSolid
     ) const;
 
-    // Safe local block access (handles cross-chunk writes)
+    // Safe local block access (handles cross-chunk writes; generates missing neighbours, see
+    // getOrGenerateBlockGlobal). Used by the decoration pass.
     void setBlockSafe(ServerChunk& currentChunk, const glm::ivec3& pos, BlockID id);
     BlockID getBlockSafe(ServerChunk& currentChunk, const glm::ivec3& pos);
 
@@ -92,21 +148,30 @@ public:
     void markChunkDirty(const glm::ivec3& pos);
     std::array<bool, 6> getVisibleChunkFaces(const glm::ivec3& pos) const;
 
-    // Thread-safe access to the chunk map
+    // Thread-safe access to the chunk directory
     // snapshotChunkMap: returns a copy of map entries -> raw pointers (safe for iteration; chunks still protected internally)
     std::unordered_map<glm::ivec3, ServerChunk*, IVec3Hash, IVec3Eq> snapshotChunkMap() const;
 
-    // Unsafe low-level access: returns reference to internal map. Caller MUST hold mapMutex for the duration of use.
-    std::unordered_map<glm::ivec3, std::unique_ptr<ServerChunk>, IVec3Hash, IVec3Eq>& getChunksRefUnsafe() { return chunkMap; }
-
-    // Helper: safely obtain a raw pointer to a chunk (or nullptr if missing). Snapshot-style (map lock held briefly).
+    // Helper: lock-free lookup of a chunk (or nullptr if missing). Pointers stay valid for the
+    // manager's lifetime, even if the chunk is later unloaded.
     ServerChunk* getChunkIfExists(const glm::ivec3& chunkPos) const;
 
-    // Synchronous helper: find chunk or generate it (generates off-map and inserts under lock).
+    // Synchronous helper: find chunk or generate it (generates off-map, then publishes it).
     // Returns pointer to chunk in the map (never nullptr if pos in-bounds and generation succeeded).
     // Note: generation may be expensive - consider calling generateChunkAt asynchronously instead.
     ServerChunk* loadOrGenerateChunk(const glm::ivec3& chunkPos);
 
+    // Persistence (region files under worldDir). While a store is open, chunks missing from the map
+    // are warm-loaded from disk before falling back to generation, and dirty chunks are written
+    // behind by a background ChunkSaver.
+    bool openChunkStore(const std::filesystem::path& worldDir, const ChunkSaverConfig& saveConfig);
+    // Stops the saver (flushing everything pending) and closes the store.
+    void closeChunkStore();
+    // Synchronously writes every dirty chunk to the store. Returns the number of chunks saved.
+    size_t saveDirtyChunks();
+    // Clears the dirty flag and captures the chunk's current bytes. Returns false if pos is not loaded.
+    bool snapshotChunkForSave(const glm::ivec3& pos, ChunkStore::SaveRecord& outRecord);
+
     // World settings / toggles
     bool enableAO = false;
     bool enableShadows = false;
@@ -117,11 +182,33 @@ private:
     FastNoiseLite noise;
     uint64_t worldSeed = 1337u;
 
-    // protects chunkMap structure (only)
-    mutable std::shared_mutex mapMutex;
-    std::unordered_map<glm::ivec3, std::unique_ptr<ServerChunk>, IVec3Hash, IVec3Eq> chunkMap;
-    // Tracks whether a chunk has had decoration pass applied at least once.
-    std::unordered_set<glm::ivec3, IVec3Hash, IVec3Eq> decoratedChunks;
+    // Owns every loaded chunk. Whether a chunk has had the decoration pass applied is tracked on
+    // the chunk itself (ServerChunk::decorated).
+    ChunkDirectory chunkDirectory;
+
+    std::unique_ptr<ChunkStore> chunkStore;
+    std::unique_ptr<ChunkSaver> chunkSaver;
+    // read from editing threads through the chunk dirty callback
+    std::atomic<ChunkSaver*> activeSaver{ nullptr };
+    static void handleChunkDirtied(void* context, const glm::ivec3& chunkPos, int64_t version);
+
+    // ensureChunkLoadedAsync queue; a position is in pendingChunkLoads until its promise is set,
+    // pendingChunkLoadCount counts queue entries not yet picked up.
+    struct PendingChunkLoad {
+        glm::ivec3 pos{ 0 };
+        std::promise<ServerChunk*> promise;
+    };
+    mutable std::mutex pendingChunkLoadMutex;
+    std::deque<PendingChunkLoad> pendingChunkLoadQueue;
+    std::unordered_map<glm::ivec3, std::shared_future<ServerChunk*>, IVec3Hash, IVec3Eq> pendingChunkLoads;
+    std::atomic<size_t> pendingChunkLoadCount{ 0 };
+    ChunkLoadRequestedCallback chunkLoadRequestedCallback = nullptr;
+    void* chunkLoadRequestedContext = nullptr;
+    // Publishes chunk at pos unless another instance is already resident (returns false and drops
+    // chunk in that case). Set the chunk's decorated flag before calling.
+    bool insertChunk(const glm::ivec3& pos, std::unique_ptr<ServerChunk> chunk);
+    // Inserts the persisted copy of pos if the store has one. Returns true if pos is now in the map.
+    bool tryLoadChunkFromStore(const glm::ivec3& pos);
 
     static inline int floorDiv(int a, int b) {
         int q = a / b;
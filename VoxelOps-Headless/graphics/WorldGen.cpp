@@ -72,8 +72,7 @@ void WorldGen::generateInitialChunksTwoPass(ChunkManager& cm, int radiusChunks)
     for (auto& [pos, chunkPtr] : snap) {
         if (!chunkPtr) continue;
         applyClientDecorationPass(cm, *chunkPtr, pos);
-        std::lock_guard<std::shared_mutex> lk(cm.mapMutex);
-        cm.decoratedChunks.insert(pos);
+        chunkPtr->setDecorated(true);
     }
 
     cm.updateDirtyChunks();
@@ -83,6 +82,9 @@ void WorldGen::generateChunkAt(ChunkManager& cm, const glm::ivec3& pos) {
     if (!cm.inBounds(pos)) return;
 
     auto chunk = std::make_unique<ServerChunk>(pos);
+    // Fill locally and hand over in one go so generation does not go through the edit log.
+    std::array<BlockID, CHUNK_VOLUME> blocks;
+    blocks.fill(BlockID::Air);
 
     for (int z = 0; z < CHUNK_SIZE; ++z) {
         for (int x = 0; x < CHUNK_SIZE; ++x) {
@@ -109,30 +111,31 @@ void WorldGen::generateChunkAt(ChunkManager& cm, const glm::ivec3& pos) {
 
             for (int y = 0; y < CHUNK_SIZE; ++y) {
                 int worldY = pos.y * CHUNK_SIZE + y;
-                if (worldY == WORLD_MIN_Y) chunk->applyEdit(x, y, z, BlockID::Bedrock);
-                else if (worldY < height - 2) chunk->applyEdit(x, y, z, BlockID::Stone);
-                else if (worldY < height - 1) chunk->applyEdit(x, y, z, BlockID::Dirt);
-                else if (worldY < height) chunk->applyEdit(x, y, z, BlockID::Grass);
-                else chunk->applyEdit(x, y, z, BlockID::Air);
+                BlockID& block = blocks[ServerChunk::blockIndex(x, y, z)];
+                if (worldY == WORLD_MIN_Y) block = BlockID::Bedrock;
+                else if (worldY < height - 2) block = BlockID::Stone;
+                else if (worldY < height - 1) block = BlockID::Dirt;
+                else if (worldY < height) block = BlockID::Grass;
             }
         }
     }
+    chunk->assignBlocks(blocks);
 
     // Reuse the client-style two-pass decoration rules for consistency with the client worldgen.
     applyClientDecorationPass(cm, *chunk, pos);
 
-    {
-        std::lock_guard<std::shared_mutex> lk(cm.mapMutex);
-        cm.chunkMap[pos] = std::move(chunk);
-        cm.chunkMap[pos]->markDirty();
-        cm.decoratedChunks.insert(pos);
-    }
+    chunk->setDecorated(true);
+    chunk->markDirty();
+    cm.insertChunk(pos, std::move(chunk));
 }
 
 void WorldGen::generateTerrainChunkAt(ChunkManager& cm, const glm::ivec3& pos) {
     if (!cm.inBounds(pos)) return;
 
     auto chunk = std::make_unique<ServerChunk>(pos);
+    // Fill locally and hand over in one go so generation does not go through the edit log.
+    std::array<BlockID, CHUNK_VOLUME> blocks;
+    blocks.fill(BlockID::Air);
 
     for (int z = 0; z < CHUNK_SIZE; ++z) {
         for (int x = 0; x < CHUNK_SIZE; ++x) {
@@ -159,38 +162,33 @@ void WorldGen::generateTerrainChunkAt(ChunkManager& cm, const glm::ivec3& pos) {
 
             for (int y = 0; y < CHUNK_SIZE; ++y) {
                 int worldY = pos.y * CHUNK_SIZE + y;
-                if (worldY == WORLD_MIN_Y) chunk->applyEdit(x, y, z, BlockID::Bedrock);
-                else if (worldY < height - 2) chunk->applyEdit(x, y, z, BlockID::Stone);
-                else if (worldY < height - 1) chunk->applyEdit(x, y, z, BlockID::Dirt);
-                else if (worldY < height) chunk->applyEdit(x, y, z, BlockID::Grass);
-                else chunk->applyEdit(x, y, z, BlockID::Air);
+                BlockID& block = blocks[ServerChunk::blockIndex(x, y, z)];
+                if (worldY == WORLD_MIN_Y) block = BlockID::Bedrock;
+                else if (worldY < height - 2) block = BlockID::Stone;
+                else if (worldY < height - 1) block = BlockID::Dirt;
+                else if (worldY < height) block = BlockID::Grass;
             }
         }
     }
+    chunk->assignBlocks(blocks);
 
-    {
-        std::lock_guard<std::shared_mutex> lk(cm.mapMutex);
-        cm.chunkMap[pos] = std::move(chunk);
-        cm.chunkMap[pos]->markDirty();
-        cm.decoratedChunks.erase(pos);
-    }
+    chunk->markDirty();
+    cm.insertChunk(pos, std::move(chunk));
 }
 
 void WorldGen::decorateChunkAt(ChunkManager& cm, const glm::ivec3& pos) {
-    ServerChunk* chunkPtr = nullptr;
-    {
-        std::lock_guard<std::shared_mutex> lk(cm.mapMutex);
-        auto it = cm.chunkMap.find(pos);
-        if (it != cm.chunkMap.end()) {
-            chunkPtr = it->second.get();
-        }
-    }
+    ServerChunk* chunkPtr = cm.getChunkIfExists(pos);
     if (!chunkPtr) return;
 
+    // Several prep workers can stream the same chunk; only the one that claims it decorates, and the
+    // rest wait so they never hand out a half-decorated chunk. The pass only generates terrain-only
+    // neighbours, never decorates them, so the wait cannot cycle.
+    if (!chunkPtr->tryBeginDecoration()) {
+        chunkPtr->waitForDecoration();
+        return;
+    }
     applyClientDecorationPass(cm, *chunkPtr, pos);
-
-    std::lock_guard<std::shared_mutex> lk(cm.mapMutex);
-    cm.decoratedChunks.insert(pos);
+    chunkPtr->finishDecoration();
 }
 
 void WorldGen::placeTree(ChunkManager& cm, ServerChunk& chunk, const glm::ivec3& basePos, std::mt19937& gen) {
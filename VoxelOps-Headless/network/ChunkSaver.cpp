@@ -0,0 +1,143 @@
+#include "ChunkSaver.hpp"
+#include "ChunkStore.hpp"
+
+#include <iostream>
+#include <vector>
+
+namespace {
+constexpr int64_t kSlowFlushWarnUs = 250000;
+}
+
+ChunkSaver::ChunkSaver(ChunkManager& chunkManager, ChunkStore& store, const ChunkSaverConfig& config)
+    : m_chunkManager(chunkManager), m_store(store), m_config(config)
+{
+}
+
+ChunkSaver::~ChunkSaver() {
+    stop();
+    InboxNode* node = m_inbox.exchange(nullptr, std::memory_order_acquire);
+    while (node) {
+        InboxNode* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+void ChunkSaver::start() {
+    std::lock_guard<std::mutex> lk(m_wakeMutex);
+    if (m_running) return;
+    m_stopRequested = false;
+    m_running = true;
+    m_thread = std::thread(&ChunkSaver::workerLoop, this);
+}
+
+void ChunkSaver::stop() {
+    {
+        std::lock_guard<std::mutex> lk(m_wakeMutex);
+        if (!m_running) return;
+        m_stopRequested = true;
+    }
+    m_wakeCv.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    std::lock_guard<std::mutex> lk(m_wakeMutex);
+    m_running = false;
+}
+
+void ChunkSaver::enqueue(const glm::ivec3& chunkPos, int64_t version) {
+    InboxNode* node = new InboxNode{ chunkPos, version, m_inbox.load(std::memory_order_relaxed) };
+    while (!m_inbox.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+void ChunkSaver::workerLoop() {
+    std::unique_lock<std::mutex> lk(m_wakeMutex);
+    while (!m_stopRequested) {
+        m_wakeCv.wait_for(lk, m_config.flushInterval, [this]() { return m_stopRequested; });
+        if (m_stopRequested) break;
+        lk.unlock();
+        flushCycle(false);
+        lk.lock();
+    }
+    lk.unlock();
+
+    // Final pass writes everything regardless of how recently it changed.
+    flushCycle(true);
+}
+
+void ChunkSaver::flushCycle(bool forceAll) {
+    const auto now = std::chrono::steady_clock::now();
+
+    InboxNode* node = m_inbox.exchange(nullptr, std::memory_order_acquire);
+    while (node) {
+        InboxNode* next = node->next;
+        auto [it, inserted] = m_pending.try_emplace(node->chunkPos);
+        if (inserted) {
+            // Observed as of the dirty transition, so a chunk left alone since then is written on
+            // this pass rather than after a second interval.
+            it->second.firstDirtyAt = now;
+            it->second.observedVersion = node->version;
+        }
+        delete node;
+        node = next;
+    }
+    if (m_pending.empty()) return;
+
+    std::vector<ChunkStore::SaveRecord> records;
+    records.reserve(m_pending.size());
+    size_t deferred = 0;
+    for (auto it = m_pending.begin(); it != m_pending.end(); ) {
+        ServerChunk* chunk = m_chunkManager.getChunkIfExists(it->first);
+        if (!chunk) {
+            it = m_pending.erase(it);
+            continue;
+        }
+
+        // Chunks still changing since the last look get another interval to coalesce edits,
+        // bounded by maxDirtyAge so a constantly edited chunk is still written regularly.
+        const int64_t version = chunk->version();
+        const bool settled = (version == it->second.observedVersion);
+        const bool tooOld = (now - it->second.firstDirtyAt) >= m_config.maxDirtyAge;
+        if (!forceAll && !settled && !tooOld) {
+            it->second.observedVersion = version;
+            ++deferred;
+            ++it;
+            continue;
+        }
+
+        ChunkStore::SaveRecord record;
+        if (m_chunkManager.snapshotChunkForSave(it->first, record)) {
+            records.push_back(std::move(record));
+        }
+        it = m_pending.erase(it);
+    }
+    if (records.empty()) return;
+
+    const auto writeStart = std::chrono::steady_clock::now();
+    const size_t saved = m_store.saveChunks(records);
+    const int64_t writeUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - writeStart
+    ).count();
+
+    // Failed chunks go dirty again, which re-queues them for the next cycle.
+    for (const auto& record : records) {
+        if (!record.saved) {
+            m_chunkManager.markChunkDirty(record.chunkPos);
+        }
+    }
+
+    const size_t failed = records.size() - saved;
+    if (forceAll || failed > 0 || writeUs >= kSlowFlushWarnUs) {
+        const uint64_t count = ++m_flushLogCount;
+        if (forceAll || count <= 40 || (count % 200) == 0) {
+            std::cerr
+                << "[world/save] flush saved=" << saved
+                << " failed=" << failed
+                << " deferred=" << deferred
+                << " writeUs=" << writeUs
+                << (forceAll ? " final=1" : "")
+                << " count=" << count << "\n";
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "../graphics/ChunkManager.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+struct ChunkSaverConfig {
+    // How often the saver wakes to write pending chunks.
+    std::chrono::milliseconds flushInterval{ 5000 };
+    // A chunk that keeps changing is deferred between flushes, but never for longer than this.
+    std::chrono::milliseconds maxDirtyAge{ 30000 };
+};
+
+// Write-behind persistence thread. Editing threads hand over chunk positions through a lock-free
+// inbox (one entry per clean->dirty transition, so repeated edits coalesce); the saver snapshots
+// chunk bytes under the chunk's shared lock and writes them per region off the simulation thread.
+class ChunkSaver {
+public:
+    ChunkSaver(ChunkManager& chunkManager, ChunkStore& store, const ChunkSaverConfig& config);
+    ~ChunkSaver();
+
+    ChunkSaver(const ChunkSaver&) = delete;
+    ChunkSaver& operator=(const ChunkSaver&) = delete;
+
+    void start();
+    // Stops the thread after writing everything still pending.
+    void stop();
+
+    // Lock-free; safe from any thread, including while holding chunk or map locks. `version` is the
+    // chunk version when it went dirty.
+    void enqueue(const glm::ivec3& chunkPos, int64_t version);
+
+private:
+    struct InboxNode {
+        glm::ivec3 chunkPos;
+        int64_t version = 0;
+        InboxNode* next = nullptr;
+    };
+
+    struct PendingChunk {
+        std::chrono::steady_clock::time_point firstDirtyAt;
+        int64_t observedVersion = -1;
+    };
+
+    void workerLoop();
+    void flushCycle(bool forceAll);
+
+    ChunkManager& m_chunkManager;
+    ChunkStore& m_store;
+    ChunkSaverConfig m_config;
+
+    std::atomic<InboxNode*> m_inbox{ nullptr };
+    // owned by the worker thread
+    std::unordered_map<glm::ivec3, PendingChunk, IVec3Hash, IVec3Eq> m_pending;
+
+    std::thread m_thread;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCv;
+    bool m_stopRequested = false;
+    bool m_running = false;
+
+    uint64_t m_flushLogCount = 0;
+};
@@ -1,10 +1,8 @@
 #include "ChunkStore.hpp"
-#include <filesystem>
-#include <thread>
-#include <shared_mutex>
-#include <vector>
-#include <chrono>
-#include <sstream>
+#include "CompressChunk.hpp"
+
+#include <iostream>
+#include <system_error>
 
 static inline int64_t makeKey(glm::ivec3 p) {
     // pack 21-bit signed-ish coordinates into 63 bits; keep consistent with your decode logic
@@ -13,136 +11,109 @@ static inline int64_t makeKey(glm::ivec3 p) {
         ((int64_t(p.z) & 0x1FFFFF) << 42);
 }
 
-ChunkStore::ChunkStore(std::string dir, uint64_t seed)
-    : m_worldDir(std::move(dir)), m_seed(seed)
+ChunkStore::ChunkStore(std::filesystem::path worldDir)
+    : m_worldDir(std::move(worldDir))
 {
-    std::filesystem::create_directories(m_worldDir);
+    std::error_code ec;
+    std::filesystem::create_directories(m_worldDir, ec);
+    if (ec) {
+        std::cerr << "[world/store] failed to create " << m_worldDir.string() << ": " << ec.message() << "\n";
+    }
 }
 
-std::shared_ptr<ServerChunk> ChunkStore::tryGet(glm::ivec3 pos) {
-    std::shared_lock lock(m_mutex);
-    auto it = m_chunks.find(makeKey(pos));
-    if (it == m_chunks.end()) return nullptr;
-    return it->second;
+ChunkStore::~ChunkStore() {
+    close();
 }
 
-std::shared_ptr<ServerChunk> ChunkStore::getOrLoad(glm::ivec3 pos) {
-    int64_t k = makeKey(pos);
+std::shared_ptr<RegionFile> ChunkStore::acquireRegion(const glm::ivec3& regionPos, bool createIfMissing) {
+    const int64_t key = makeKey(regionPos);
+    std::lock_guard<std::mutex> lk(m_regionsMutex);
 
-    // first, quick shared lookup
-    {
-        std::shared_lock lock(m_mutex);
-        auto it = m_chunks.find(k);
-        if (it != m_chunks.end()) return it->second;
+    auto it = m_regions.find(key);
+    if (it != m_regions.end() && (it->second || !createIfMissing)) {
+        return it->second;
     }
 
-    // upgrade to exclusive: check again and load/insert
-    {
-        std::unique_lock lock(m_mutex);
-        auto it = m_chunks.find(k);
-        if (it != m_chunks.end()) return it->second;
-
-        // create chunk
-        auto chunk = std::make_shared<ServerChunk>(pos);
+    // Opening reads the whole region in one pass, so later chunk loads in it are memory copies.
+    auto region = std::make_shared<RegionFile>(RegionFile::pathFor(m_worldDir, regionPos));
+    if (!region->open(createIfMissing)) {
+        region.reset();
+    }
+    m_regions[key] = region;
+    return region;
+}
 
-        // attempt to load from disk
-        std::ostringstream ss;
-        ss << m_worldDir << "/chunk_" << pos.x << "_" << pos.y << "_" << pos.z << ".bin";
-        std::string path = ss.str();
+bool ChunkStore::loadChunk(const glm::ivec3& chunkPos, ServerChunk& outChunk, bool& outDecorated) {
+    const auto region = acquireRegion(RegionFile::regionCoordForChunk(chunkPos), false);
+    if (!region) return false;
 
-        if (!chunk->loadFromDisk(path)) {
-            // load failed -> leave chunk as default (all-air). Generation should be done by ChunkManager.
-            // You could optionally call a generator callback here if you want ChunkStore to also generate.
-        }
+    std::vector<uint8_t> payload;
+    uint32_t flags = 0;
+    if (!region->readChunk(RegionFile::localIndexForChunk(chunkPos), payload, flags)) return false;
 
-        m_chunks[k] = chunk;
-        return chunk;
+    std::vector<uint8_t> blob;
+    if (!DecompressChunkPayload((flags & RegionFile::kFlagCompressed) != 0, payload, blob)) {
+        std::cerr << "[world/store] corrupt payload for chunk ("
+            << chunkPos.x << "," << chunkPos.y << "," << chunkPos.z << ")\n";
+        return false;
     }
-}
-
-void ChunkStore::saveDirty() {
-    // Snapshot dirty chunks (avoid holding lock while saving to disk)
-    struct ToSave { std::shared_ptr<ServerChunk> chunk; std::string path; };
-    std::vector<ToSave> work;
-
-    {
-        std::shared_lock lock(m_mutex);
-        work.reserve(m_chunks.size() / 4 + 1);
-        for (const auto& kv : m_chunks) {
-            const auto& chunk = kv.second;
-            if (!chunk) continue;
-            if (chunk->dirty()) {
-                std::ostringstream ss;
-                ss << m_worldDir << "/chunk_" << chunk->position.x << "_" << chunk->position.y << "_" << chunk->position.z << ".bin";
-                work.push_back({ chunk, ss.str() });
-            }
-        }
+    if (!outChunk.deserializeCompressed(blob) || outChunk.position != chunkPos) {
+        std::cerr << "[world/store] rejected payload for chunk ("
+            << chunkPos.x << "," << chunkPos.y << "," << chunkPos.z << ")\n";
+        return false;
     }
 
-    // Perform I/O outside the lock
-    for (auto& item : work) {
-        // attempt save; ignore failures for now (could log)
-        if (item.chunk->saveToDisk(item.path)) {
-            // clear dirty flag (atomic)
-            item.chunk->clearDirty();
-        }
-        else {
-            // optional: log failure
-            // std::cerr << "Failed to save chunk " << item.path << "\n";
-        }
-    }
+    outDecorated = (flags & RegionFile::kFlagDecorated) != 0;
+    return true;
 }
 
-void ChunkStore::unloadUnused(std::chrono::seconds maxIdle) {
-    const auto now = std::chrono::steady_clock::now();
-
-    // Move expired chunks out of map under lock so we can save them without holding the lock
-    std::vector<std::shared_ptr<ServerChunk>> toSaveAndDestroy;
-    toSaveAndDestroy.reserve(64);
-
-    {
-        std::unique_lock lock(m_mutex);
-        for (auto it = m_chunks.begin(); it != m_chunks.end(); ) {
-            const auto& chunk = it->second;
-            if (!chunk) {
-                it = m_chunks.erase(it);
-                continue;
-            }
-            auto lastAccess = chunk->getLastAccess();
-            auto age = now - lastAccess;
-            if (age > maxIdle) {
-                toSaveAndDestroy.push_back(chunk);
-                it = m_chunks.erase(it);
-            }
-            else {
-                ++it;
-            }
-        }
+size_t ChunkStore::saveChunks(std::vector<SaveRecord>& records) {
+    struct RegionBatch {
+        glm::ivec3 regionPos{ 0 };
+        std::vector<RegionFile::ChunkWrite> writes;
+        std::vector<size_t> recordIndices;
+    };
+    std::unordered_map<int64_t, RegionBatch> batches;
+
+    for (size_t i = 0; i < records.size(); ++i) {
+        SaveRecord& record = records[i];
+        record.saved = false;
+        if (record.blob.empty()) continue;
+
+        const glm::ivec3 regionPos = RegionFile::regionCoordForChunk(record.chunkPos);
+        RegionBatch& batch = batches[makeKey(regionPos)];
+        batch.regionPos = regionPos;
+
+        CompressedChunkPayload compressed = CompressChunkPayload(record.blob);
+        RegionFile::ChunkWrite write;
+        write.localIndex = RegionFile::localIndexForChunk(record.chunkPos);
+        write.flags = (compressed.compressed ? RegionFile::kFlagCompressed : 0u) |
+            (record.decorated ? RegionFile::kFlagDecorated : 0u);
+        write.payload = std::move(compressed.payload);
+        batch.writes.push_back(std::move(write));
+        batch.recordIndices.push_back(i);
     }
 
-    // Save and destroy outside the lock
-    for (auto& chunk : toSaveAndDestroy) {
-        std::ostringstream ss;
-        ss << m_worldDir << "/chunk_" << chunk->position.x << "_" << chunk->position.y << "_" << chunk->position.z << ".bin";
-        std::string path = ss.str();
-
-        // best-effort save
-        if (chunk->saveToDisk(path)) {
-            chunk->clearDirty();
+    size_t savedCount = 0;
+    for (auto& [key, batch] : batches) {
+        const auto region = acquireRegion(batch.regionPos, true);
+        if (!region || !region->writeChunks(batch.writes)) {
+            std::cerr << "[world/store] failed to save " << batch.writes.size() << " chunk(s) in region ("
+                << batch.regionPos.x << "," << batch.regionPos.y << "," << batch.regionPos.z << ")\n";
+            continue;
         }
-        else {
-            // optional: log error
-            // std::cerr << "Failed to save chunk on unload: " << path << "\n";
+        for (size_t index : batch.recordIndices) {
+            records[index].saved = true;
         }
-        // shared_ptr goes out of scope and will free the chunk if no other refs
+        savedCount += batch.recordIndices.size();
     }
+    return savedCount;
 }
 
-
-void ChunkStore::forEachChunk(std::function<void(std::shared_ptr<ServerChunk>&)> fn) {
-    std::shared_lock lock(m_mutex);
-    for (auto& [key, chunk] : m_chunks) {
-        fn(chunk);
+void ChunkStore::close() {
+    std::lock_guard<std::mutex> lk(m_regionsMutex);
+    for (auto& [key, region] : m_regions) {
+        if (region) region->close();
     }
+    m_regions.clear();
 }
-
@@ -1,24 +1,47 @@
 #pragma once
 #include "../voxels/ServerChunk.hpp"
-#include <functional>
-#include <shared_mutex>
+#include "RegionFile.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Region-backed chunk persistence. Chunks are grouped into RegionFile instances
+// (REGION_SIZE^3 chunks per file); each stored payload is an LZ4-compressed
+// ServerChunk::serializeCompressed() blob.
 class ChunkStore {
 public:
-    ChunkStore(std::string worldDir, uint64_t seed);
+    struct SaveRecord {
+        glm::ivec3 chunkPos{ 0 };
+        std::vector<uint8_t> blob; // ServerChunk::serializeCompressed() output
+        bool decorated = false;
+        bool saved = false;        // filled in by saveChunks
+    };
+
+    explicit ChunkStore(std::filesystem::path worldDir);
+    ~ChunkStore();
+
+    ChunkStore(const ChunkStore&) = delete;
+    ChunkStore& operator=(const ChunkStore&) = delete;
+
+    // Returns false when the chunk was never stored (or its payload is unreadable).
+    bool loadChunk(const glm::ivec3& chunkPos, ServerChunk& outChunk, bool& outDecorated);
 
-    std::shared_ptr<ServerChunk> getOrLoad(glm::ivec3 chunkPos);
-    std::shared_ptr<ServerChunk> tryGet(glm::ivec3 chunkPos);
+    // Groups records by region and commits each region with a single header update.
+    // Returns the number of records that were written.
+    size_t saveChunks(std::vector<SaveRecord>& records);
 
-    void saveDirty();
-    void unloadUnused(std::chrono::seconds maxIdle);
+    void close();
 
-    void forEachChunk(std::function<void(std::shared_ptr<ServerChunk>&)> fn);
+    const std::filesystem::path& worldDir() const noexcept { return m_worldDir; }
 
 private:
-    std::unordered_map<int64_t, std::shared_ptr<ServerChunk>> m_chunks;
-    mutable std::shared_mutex m_mutex;
-    std::string m_worldDir;
-    uint64_t m_seed;
+    std::shared_ptr<RegionFile> acquireRegion(const glm::ivec3& regionPos, bool createIfMissing);
 
-    static int64_t key(glm::ivec3 p); // for unordered_map key
+    std::filesystem::path m_worldDir;
+    std::mutex m_regionsMutex;
+    // nullptr value => region file known not to exist yet
+    std::unordered_map<int64_t, std::shared_ptr<RegionFile>> m_regions;
 };
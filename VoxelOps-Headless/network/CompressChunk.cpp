@@ -16,6 +16,18 @@ inline void WriteU32LE(std::vector<uint8_t>& dst, uint32_t value)
     dst.push_back(static_cast<uint8_t>((value >> 16) & 0xFFu));
     dst.push_back(static_cast<uint8_t>((value >> 24) & 0xFFu));
 }
+
+inline bool ReadU32LE(const std::vector<uint8_t>& src, size_t offset, uint32_t& outValue)
+{
+    if (offset + sizeof(uint32_t) > src.size()) {
+        return false;
+    }
+    outValue = static_cast<uint32_t>(src[offset]) |
+        (static_cast<uint32_t>(src[offset + 1]) << 8) |
+        (static_cast<uint32_t>(src[offset + 2]) << 16) |
+        (static_cast<uint32_t>(src[offset + 3]) << 24);
+    return true;
+}
 }
 
 CompressedChunkPayload CompressChunkPayload(const std::vector<uint8_t>& rawPayload)
@@ -67,3 +79,37 @@ CompressedChunkPayload CompressChunkPayload(const std::vector<uint8_t>& rawPaylo
     result.compressed = true;
     return result;
 }
+
+bool DecompressChunkPayload(bool compressed, const std::vector<uint8_t>& payload, std::vector<uint8_t>& outRawPayload)
+{
+    if (!compressed) {
+        outRawPayload = payload;
+        return true;
+    }
+
+    uint32_t rawSize = 0;
+    if (!ReadU32LE(payload, 0, rawSize)) {
+        return false;
+    }
+    if (rawSize > static_cast<uint32_t>(std::numeric_limits<int>::max())) {
+        return false;
+    }
+
+    const size_t compressedSize = payload.size() - sizeof(uint32_t);
+    if (compressedSize > static_cast<size_t>(std::numeric_limits<int>::max())) {
+        return false;
+    }
+
+    outRawPayload.resize(static_cast<size_t>(rawSize));
+    if (rawSize == 0) {
+        return compressedSize == 0;
+    }
+
+    const int decoded = LZ4_decompress_safe(
+        reinterpret_cast<const char*>(payload.data() + sizeof(uint32_t)),
+        reinterpret_cast<char*>(outRawPayload.data()),
+        static_cast<int>(compressedSize),
+        static_cast<int>(rawSize)
+    );
+    return decoded == static_cast<int>(rawSize);
+}
@@ -12,3 +12,7 @@ struct CompressedChunkPayload {
 // When compressed == true, payload layout is:
 //   [rawSize:u32 little-endian][lz4 block bytes]
 CompressedChunkPayload CompressChunkPayload(const std::vector<uint8_t>& rawPayload);
+
+// Inverse of CompressChunkPayload for payloads read back from disk.
+// When compressed == false, output is the payload as-is.
+bool DecompressChunkPayload(bool compressed, const std::vector<uint8_t>& payload, std::vector<uint8_t>& outRawPayload);
@@ -0,0 +1,37 @@
+#include "InboundCommands.hpp"
+
+std::shared_ptr<InboundCommandQueues::Ring> InboundCommandQueues::acquire(HSteamNetConnection conn) {
+    std::lock_guard<std::mutex> lk(mutex);
+    std::shared_ptr<Ring>& ring = rings[conn];
+    if (!ring) {
+        ring = std::make_shared<Ring>();
+    }
+    return ring;
+}
+
+void InboundCommandQueues::list(RingList& out) const {
+    out.clear();
+    std::lock_guard<std::mutex> lk(mutex);
+    out.reserve(rings.size());
+    for (const auto& [conn, ring] : rings) {
+        out.emplace_back(conn, ring);
+    }
+}
+
+void InboundCommandQueues::remove(HSteamNetConnection conn) {
+    std::lock_guard<std::mutex> lk(mutex);
+    auto it = rings.find(conn);
+    if (it == rings.end()) {
+        return;
+    }
+    it->second->retired.store(true, std::memory_order_release);
+    rings.erase(it);
+}
+
+void InboundCommandQueues::clear() {
+    std::lock_guard<std::mutex> lk(mutex);
+    for (auto& [_, ring] : rings) {
+        ring->retired.store(true, std::memory_order_release);
+    }
+    rings.clear();
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <GameNetworkingSockets/steam/steamnetworkingtypes.h>
+
+#include "../../Shared/network/PacketType.hpp"
+#include "../../Shared/network/Packets.hpp"
+
+// Bounded single-producer/single-consumer queue. push() and pop() never block or allocate; each
+// side owns one index and publishes it with release/acquire.
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    // Producer side. Returns false (leaving `value` untouched) when full.
+    bool push(T& value) {
+        const size_t tail = writeIndex.load(std::memory_order_relaxed);
+        if (tail - readIndex.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots[tail & (Capacity - 1)] = std::move(value);
+        writeIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side.
+    bool pop(T& out) {
+        const size_t head = readIndex.load(std::memory_order_relaxed);
+        if (head == writeIndex.load(std::memory_order_acquire)) {
+            return false;
+        }
+        out = std::move(slots[head & (Capacity - 1)]);
+        readIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: whether pop() would find nothing right now.
+    bool empty() const {
+        return readIndex.load(std::memory_order_relaxed) == writeIndex.load(std::memory_order_acquire);
+    }
+
+private:
+    std::array<T, Capacity> slots{};
+    alignas(64) std::atomic<size_t> writeIndex{ 0 };
+    alignas(64) std::atomic<size_t> readIndex{ 0 };
+};
+
+// One inbound packet that passed size and rate checks, parsed on the network I/O thread.
+// ConnectRequest, BlockPlaceRequest and BlockBreakRequest are still delivered when malformed
+// (payload left as monostate) because their handlers answer with a rejection.
+struct InboundCommand {
+    PacketType type = PacketType::Message;
+    std::variant<
+        std::monostate,
+        ConnectRequest,
+        std::string, // PacketType::Message text
+        PlayerInput,
+        ChunkRequest,
+        BlockPlaceRequest,
+        BlockBreakRequest,
+        ShootRequest,
+        InventoryActionRequest
+    > payload;
+};
+
+// Per-connection command rings between the I/O thread (producer) and the simulation thread
+// (consumer). The map itself is only locked to add, list or drop a ring; pushing and popping
+// go straight to the ring.
+class InboundCommandQueues {
+public:
+    static constexpr size_t kRingCapacity = 256;
+
+    struct Ring {
+        SpscRing<InboundCommand, kRingCapacity> commands;
+        std::atomic<bool> retired{ false }; // set by remove(); the producer drops its reference
+    };
+    using RingList = std::vector<std::pair<HSteamNetConnection, std::shared_ptr<Ring>>>;
+
+    // I/O thread: the ring for `conn`, created on first use.
+    std::shared_ptr<Ring> acquire(HSteamNetConnection conn);
+
+    // Simulation thread.
+    void list(RingList& out) const;
+    void remove(HSteamNetConnection conn);
+    void clear();
+
+private:
+    mutable std::mutex mutex;
+    std::unordered_map<HSteamNetConnection, std::shared_ptr<Ring>> rings;
+};
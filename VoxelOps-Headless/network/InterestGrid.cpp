@@ -0,0 +1,77 @@
+#include "InterestGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+InterestGrid::InterestGrid(float cellSize)
+    : inverseCellSize(1.0f / cellSize) {}
+
+void InterestGrid::clear() {
+    entries.clear();
+    cells.clear();
+}
+
+int32_t InterestGrid::cellCoord(float value) const noexcept {
+    return static_cast<int32_t>(std::floor(value * inverseCellSize));
+}
+
+uint64_t InterestGrid::cellKey(int32_t cx, int32_t cz) noexcept {
+    // Flipping the sign bits keeps keys in (cx, cz) order, so one row of cells is one key range.
+    const uint64_t x = static_cast<uint32_t>(cx) ^ 0x80000000u;
+    const uint64_t z = static_cast<uint32_t>(cz) ^ 0x80000000u;
+    return (x << 32) | z;
+}
+
+void InterestGrid::insert(uint32_t index, const glm::vec3& position) {
+    Entry entry;
+    entry.cell = cellKey(cellCoord(position.x), cellCoord(position.z));
+    entry.index = index;
+    entry.position = position;
+    entries.push_back(entry);
+}
+
+void InterestGrid::build() {
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return (a.cell != b.cell) ? (a.cell < b.cell) : (a.index < b.index);
+    });
+
+    cells.clear();
+    for (uint32_t i = 0; i < static_cast<uint32_t>(entries.size()); ++i) {
+        if (cells.empty() || cells.back().key != entries[i].cell) {
+            cells.push_back(Cell{ entries[i].cell, i, i });
+        }
+        cells.back().end = i + 1;
+    }
+}
+
+void InterestGrid::query(const glm::vec3& center, float radius, std::vector<Hit>& out) const {
+    if (cells.empty() || !(radius >= 0.0f)) {
+        return;
+    }
+
+    const float radiusSq = radius * radius;
+    const int32_t minX = cellCoord(center.x - radius);
+    const int32_t maxX = cellCoord(center.x + radius);
+    const int32_t minZ = cellCoord(center.z - radius);
+    const int32_t maxZ = cellCoord(center.z + radius);
+
+    for (int32_t cx = minX; cx <= maxX; ++cx) {
+        const uint64_t rowEnd = cellKey(cx, maxZ);
+        auto cell = std::lower_bound(
+            cells.begin(),
+            cells.end(),
+            cellKey(cx, minZ),
+            [](const Cell& c, uint64_t key) { return c.key < key; }
+        );
+        for (; cell != cells.end() && cell->key <= rowEnd; ++cell) {
+            for (uint32_t i = cell->begin; i < cell->end; ++i) {
+                const Entry& entry = entries[i];
+                const glm::vec3 delta = entry.position - center;
+                const float distanceSq = delta.x * delta.x + delta.y * delta.y + delta.z * delta.z;
+                if (distanceSq <= radiusSq) {
+                    out.push_back(Hit{ entry.index, distanceSq });
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+#include <cstdint>
+#include <vector>
+
+// Uniform grid over the XZ plane for "what is near this point" queries during replication.
+// Rebuilt from scratch each time it is used: clear(), insert() everything, build(), then query.
+// Storage is kept between rebuilds, so a steady population does not allocate.
+class InterestGrid {
+public:
+    struct Hit {
+        uint32_t index = 0;      // as passed to insert()
+        float distanceSq = 0.0f; // full 3D distance to the query center
+    };
+
+    explicit InterestGrid(float cellSize);
+
+    void clear();
+    void insert(uint32_t index, const glm::vec3& position);
+    // Sorts the inserted entries into cells. Must be called before query().
+    void build();
+
+    // Appends every entry within `radius` of `center` to `out`, in no particular order. Cost is
+    // proportional to the cells the radius covers and the entries in them, not to the total count.
+    void query(const glm::vec3& center, float radius, std::vector<Hit>& out) const;
+
+    size_t size() const noexcept { return entries.size(); }
+
+private:
+    struct Entry {
+        uint64_t cell = 0;
+        uint32_t index = 0;
+        glm::vec3 position{ 0.0f };
+    };
+    struct Cell {
+        uint64_t key = 0;
+        uint32_t begin = 0;
+        uint32_t end = 0;
+    };
+
+    int32_t cellCoord(float value) const noexcept;
+    static uint64_t cellKey(int32_t cx, int32_t cz) noexcept;
+
+    float inverseCellSize;
+    std::vector<Entry> entries; // sorted by cell after build()
+    std::vector<Cell> cells;    // sorted by key
+};
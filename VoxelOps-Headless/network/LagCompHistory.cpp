@@ -0,0 +1,123 @@
+#include "LagCompHistory.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Degrees; blends across the +/-180 seam along the short way round.
+float LerpYawDegrees(float from, float to, float t)
+{
+    float delta = std::fmod(to - from, 360.0f);
+    if (delta > 180.0f) delta -= 360.0f;
+    if (delta < -180.0f) delta += 360.0f;
+    return from + delta * t;
+}
+
+bool FindPose(const std::vector<PlayerID>& ids, const std::vector<LagCompHistory::Pose>& poses, PlayerID id, LagCompHistory::Pose& out)
+{
+    const auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    if (it == ids.end() || *it != id) {
+        return false;
+    }
+    out = poses[static_cast<size_t>(it - ids.begin())];
+    return true;
+}
+}
+
+void LagCompHistory::configure(uint32_t maxRewindTicks, size_t expectedPlayers)
+{
+    // One extra frame so targetTick + 1 is still around when blending at the oldest allowed tick.
+    frames.assign(static_cast<size_t>(maxRewindTicks) + 2u, Frame{});
+    for (Frame& frame : frames) {
+        frame.ids.reserve(expectedPlayers);
+        frame.poses.reserve(expectedPlayers);
+    }
+}
+
+void LagCompHistory::clear()
+{
+    for (Frame& frame : frames) {
+        frame.recorded = false;
+        frame.ids.clear();
+        frame.poses.clear();
+    }
+}
+
+void LagCompHistory::record(uint32_t serverTick, const PlayerKinematicsBuffer::View& players)
+{
+    if (frames.empty()) {
+        return;
+    }
+    Frame& frame = frames[serverTick % frames.size()];
+    frame.serverTick = serverTick;
+    frame.recorded = true;
+    frame.ids.clear();
+    frame.poses.clear();
+    for (const PlayerKinematics& player : players) {
+        if (!player.isAlive) {
+            continue;
+        }
+        Pose pose{};
+        pose.position = player.position;
+        pose.yaw = player.yaw;
+        pose.height = player.height;
+        pose.radius = player.radius;
+        frame.ids.push_back(player.id);
+        frame.poses.push_back(pose);
+    }
+}
+
+const LagCompHistory::Frame* LagCompHistory::frameAt(uint32_t serverTick) const
+{
+    if (frames.empty()) {
+        return nullptr;
+    }
+    const Frame& frame = frames[serverTick % frames.size()];
+    return (frame.recorded && frame.serverTick == serverTick) ? &frame : nullptr;
+}
+
+LagCompHistory::Rewind LagCompHistory::rewind(uint32_t targetTick, uint8_t fraction) const
+{
+    Rewind result;
+    result.older = frameAt(targetTick);
+    if (result.older == nullptr) {
+        return result;
+    }
+    if (fraction != 0) {
+        result.newer = frameAt(targetTick + 1u);
+        if (result.newer != nullptr) {
+            result.alpha = static_cast<float>(fraction) / 256.0f;
+        }
+    }
+    return result;
+}
+
+bool LagCompHistory::Rewind::pose(PlayerID id, Pose& out) const
+{
+    if (older == nullptr) {
+        return false;
+    }
+    // The older frame decides presence. A player missing from it (dead, or not yet joined) was not
+    // in the world the shooter saw, even if the newer frame has them: borrowing that pose would let
+    // a shot land on someone who spawned after it. One missing only from the newer frame died or
+    // left during the blend and holds their older pose.
+    Pose from{};
+    if (!FindPose(older->ids, older->poses, id, from)) {
+        return false;
+    }
+    Pose to{};
+    if (newer == nullptr || !FindPose(newer->ids, newer->poses, id, to)) {
+        out = from;
+        return true;
+    }
+    out.position = from.position + (to.position - from.position) * alpha;
+    out.yaw = LerpYawDegrees(from.yaw, to.yaw, alpha);
+    out.height = from.height + (to.height - from.height) * alpha;
+    out.radius = from.radius + (to.radius - from.radius) * alpha;
+    return true;
+}
+
+int64_t LagCompHistory::Rewind::baseTick() const noexcept
+{
+    return (older != nullptr) ? static_cast<int64_t>(older->serverTick) : -1;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec3.hpp>
+
+#include "../player/PlayerKinematics.hpp"
+
+// Recent per-tick player poses for shot rewind. Frames live in a preallocated ring indexed by
+// serverTick % capacity; each frame keeps dense id/pose arrays in the kinematics row order
+// (ascending id), so recording copies without allocating and a lookup is a binary search.
+// Simulation thread only.
+class LagCompHistory {
+    struct Frame;
+
+public:
+    struct Pose {
+        glm::vec3 position{ 0.0f };
+        float yaw = 0.0f;
+        float height = 2.56f;
+        float radius = 0.3f;
+    };
+
+    // Poses at one (possibly fractional) tick, blended from the two frames around it.
+    class Rewind {
+    public:
+        bool valid() const noexcept { return older != nullptr; }
+        // Rewound pose of `id`; false when the player is missing from the older frame (dead or not
+        // yet joined at the rewound tick), in which case they were absent and cannot be hit.
+        bool pose(PlayerID id, Pose& out) const;
+        // Integer tick of the older frame, or -1 when invalid (diagnostics).
+        int64_t baseTick() const noexcept;
+
+    private:
+        friend class LagCompHistory;
+        const Frame* older = nullptr;
+        const Frame* newer = nullptr;
+        float alpha = 0.0f;
+    };
+
+    // Keeps at least `maxRewindTicks` ticks behind the newest one. Drops recorded history.
+    void configure(uint32_t maxRewindTicks, size_t expectedPlayers);
+    void clear();
+
+    void record(uint32_t serverTick, const PlayerKinematicsBuffer::View& players);
+
+    // Poses at targetTick + fraction/256. Falls back to the nearest recorded frame when the
+    // neighbour needed for blending is missing; invalid when targetTick itself is gone.
+    Rewind rewind(uint32_t targetTick, uint8_t fraction) const;
+
+private:
+    struct Frame {
+        uint32_t serverTick = 0;
+        bool recorded = false;
+        std::vector<PlayerID> ids;
+        std::vector<Pose> poses;
+    };
+
+    const Frame* frameAt(uint32_t serverTick) const;
+
+    std::vector<Frame> frames;
+};
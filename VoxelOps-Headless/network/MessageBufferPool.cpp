@@ -0,0 +1,58 @@
+#include "MessageBufferPool.hpp"
+
+namespace {
+// Leases beyond this are freed rather than kept; bounds what a one-off burst leaves behind.
+constexpr size_t kMaxPooledLeases = 1024;
+}
+
+MessageBufferPool::MessageBufferPool()
+    : freeList(std::make_shared<FreeList>()) {}
+
+SteamNetworkingMessage_t* MessageBufferPool::wrap(
+    HSteamNetConnection conn,
+    int sendFlags,
+    std::vector<uint8_t>& inOutBytes
+) {
+    SteamNetworkingMessage_t* message = SteamNetworkingUtils()->AllocateMessage(0);
+    if (!message) {
+        return nullptr;
+    }
+
+    std::unique_ptr<Lease> lease;
+    {
+        std::lock_guard<std::mutex> lk(freeList->mutex);
+        if (!freeList->leases.empty()) {
+            lease = std::move(freeList->leases.back());
+            freeList->leases.pop_back();
+        }
+    }
+    if (!lease) {
+        lease = std::make_unique<Lease>();
+        lease->owner = freeList;
+    }
+    lease->bytes.swap(inOutBytes);
+
+    message->m_conn = conn;
+    message->m_nFlags = sendFlags;
+    message->m_pData = lease->bytes.data();
+    message->m_cbSize = static_cast<int>(lease->bytes.size());
+    message->m_nUserData = static_cast<int64_t>(reinterpret_cast<intptr_t>(lease.release()));
+    message->m_pfnFreeData = &MessageBufferPool::ReleaseMessageData;
+    return message;
+}
+
+void MessageBufferPool::ReleaseMessageData(SteamNetworkingMessage_t* message) {
+    std::unique_ptr<Lease> lease(reinterpret_cast<Lease*>(static_cast<intptr_t>(message->m_nUserData)));
+    if (!lease) {
+        return;
+    }
+    const std::shared_ptr<FreeList> owner = lease->owner.lock();
+    if (!owner) {
+        return;
+    }
+    lease->bytes.clear();
+    std::lock_guard<std::mutex> lk(owner->mutex);
+    if (owner->leases.size() < kMaxPooledLeases) {
+        owner->leases.push_back(std::move(lease));
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <GameNetworkingSockets/steam/steamnetworkingsockets.h>
+#include <GameNetworkingSockets/steam/steamnetworkingtypes.h>
+
+// Recycled byte buffers for outgoing messages. A buffer is lent to a SteamNetworkingMessage_t and
+// returns to the pool from the message's free callback, which may run on a GNS thread. Buffers keep
+// their capacity, so a steady stream of similar messages stops allocating after warm-up.
+class MessageBufferPool {
+public:
+    MessageBufferPool();
+
+    // Wraps the bytes in `inOutBytes` in a message for SendMessages. The vector is swapped with a
+    // recycled buffer: on return it is empty but has capacity for the next encode. Returns nullptr
+    // (leaving `inOutBytes` untouched) if GNS cannot allocate a message.
+    SteamNetworkingMessage_t* wrap(HSteamNetConnection conn, int sendFlags, std::vector<uint8_t>& inOutBytes);
+
+private:
+    struct FreeList;
+    struct Lease {
+        std::weak_ptr<FreeList> owner;
+        std::vector<uint8_t> bytes;
+    };
+    // Pooled leases point back here weakly: a strong owner would keep the list alive through its
+    // own leases. Messages still in flight when the pool goes free their buffer on release instead.
+    struct FreeList {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Lease>> leases;
+    };
+
+    static void ReleaseMessageData(SteamNetworkingMessage_t* message);
+
+    std::shared_ptr<FreeList> freeList;
+};
@@ -0,0 +1,481 @@
+#include "RegionFile.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <system_error>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr uint32_t kSectorBytes = 512;
+constexpr uint32_t kRegionMagic = 0x47524F56u; // "VORG"
+constexpr uint32_t kRegionFormatVersion = 1;
+constexpr size_t kEntryBytes = 16;
+constexpr size_t kHeaderEntriesOffset = 4 + 4 + 8;
+constexpr size_t kHeaderChecksumOffset = kHeaderEntriesOffset + REGION_CHUNK_COUNT * kEntryBytes;
+constexpr uint32_t kHeaderSlotSectors = static_cast<uint32_t>((kHeaderChecksumOffset + 4 + kSectorBytes - 1) / kSectorBytes);
+constexpr size_t kHeaderSlotBytes = static_cast<size_t>(kHeaderSlotSectors) * kSectorBytes;
+constexpr uint32_t kFirstDataSector = kHeaderSlotSectors * 2;
+// Only compact once at least this much is dead and dead sectors outnumber live ones.
+constexpr uint32_t kCompactMinDeadSectors = 256;
+
+inline int FloorDiv(int a, int b)
+{
+    int q = a / b;
+    int r = a % b;
+    if ((r != 0) && ((r > 0) != (b > 0))) q--;
+    return q;
+}
+
+inline uint32_t SectorsFor(size_t byteLength)
+{
+    return static_cast<uint32_t>((byteLength + kSectorBytes - 1) / kSectorBytes);
+}
+
+inline void PutU32LE(uint8_t* dst, uint32_t value)
+{
+    dst[0] = static_cast<uint8_t>(value & 0xFFu);
+    dst[1] = static_cast<uint8_t>((value >> 8) & 0xFFu);
+    dst[2] = static_cast<uint8_t>((value >> 16) & 0xFFu);
+    dst[3] = static_cast<uint8_t>((value >> 24) & 0xFFu);
+}
+
+inline uint32_t GetU32LE(const uint8_t* src)
+{
+    return static_cast<uint32_t>(src[0]) |
+        (static_cast<uint32_t>(src[1]) << 8) |
+        (static_cast<uint32_t>(src[2]) << 16) |
+        (static_cast<uint32_t>(src[3]) << 24);
+}
+
+uint32_t Fnv1a32(const uint8_t* data, size_t size)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool FlushToDisk(std::FILE* file)
+{
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+#if defined(_WIN32)
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+bool WritePadded(std::FILE* file, const std::vector<uint8_t>& payload)
+{
+    static const std::array<uint8_t, kSectorBytes> kZeroSector{};
+    if (!payload.empty() && std::fwrite(payload.data(), 1, payload.size(), file) != payload.size()) {
+        return false;
+    }
+    const size_t padding = static_cast<size_t>(SectorsFor(payload.size())) * kSectorBytes - payload.size();
+    return padding == 0 || std::fwrite(kZeroSector.data(), 1, padding, file) == padding;
+}
+}
+
+RegionFile::RegionFile(std::filesystem::path path)
+    : m_path(std::move(path))
+{
+}
+
+RegionFile::~RegionFile() {
+    close();
+}
+
+glm::ivec3 RegionFile::regionCoordForChunk(const glm::ivec3& chunkPos) {
+    return glm::ivec3(
+        FloorDiv(chunkPos.x, REGION_SIZE),
+        FloorDiv(chunkPos.y, REGION_SIZE),
+        FloorDiv(chunkPos.z, REGION_SIZE)
+    );
+}
+
+int RegionFile::localIndexForChunk(const glm::ivec3& chunkPos) {
+    const glm::ivec3 local = chunkPos - regionCoordForChunk(chunkPos) * REGION_SIZE;
+    return local.x + REGION_SIZE * (local.y + REGION_SIZE * local.z);
+}
+
+std::filesystem::path RegionFile::pathFor(const std::filesystem::path& worldDir, const glm::ivec3& regionPos) {
+    return worldDir / ("r." + std::to_string(regionPos.x) + "." + std::to_string(regionPos.y) + "." +
+        std::to_string(regionPos.z) + ".vrg");
+}
+
+void RegionFile::encodeHeaderSlot(uint64_t sequence, const EntryTable& entries, std::vector<uint8_t>& out) {
+    out.assign(kHeaderSlotBytes, 0);
+    PutU32LE(out.data() + 0, kRegionMagic);
+    PutU32LE(out.data() + 4, kRegionFormatVersion);
+    PutU32LE(out.data() + 8, static_cast<uint32_t>(sequence & 0xFFFFFFFFu));
+    PutU32LE(out.data() + 12, static_cast<uint32_t>(sequence >> 32));
+    for (size_t i = 0; i < entries.size(); ++i) {
+        uint8_t* dst = out.data() + kHeaderEntriesOffset + i * kEntryBytes;
+        PutU32LE(dst + 0, entries[i].sectorOffset);
+        PutU32LE(dst + 4, entries[i].byteLength);
+        PutU32LE(dst + 8, entries[i].checksum);
+        PutU32LE(dst + 12, entries[i].flags);
+    }
+    PutU32LE(out.data() + kHeaderChecksumOffset, Fnv1a32(out.data(), kHeaderChecksumOffset));
+}
+
+bool RegionFile::decodeHeaderSlot(const uint8_t* data, uint64_t& outSequence, EntryTable& outEntries) {
+    if (GetU32LE(data + 0) != kRegionMagic || GetU32LE(data + 4) != kRegionFormatVersion) {
+        return false;
+    }
+    if (GetU32LE(data + kHeaderChecksumOffset) != Fnv1a32(data, kHeaderChecksumOffset)) {
+        return false;
+    }
+    outSequence = static_cast<uint64_t>(GetU32LE(data + 8)) | (static_cast<uint64_t>(GetU32LE(data + 12)) << 32);
+    for (size_t i = 0; i < outEntries.size(); ++i) {
+        const uint8_t* src = data + kHeaderEntriesOffset + i * kEntryBytes;
+        outEntries[i].sectorOffset = GetU32LE(src + 0);
+        outEntries[i].byteLength = GetU32LE(src + 4);
+        outEntries[i].checksum = GetU32LE(src + 8);
+        outEntries[i].flags = GetU32LE(src + 12);
+    }
+    return true;
+}
+
+bool RegionFile::open(bool createIfMissing) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (m_file) return true;
+
+    std::error_code ec;
+    // A leftover temp file means a compaction died before its rename; the original is still authoritative.
+    std::filesystem::path tmpPath = m_path;
+    tmpPath += ".tmp";
+    std::filesystem::remove(tmpPath, ec);
+
+    if (!std::filesystem::exists(m_path, ec)) {
+        if (!createIfMissing) return false;
+        std::filesystem::create_directories(m_path.parent_path(), ec);
+        m_file = std::fopen(m_path.string().c_str(), "w+b");
+        if (!m_file) {
+            std::cerr << "[world/region] failed to create " << m_path.string() << "\n";
+            return false;
+        }
+        return initializeEmptyLocked();
+    }
+
+    m_file = std::fopen(m_path.string().c_str(), "r+b");
+    if (!m_file) {
+        std::cerr << "[world/region] failed to open " << m_path.string() << "\n";
+        return false;
+    }
+
+    // One sequential read for the whole region; chunk loads are then served from memory.
+    std::fseek(m_file, 0, SEEK_END);
+    const long fileSize = std::ftell(m_file);
+    std::fseek(m_file, 0, SEEK_SET);
+    if (fileSize < 0) {
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+    m_warmBytes.resize(static_cast<size_t>(fileSize));
+    if (!m_warmBytes.empty() && std::fread(m_warmBytes.data(), 1, m_warmBytes.size(), m_file) != m_warmBytes.size()) {
+        std::cerr << "[world/region] short read on " << m_path.string() << "\n";
+        releaseWarmBytesLocked();
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+
+    int bestSlot = -1;
+    uint64_t bestSequence = 0;
+    EntryTable bestEntries{};
+    for (int slot = 0; slot < 2; ++slot) {
+        const size_t slotOffset = static_cast<size_t>(slot) * kHeaderSlotBytes;
+        if (m_warmBytes.size() < slotOffset + kHeaderSlotBytes) break;
+        uint64_t sequence = 0;
+        EntryTable entries{};
+        if (!decodeHeaderSlot(m_warmBytes.data() + slotOffset, sequence, entries)) continue;
+        if (bestSlot < 0 || sequence > bestSequence) {
+            bestSlot = slot;
+            bestSequence = sequence;
+            bestEntries = entries;
+        }
+    }
+
+    if (bestSlot < 0) {
+        // No data can exist past the header area without a committed header pointing at it,
+        // so a short file is an interrupted create. Anything larger is left alone.
+        if (m_warmBytes.size() <= static_cast<size_t>(kFirstDataSector) * kSectorBytes) {
+            releaseWarmBytesLocked();
+            return initializeEmptyLocked();
+        }
+        std::cerr << "[world/region] no valid header in " << m_path.string() << "\n";
+        releaseWarmBytesLocked();
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+
+    m_activeSlot = bestSlot;
+    m_sequence = bestSequence;
+    m_entries = bestEntries;
+    m_endSector = std::max(kFirstDataSector, SectorsFor(m_warmBytes.size()));
+    m_liveSectors = 0;
+    m_warmReadsRemaining = 0;
+    for (auto& entry : m_entries) {
+        if (entry.sectorOffset == 0) continue;
+        const uint64_t endByte = static_cast<uint64_t>(entry.sectorOffset) * kSectorBytes + entry.byteLength;
+        if (entry.sectorOffset < kFirstDataSector || entry.byteLength == 0 || endByte > m_warmBytes.size()) {
+            std::cerr << "[world/region] dropping out-of-range entry in " << m_path.string() << "\n";
+            entry = Entry{};
+            continue;
+        }
+        m_liveSectors += SectorsFor(entry.byteLength);
+        ++m_warmReadsRemaining;
+    }
+    if (m_warmReadsRemaining == 0) {
+        releaseWarmBytesLocked();
+    }
+    return true;
+}
+
+void RegionFile::close() {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (m_file) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+    releaseWarmBytesLocked();
+}
+
+bool RegionFile::hasChunk(int localIndex) const {
+    if (localIndex < 0 || localIndex >= REGION_CHUNK_COUNT) return false;
+    std::lock_guard<std::mutex> lk(m_mutex);
+    return m_entries[static_cast<size_t>(localIndex)].sectorOffset != 0;
+}
+
+bool RegionFile::readChunk(int localIndex, std::vector<uint8_t>& outPayload, uint32_t& outFlags) {
+    if (localIndex < 0 || localIndex >= REGION_CHUNK_COUNT) return false;
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_file) return false;
+
+    const Entry& entry = m_entries[static_cast<size_t>(localIndex)];
+    if (entry.sectorOffset == 0) return false;
+    if (!readPayloadLocked(entry, outPayload)) return false;
+    outFlags = entry.flags;
+    return true;
+}
+
+bool RegionFile::writeChunks(const std::vector<ChunkWrite>& writes) {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_file) return false;
+    if (writes.empty()) return true;
+
+    releaseWarmBytesLocked();
+
+    EntryTable next = m_entries;
+    uint32_t cursor = m_endSector;
+    uint32_t liveSectors = m_liveSectors;
+    if (std::fseek(m_file, static_cast<long>(cursor) * static_cast<long>(kSectorBytes), SEEK_SET) != 0) {
+        return false;
+    }
+
+    for (const auto& write : writes) {
+        if (write.localIndex < 0 || write.localIndex >= REGION_CHUNK_COUNT || write.payload.empty()) continue;
+        if (!WritePadded(m_file, write.payload)) {
+            std::cerr << "[world/region] append failed on " << m_path.string() << "\n";
+            return false;
+        }
+
+        Entry& entry = next[static_cast<size_t>(write.localIndex)];
+        if (entry.sectorOffset != 0) {
+            liveSectors -= SectorsFor(entry.byteLength);
+        }
+        entry.sectorOffset = cursor;
+        entry.byteLength = static_cast<uint32_t>(write.payload.size());
+        entry.checksum = Fnv1a32(write.payload.data(), write.payload.size());
+        entry.flags = write.flags;
+
+        const uint32_t sectors = SectorsFor(write.payload.size());
+        cursor += sectors;
+        liveSectors += sectors;
+    }
+
+    // Payloads must be durable before any header points at them.
+    if (!FlushToDisk(m_file)) {
+        std::cerr << "[world/region] data flush failed on " << m_path.string() << "\n";
+        return false;
+    }
+
+    const int slot = 1 - m_activeSlot;
+    const uint64_t sequence = m_sequence + 1;
+    if (!writeHeaderSlotLocked(m_file, slot, sequence, next) || !FlushToDisk(m_file)) {
+        std::cerr << "[world/region] header commit failed on " << m_path.string() << "\n";
+        return false;
+    }
+
+    m_entries = next;
+    m_activeSlot = slot;
+    m_sequence = sequence;
+    m_endSector = cursor;
+    m_liveSectors = liveSectors;
+
+    if (shouldCompactLocked()) {
+        compactLocked();
+    }
+    return true;
+}
+
+bool RegionFile::compact() {
+    std::lock_guard<std::mutex> lk(m_mutex);
+    if (!m_file) return false;
+    return compactLocked();
+}
+
+bool RegionFile::initializeEmptyLocked() {
+    m_entries = EntryTable{};
+    if (!writeHeaderSlotLocked(m_file, 0, 1, m_entries) ||
+        !writeHeaderSlotLocked(m_file, 1, 0, m_entries) ||
+        !FlushToDisk(m_file)) {
+        std::cerr << "[world/region] failed to initialize " << m_path.string() << "\n";
+        std::fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+    m_activeSlot = 0;
+    m_sequence = 1;
+    m_endSector = kFirstDataSector;
+    m_liveSectors = 0;
+    m_warmReadsRemaining = 0;
+    return true;
+}
+
+bool RegionFile::writeHeaderSlotLocked(std::FILE* file, int slot, uint64_t sequence, const EntryTable& entries) {
+    std::vector<uint8_t> bytes;
+    encodeHeaderSlot(sequence, entries, bytes);
+    if (std::fseek(file, static_cast<long>(slot) * static_cast<long>(kHeaderSlotBytes), SEEK_SET) != 0) {
+        return false;
+    }
+    return std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+}
+
+bool RegionFile::readPayloadLocked(const Entry& entry, std::vector<uint8_t>& outPayload) {
+    if (!readRawPayloadLocked(entry, outPayload)) return false;
+
+    if (Fnv1a32(outPayload.data(), outPayload.size()) != entry.checksum) {
+        std::cerr << "[world/region] checksum mismatch in " << m_path.string()
+            << " sector=" << entry.sectorOffset << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool RegionFile::readRawPayloadLocked(const Entry& entry, std::vector<uint8_t>& outPayload) {
+    const size_t start = static_cast<size_t>(entry.sectorOffset) * kSectorBytes;
+    outPayload.resize(entry.byteLength);
+
+    if (start + entry.byteLength <= m_warmBytes.size()) {
+        std::memcpy(outPayload.data(), m_warmBytes.data() + start, entry.byteLength);
+        if (m_warmReadsRemaining > 0 && --m_warmReadsRemaining == 0) {
+            releaseWarmBytesLocked();
+        }
+    }
+    else {
+        if (std::fseek(m_file, static_cast<long>(start), SEEK_SET) != 0) return false;
+        if (std::fread(outPayload.data(), 1, outPayload.size(), m_file) != outPayload.size()) return false;
+    }
+    return true;
+}
+
+bool RegionFile::shouldCompactLocked() const {
+    const uint32_t usedSectors = m_endSector - kFirstDataSector;
+    const uint32_t deadSectors = (usedSectors > m_liveSectors) ? (usedSectors - m_liveSectors) : 0;
+    return deadSectors >= kCompactMinDeadSectors && deadSectors > m_liveSectors;
+}
+
+bool RegionFile::compactLocked() {
+    std::filesystem::path tmpPath = m_path;
+    tmpPath += ".tmp";
+
+    std::FILE* out = std::fopen(tmpPath.string().c_str(), "w+b");
+    if (!out) {
+        std::cerr << "[world/region] failed to create " << tmpPath.string() << "\n";
+        return false;
+    }
+
+    EntryTable compacted{};
+    uint32_t cursor = kFirstDataSector;
+    bool ok = std::fseek(out, static_cast<long>(kFirstDataSector) * static_cast<long>(kSectorBytes), SEEK_SET) == 0;
+    std::vector<uint8_t> payload;
+    for (size_t i = 0; ok && i < m_entries.size(); ++i) {
+        const Entry& entry = m_entries[i];
+        if (entry.sectorOffset == 0) continue;
+        if (!readRawPayloadLocked(entry, payload)) {
+            // Dropping the record would delete the chunk for good; keep the old file instead.
+            std::cerr << "[world/region] compaction aborted: unreadable record in " << m_path.string()
+                << " chunk=" << i << " sector=" << entry.sectorOffset << "\n";
+            ok = false;
+            break;
+        }
+        if (Fnv1a32(payload.data(), payload.size()) != entry.checksum) {
+            // Copied as stored, with its old checksum, so loads still reject it but nothing is lost.
+            std::cerr << "[world/region] compaction keeping corrupt record in " << m_path.string()
+                << " chunk=" << i << " sector=" << entry.sectorOffset << "\n";
+        }
+        ok = WritePadded(out, payload);
+        compacted[i] = entry;
+        compacted[i].sectorOffset = cursor;
+        cursor += SectorsFor(entry.byteLength);
+    }
+
+    const uint64_t sequence = m_sequence + 1;
+    ok = ok &&
+        writeHeaderSlotLocked(out, 0, sequence, compacted) &&
+        writeHeaderSlotLocked(out, 1, sequence - 1, compacted) &&
+        FlushToDisk(out);
+    std::fclose(out);
+
+    std::error_code ec;
+    if (!ok) {
+        std::cerr << "[world/region] compaction write failed for " << m_path.string() << "\n";
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    std::fclose(m_file);
+    m_file = nullptr;
+    releaseWarmBytesLocked();
+
+    std::filesystem::rename(tmpPath, m_path, ec);
+    if (ec) {
+        std::cerr << "[world/region] compaction rename failed for " << m_path.string() << ": " << ec.message() << "\n";
+        std::filesystem::remove(tmpPath, ec);
+        m_file = std::fopen(m_path.string().c_str(), "r+b");
+        return false;
+    }
+
+    m_file = std::fopen(m_path.string().c_str(), "r+b");
+    if (!m_file) {
+        std::cerr << "[world/region] failed to reopen " << m_path.string() << " after compaction\n";
+        return false;
+    }
+
+    m_entries = compacted;
+    m_activeSlot = 0;
+    m_sequence = sequence;
+    m_endSector = cursor;
+    m_liveSectors = cursor - kFirstDataSector;
+    return true;
+}
+
+void RegionFile::releaseWarmBytesLocked() {
+    std::vector<uint8_t>().swap(m_warmBytes);
+    m_warmReadsRemaining = 0;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <vector>
+
+// Chunks per region along each axis. A region file stores REGION_SIZE^3 chunks.
+constexpr int REGION_SIZE = 8;
+constexpr int REGION_CHUNK_COUNT = REGION_SIZE * REGION_SIZE * REGION_SIZE;
+
+// Anvil-style region file.
+//
+// Layout:
+//   [header slot A][header slot B][data sectors...]
+// Each header slot holds a sequence number, one entry per chunk
+// (sector offset, byte length, payload checksum, flags) and a slot checksum.
+// Chunk payloads are only ever appended; a write publishes a new header into the
+// slot that is not currently active, so a crash mid-update leaves the previous
+// header (and the data it points at) intact. Dead sectors are reclaimed by
+// compact(), which rewrites live payloads into a temp file and renames it over.
+class RegionFile {
+public:
+    static constexpr uint32_t kFlagCompressed = 1u << 0;
+    static constexpr uint32_t kFlagDecorated = 1u << 1;
+
+    struct ChunkWrite {
+        int localIndex = 0;
+        uint32_t flags = 0;
+        std::vector<uint8_t> payload;
+    };
+
+    explicit RegionFile(std::filesystem::path path);
+    ~RegionFile();
+
+    RegionFile(const RegionFile&) = delete;
+    RegionFile& operator=(const RegionFile&) = delete;
+
+    // Opens the region (creating an empty one if requested) and validates its header.
+    // The file is read in one sequential pass and served from memory until every
+    // stored chunk has been read once.
+    bool open(bool createIfMissing);
+    void close();
+
+    bool hasChunk(int localIndex) const;
+    bool readChunk(int localIndex, std::vector<uint8_t>& outPayload, uint32_t& outFlags);
+
+    // Appends all payloads, flushes them to disk, then commits one header update.
+    bool writeChunks(const std::vector<ChunkWrite>& writes);
+    bool compact();
+
+    const std::filesystem::path& path() const noexcept { return m_path; }
+
+    static glm::ivec3 regionCoordForChunk(const glm::ivec3& chunkPos);
+    static int localIndexForChunk(const glm::ivec3& chunkPos);
+    static std::filesystem::path pathFor(const std::filesystem::path& worldDir, const glm::ivec3& regionPos);
+
+private:
+    struct Entry {
+        uint32_t sectorOffset = 0; // 0 => chunk not stored
+        uint32_t byteLength = 0;
+        uint32_t checksum = 0;
+        uint32_t flags = 0;
+    };
+    using EntryTable = std::array<Entry, REGION_CHUNK_COUNT>;
+
+    static void encodeHeaderSlot(uint64_t sequence, const EntryTable& entries, std::vector<uint8_t>& out);
+    static bool decodeHeaderSlot(const uint8_t* data, uint64_t& outSequence, EntryTable& outEntries);
+
+    bool initializeEmptyLocked();
+    bool writeHeaderSlotLocked(std::FILE* file, int slot, uint64_t sequence, const EntryTable& entries);
+    bool readPayloadLocked(const Entry& entry, std::vector<uint8_t>& outPayload);
+    // Stored bytes without the checksum check; false only on I/O failure.
+    bool readRawPayloadLocked(const Entry& entry, std::vector<uint8_t>& outPayload);
+    bool compactLocked();
+    bool shouldCompactLocked() const;
+    void releaseWarmBytesLocked();
+
+    std::filesystem::path m_path;
+    mutable std::mutex m_mutex;
+    std::FILE* m_file = nullptr;
+
+    EntryTable m_entries{};
+    int m_activeSlot = 0;
+    uint64_t m_sequence = 0;
+    uint32_t m_endSector = 0;
+    uint32_t m_liveSectors = 0;
+
+    // whole-file snapshot taken by open(); dropped once fully consumed or on first write
+    std::vector<uint8_t> m_warmBytes;
+    uint32_t m_warmReadsRemaining = 0;
+};
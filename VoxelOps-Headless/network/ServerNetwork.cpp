@@ -1,5 +1,7 @@
 #include "ServerNetwork.hpp"
 #include "../player/Hitbox.hpp"
+#include "../player/PlayerHitMesh.hpp"
+#include "../physics/RayManager.hpp"
 #include "../../Shared/gun/GunType.hpp"
 #include "../../Shared/player/PlayerData.hpp"
 #include "../../Shared/player/HitboxCache.hpp"
@@ -33,28 +35,24 @@ constexpr uint32_t kMaxConnectRequestBytes =
     static_cast<uint32_t>(kMaxConnectIdentityChars) +
     static_cast<uint32_t>(kMaxConnectUsernameChars);
 constexpr uint32_t kMaxChatMessageBytes = 1u + 512u;
-constexpr uint32_t kPlayerInputPacketBytes = 1u + 4u + 1u + 1u + 2u + 4u * 4u;
+constexpr uint32_t kPlayerInputPacketBytes = 1u + 4u + 1u + 1u + 2u + 4u * 4u + 1u + 4u;
 constexpr uint32_t kPlayerPositionPacketBytes = 1u + 4u + 6u * 4u;
 constexpr uint32_t kChunkRequestPacketBytes = 1u + 4u + 4u + 4u + 2u;
 constexpr uint32_t kBlockPlaceRequestPacketMaxBytes =
     1u + 4u + 2u + static_cast<uint32_t>(kMaxBlockPlaceEditsPerRequest) * (4u + 4u + 4u + 1u);
 constexpr uint32_t kBlockBreakRequestPacketMaxBytes =
     1u + 4u + 2u + static_cast<uint32_t>(kMaxBlockBreakEditsPerRequest) * (4u + 4u + 4u);
-constexpr uint32_t kShootRequestPacketBytes = 1u + 4u + 4u + 2u + 12u + 12u + 4u + 1u;
+constexpr uint32_t kShootRequestPacketBytes = 1u + 4u + 4u + 1u + 2u + 12u + 12u + 4u + 1u;
 constexpr uint32_t kInventoryActionRequestPacketBytes = 1u + 4u + 4u + 1u + 2u + 2u + 2u;
 constexpr auto kInboundRateWindow = std::chrono::seconds(1);
 constexpr uint32_t kMaxInboundPacketsPerWindow = 900u;
 constexpr uint32_t kMaxInboundBytesPerWindow = 256u * 1024u;
 constexpr uint32_t kMaxPlayerInputsPerWindow = 360u;
 constexpr uint32_t kMaxChunkRequestsPerWindow = 120u;
-constexpr uint32_t kServerTickRateHz = 60u;
 constexpr float kShootMaxDistance = 128.0f;
 constexpr float kShootMinIntervalSeconds = 1.0f / 8.0f;
 constexpr float kShootLagCompensationWindowSeconds = 0.300f;
-constexpr uint32_t kShootLagCompensationMaxTicks =
-    static_cast<uint32_t>(kShootLagCompensationWindowSeconds * static_cast<float>(kServerTickRateHz) + 0.5f);
-constexpr size_t kShootLagCompensationMaxFrames =
-    static_cast<size_t>(kShootLagCompensationMaxTicks + 4u);
+constexpr size_t kLagCompExpectedPlayers = 64; // per-frame reserve; more players only grow once
 constexpr float kShootHitboxPadXZ = 0.08f;
 constexpr float kShootHitboxPadY = 0.04f;
 constexpr float kShootBlockOcclusionEpsilon = 0.06f;
@@ -227,13 +225,6 @@ HitRegion RegionFromCacheCode(uint8_t code) {
     }
 }
 
-struct MeshHitTriangle {
-    glm::vec3 a{ 0.0f };
-    glm::vec3 b{ 0.0f };
-    glm::vec3 c{ 0.0f };
-    HitRegion region = HitRegion::Body;
-};
-
 HitRegion RegionFromLocalHeight(float localY, float height) {
     if (!std::isfinite(localY) || !std::isfinite(height) || height <= 1e-4f) {
         return HitRegion::Unknown;
@@ -323,31 +314,35 @@ const std::vector<Hitbox>& GetSharedPlayerHitboxes(float& outReferenceHeight, fl
     return cachedHitboxes;
 }
 
-const std::vector<MeshHitTriangle>& GetSharedPlayerMeshHitTriangles(float& outReferenceHeight) {
+// Built once from the mesh hit cache; empty when the cache is missing.
+const PlayerHitMeshBvh& GetSharedPlayerHitMesh(float& outReferenceHeight) {
     static bool initialized = false;
     static float referenceHeight = movementSettings().collisionHeight;
-    static std::vector<MeshHitTriangle> cachedTriangles;
+    static PlayerHitMeshBvh cachedMesh;
 
     if (!initialized) {
         initialized = true;
         float loadedHeight = 0.0f;
         std::vector<Shared::MeshHitCache::TriangleRecord> records;
         if (Shared::MeshHitCache::Load(SharedMeshHitCachePath(), loadedHeight, records) && !records.empty()) {
-            cachedTriangles.reserve(records.size());
+            std::vector<PlayerHitMeshBvh::Triangle> triangles;
+            triangles.reserve(records.size());
             for (const Shared::MeshHitCache::TriangleRecord& rec : records) {
-                MeshHitTriangle tri;
+                PlayerHitMeshBvh::Triangle tri;
                 tri.a = glm::vec3(rec.ax, rec.ay, rec.az);
                 tri.b = glm::vec3(rec.bx, rec.by, rec.bz);
                 tri.c = glm::vec3(rec.cx, rec.cy, rec.cz);
                 tri.region = RegionFromCacheCode(rec.region);
-                cachedTriangles.push_back(tri);
+                triangles.push_back(tri);
             }
+            cachedMesh.build(triangles);
             if (loadedHeight > 1e-4f) {
                 referenceHeight = loadedHeight;
             }
             if (kEnableHitboxDiagnostics) {
                 std::cout
-                    << "[hitbox/server] mesh_source=cache triangles=" << cachedTriangles.size()
+                    << "[hitbox/server] mesh_source=cache triangles=" << cachedMesh.triangleCount()
+                    << " capsuleRadius=" << cachedMesh.boundingCapsule().radius
                     << " refHeight=" << referenceHeight
                     << " path=" << SharedMeshHitCachePath()
                     << "\n";
@@ -361,48 +356,13 @@ const std::vector<MeshHitTriangle>& GetSharedPlayerMeshHitTriangles(float& outRe
     }
 
     outReferenceHeight = referenceHeight;
-    return cachedTriangles;
+    return cachedMesh;
 }
 
-bool RayIntersectsTriangle(
-    const glm::vec3& origin,
-    const glm::vec3& dir,
-    const glm::vec3& a,
-    const glm::vec3& b,
-    const glm::vec3& c,
-    float& outT
-) {
-    constexpr float kEpsilon = 1e-6f;
-    const glm::vec3 edge1 = b - a;
-    const glm::vec3 edge2 = c - a;
-    const glm::vec3 pvec = glm::cross(dir, edge2);
-    const float det = glm::dot(edge1, pvec);
-    if (std::abs(det) < kEpsilon) {
-        return false;
-    }
-    const float invDet = 1.0f / det;
-    const glm::vec3 tvec = origin - a;
-    const float u = glm::dot(tvec, pvec) * invDet;
-    if (u < 0.0f || u > 1.0f) {
-        return false;
-    }
-    const glm::vec3 qvec = glm::cross(tvec, edge1);
-    const float v = glm::dot(dir, qvec) * invDet;
-    if (v < 0.0f || (u + v) > 1.0f) {
-        return false;
-    }
-    const float t = glm::dot(edge2, qvec) * invDet;
-    if (t <= kEpsilon) {
-        return false;
-    }
-    outT = t;
-    return true;
-}
-
-HitResult RaycastMeshTriangles(
+HitResult RaycastPlayerHitMesh(
     const glm::vec3& rayOrigin,
     const glm::vec3& rayDir,
-    const std::vector<MeshHitTriangle>& triangles,
+    const PlayerHitMeshBvh& mesh,
     const glm::mat4& modelMatrix,
     float uniformScale,
     float maxDistance
@@ -411,6 +371,9 @@ HitResult RaycastMeshTriangles(
     out.hit = false;
     out.region = HitRegion::Unknown;
     out.distance = maxDistance;
+    if (uniformScale <= 1e-6f) {
+        return out;
+    }
 
     const glm::mat4 invModel = glm::inverse(modelMatrix);
     const glm::vec3 originLocal = glm::vec3(invModel * glm::vec4(rayOrigin, 1.0f));
@@ -421,26 +384,17 @@ HitResult RaycastMeshTriangles(
     }
     dirLocal /= dirLen;
 
-    for (const MeshHitTriangle& tri : triangles) {
-        const glm::vec3 a = tri.a * uniformScale;
-        const glm::vec3 b = tri.b * uniformScale;
-        const glm::vec3 c = tri.c * uniformScale;
-        float t = 0.0f;
-        if (!RayIntersectsTriangle(originLocal, dirLocal, a, b, c, t)) {
-            continue;
-        }
-        if (t > maxDistance) {
-            continue;
-        }
-        if (!out.hit || t < out.distance) {
-            out.hit = true;
-            out.distance = t;
-            out.region = tri.region;
-            const glm::vec3 hitLocal = originLocal + dirLocal * t;
-            out.hitPointWorld = glm::vec3(modelMatrix * glm::vec4(hitLocal, 1.0f));
-        }
+    // Trace the unscaled mesh instead of scaling every triangle; distances scale back by uniformScale.
+    float meshT = 0.0f;
+    HitRegion region = HitRegion::Unknown;
+    if (!mesh.raycast(originLocal / uniformScale, dirLocal, maxDistance / uniformScale, meshT, region)) {
+        return out;
     }
-
+    out.hit = true;
+    out.distance = meshT * uniformScale;
+    out.region = region;
+    const glm::vec3 hitLocal = originLocal + dirLocal * out.distance;
+    out.hitPointWorld = glm::vec3(modelMatrix * glm::vec4(hitLocal, 1.0f));
     return out;
 }
 
@@ -462,75 +416,13 @@ bool FindFirstSolidBlockHit(
     if (!std::isfinite(maxDistance) || maxDistance <= 0.0f) {
         return false;
     }
-    const float dirLenSq = glm::dot(dir, dir);
-    if (!std::isfinite(dirLenSq) || dirLenSq < 1e-8f) {
+    Shared::Voxel::VoxelRayHit hit;
+    if (!Shared::Voxel::Raycast(ChunkRayWorld{ chunkManager }, origin, dir, maxDistance, hit)) {
         return false;
     }
-
-    const glm::vec3 rayDir = glm::normalize(dir);
-    glm::ivec3 currentBlock = glm::ivec3(glm::floor(origin));
-    const glm::ivec3 step = glm::sign(rayDir);
-
-    glm::vec3 tMax(0.0f);
-    glm::vec3 tDelta(0.0f);
-    for (int i = 0; i < 3; ++i) {
-        if (rayDir[i] != 0.0f) {
-            const float nextBoundary = (step[i] > 0) ? (currentBlock[i] + 1.0f) : currentBlock[i];
-            tMax[i] = (nextBoundary - origin[i]) / rayDir[i];
-            tDelta[i] = std::abs(1.0f / rayDir[i]);
-        }
-        else {
-            tMax[i] = std::numeric_limits<float>::max();
-            tDelta[i] = std::numeric_limits<float>::max();
-        }
-    }
-
-    constexpr int kMaxDdaSteps = 2048;
-    float traveled = 0.0f;
-    for (int i = 0; i < kMaxDdaSteps; ++i) {
-        if (traveled > maxDistance) {
-            break;
-        }
-
-        const glm::ivec3 chunkCoords = chunkManager.worldToChunkPos(currentBlock);
-        if (const ServerChunk* chunk = chunkManager.getChunkIfExists(chunkCoords)) {
-            const glm::ivec3 blockInChunk = currentBlock - chunk->getWorldPosition();
-            if (ServerChunk::inBounds(blockInChunk.x, blockInChunk.y, blockInChunk.z)) {
-                if (chunk->getBlockUnchecked(blockInChunk.x, blockInChunk.y, blockInChunk.z) != BlockID::Air) {
-                    outDistance = traveled;
-                    outHitPoint = origin + rayDir * traveled;
-                    return true;
-                }
-            }
-        }
-
-        if (tMax.x < tMax.y) {
-            if (tMax.x < tMax.z) {
-                traveled = tMax.x;
-                currentBlock.x += step.x;
-                tMax.x += tDelta.x;
-            }
-            else {
-                traveled = tMax.z;
-                currentBlock.z += step.z;
-                tMax.z += tDelta.z;
-            }
-        }
-        else {
-            if (tMax.y < tMax.z) {
-                traveled = tMax.y;
-                currentBlock.y += step.y;
-                tMax.y += tDelta.y;
-            }
-            else {
-                traveled = tMax.z;
-                currentBlock.z += step.z;
-                tMax.z += tDelta.z;
-            }
-        }
-    }
-
-    return false;
+    outDistance = hit.distance;
+    outHitPoint = hit.point;
+    return true;
 }
 
 bool IsInboundPacketSizeValid(PacketType type, uint32_t bytes)
@@ -599,6 +491,8 @@ bool ParsePlayerInputPacket(const uint8_t* data, uint32_t size, PlayerInput& out
     out.pitch = ReadF32LE(data + 13);
     out.moveX = ReadF32LE(data + 17);
     out.moveZ = ReadF32LE(data + 21);
+    out.hasSnapshotAck = data[25];
+    out.ackedSnapshotTick = ReadU32LE(data + 26);
     return std::isfinite(out.yaw) &&
         std::isfinite(out.pitch) &&
         std::isfinite(out.moveX) &&
@@ -686,6 +580,88 @@ bool ParseBlockBreakRequestPacket(const uint8_t* data, uint32_t size, BlockBreak
     out = *parsed;
     return true;
 }
+
+// Runs on the network I/O thread after the size and rate checks. Returns false when the packet
+// should be dropped; malformed connect/block requests are kept (empty payload) so the simulation
+// thread can answer them with a rejection.
+bool ParseInboundCommand(PacketType type, const void* data, uint32_t size, InboundCommand& out)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    out.type = type;
+    out.payload = std::monostate{};
+    switch (type) {
+    case PacketType::ConnectRequest: {
+        std::vector<uint8_t> connectBytes(bytes, bytes + size);
+        std::optional<ConnectRequest> parsed = ConnectRequest::deserialize(connectBytes);
+        if (parsed.has_value()) {
+            out.payload = std::move(*parsed);
+        }
+        return true;
+    }
+    case PacketType::Message:
+        out.payload = std::string(reinterpret_cast<const char*>(bytes) + 1, size - 1);
+        return true;
+    case PacketType::PlayerInput: {
+        PlayerInput input{};
+        if (!ParsePlayerInputPacket(bytes, size, input)) {
+            std::cout << "[recv] malformed PlayerInput (size=" << size << ")\n";
+            return false;
+        }
+        out.payload = input;
+        return true;
+    }
+    case PacketType::PlayerPosition:
+        // Legacy packet still accepted on the wire but ignored by authoritative movement.
+        return false;
+    case PacketType::ChunkRequest: {
+        ChunkRequest req{};
+        if (!ParseChunkRequestPacket(bytes, size, req)) {
+            std::cout << "[recv] malformed ChunkRequest (size=" << size << ")\n";
+            return false;
+        }
+        out.payload = req;
+        return true;
+    }
+    case PacketType::BlockPlaceRequest: {
+        BlockPlaceRequest request{};
+        if (ParseBlockPlaceRequestPacket(bytes, size, request)) {
+            out.payload = request;
+        } else {
+            std::cerr << "[block/place] malformed request size=" << size << "\n";
+        }
+        return true;
+    }
+    case PacketType::BlockBreakRequest: {
+        BlockBreakRequest request{};
+        if (ParseBlockBreakRequestPacket(bytes, size, request)) {
+            out.payload = request;
+        } else {
+            std::cerr << "[block/break] malformed request size=" << size << "\n";
+        }
+        return true;
+    }
+    case PacketType::ShootRequest: {
+        ShootRequest req{};
+        if (!ParseShootRequestPacket(bytes, size, req)) {
+            std::cerr << "[recv] malformed ShootRequest\n";
+            return false;
+        }
+        out.payload = req;
+        return true;
+    }
+    case PacketType::InventoryActionRequest: {
+        InventoryActionRequest request{};
+        if (!ParseInventoryActionRequestPacket(bytes, size, request)) {
+            std::cerr << "[recv] malformed InventoryActionRequest\n";
+            return false;
+        }
+        out.payload = request;
+        return true;
+    }
+    default:
+        return false;
+    }
+}
 }
 
 ServerNetwork::ServerNetwork()
@@ -695,6 +671,22 @@ ServerNetwork::ServerNetwork()
 {
     // allow only one instance to own the static callback bridge
     s_instance = this;
+    SetTickRateHz(kDefaultTickRateHz);
+}
+
+void ServerNetwork::SetTickRateHz(uint32_t tickRateHz)
+{
+    m_tickRateHz = std::clamp(tickRateHz, TickScheduler::kMinTickRateHz, TickScheduler::kMaxTickRateHz);
+    m_lagCompMaxTicks = static_cast<uint32_t>(
+        kShootLagCompensationWindowSeconds * static_cast<float>(m_tickRateHz) + 0.5f
+    );
+    m_lagCompHistory.configure(m_lagCompMaxTicks, kLagCompExpectedPlayers);
+}
+
+TickJitterStats ServerNetwork::GetTickJitterStats() const
+{
+    std::lock_guard<std::mutex> lk(m_tickJitterMutex);
+    return m_lastTickJitter;
 }
 
 ServerNetwork::~ServerNetwork()
@@ -714,7 +706,7 @@ bool ServerNetwork::Start(uint16_t port)
 
     m_quit.store(false, std::memory_order_release);
     m_serverTick.store(0, std::memory_order_release);
-    m_lagCompFrames.clear();
+    m_lagCompHistory.clear();
     m_matchStartTime = std::chrono::steady_clock::now();
     m_matchStarted = false;
     m_matchEnded = false;
@@ -738,6 +730,7 @@ bool ServerNetwork::Start(uint16_t port)
 
     LoadHistoryFromFile();
     LoadAdminsFromFile();
+    OpenWorldStore();
 
     // Create poll group (used to efficiently receive messages from many connections)
     m_pollGroup = SteamNetworkingSockets()->CreatePollGroup();
@@ -787,6 +780,7 @@ void ServerNetwork::Run()
         std::cerr << "ServerNetwork::Run called before Start\n";
         return;
     }
+    StartNetIoThread();
     MainLoop();
     ShutdownNetworking();
 }
@@ -804,9 +798,12 @@ void ServerNetwork::ShutdownNetworking()
     }
     m_shutdownComplete = true;
 
+    StopNetIoThread();
+    m_inboundCommands.clear();
     StopChunkPipeline();
     SaveHistoryToFile();
     SaveAdminsToFile();
+    SaveWorldToDisk();
 
     std::vector<std::pair<HSteamNetConnection, ClientSession>> sessions;
     {
@@ -850,37 +847,7 @@ void ServerNetwork::ShutdownNetworking()
 
 void ServerNetwork::RecordLagCompFrame(uint32_t serverTick)
 {
-    LagCompFrame frame{};
-    frame.serverTick = serverTick;
-
-    const std::vector<ServerPlayer> players = m_playerManager.getAllPlayersCopy();
-    frame.players.reserve(players.size());
-    for (const ServerPlayer& player : players) {
-        if (!player.isAlive) {
-            continue;
-        }
-        LagCompPlayerPose pose{};
-        pose.position = player.position;
-        pose.yaw = player.yaw;
-        pose.height = player.height;
-        pose.radius = player.radius;
-        frame.players.emplace(player.id, pose);
-    }
-
-    m_lagCompFrames.push_back(std::move(frame));
-    while (m_lagCompFrames.size() > kShootLagCompensationMaxFrames) {
-        m_lagCompFrames.pop_front();
-    }
-    while (!m_lagCompFrames.empty()) {
-        const uint32_t oldestTick = m_lagCompFrames.front().serverTick;
-        if (!IsNewerU32(serverTick, oldestTick)) {
-            break;
-        }
-        if ((serverTick - oldestTick) <= kShootLagCompensationMaxTicks) {
-            break;
-        }
-        m_lagCompFrames.pop_front();
-    }
+    m_lagCompHistory.record(serverTick, m_playerManager.publishedPlayers());
 }
 
 static int FloorDiv(int a, int b) {
@@ -983,28 +950,10 @@ void ServerNetwork::UpdateChunkStreamingForClient(HSteamNetConnection conn, cons
         --verticalAnchorY;
     }
     std::sort(toLoad.begin(), toLoad.end(), [&](const ChunkCoord& a, const ChunkCoord& b) {
-        const int adx = a.x - centerChunk.x;
-        const int adz = a.z - centerChunk.z;
-        const int bdx = b.x - centerChunk.x;
-        const int bdz = b.z - centerChunk.z;
-        const int aHorizDist2 = adx * adx + adz * adz;
-        const int bHorizDist2 = bdx * bdx + bdz * bdz;
-        if (aHorizDist2 != bHorizDist2) {
-            return aHorizDist2 < bHorizDist2;
-        }
-
-        if (isInitialSync) {
-            const bool aUnderOrSame = (a.y <= verticalAnchorY);
-            const bool bUnderOrSame = (b.y <= verticalAnchorY);
-            if (aUnderOrSame != bUnderOrSame) {
-                return aUnderOrSame;
-            }
-        }
-
-        const int aVert = std::abs(a.y - verticalAnchorY);
-        const int bVert = std::abs(b.y - verticalAnchorY);
-        if (aVert != bVert) {
-            return aVert < bVert;
+        const uint64_t aPriority = ChunkStreamPriority(a, centerChunk, verticalAnchorY, isInitialSync);
+        const uint64_t bPriority = ChunkStreamPriority(b, centerChunk, verticalAnchorY, isInitialSync);
+        if (aPriority != bPriority) {
+            return aPriority < bPriority;
         }
 
         if (a.x != b.x) return a.x < b.x;
@@ -1044,7 +993,7 @@ void ServerNetwork::UpdateChunkStreamingForClient(HSteamNetConnection conn, cons
             stoppedByPendingCap = true;
             break;
         }
-        if (!QueueChunkPreparation(conn, c)) {
+        if (!QueueChunkPreparation(conn, c, ChunkStreamPriority(c, centerChunk, verticalAnchorY, isInitialSync))) {
             stoppedByPrepCap = true;
             break;
         }
@@ -1157,7 +1106,7 @@ bool ServerNetwork::IsInboundRateLimitExceeded(HSteamNetConnection incoming, Pac
     return false;
 }
 
-void ServerNetwork::HandleConnectRequest(HSteamNetConnection incoming, const void* data, uint32_t size)
+void ServerNetwork::HandleConnectRequest(HSteamNetConnection incoming, const ConnectRequest* request)
 {
     auto sendResponse = [&](const ConnectResponse& response) {
         const std::vector<uint8_t> payload = response.serialize();
@@ -1170,9 +1119,7 @@ void ServerNetwork::HandleConnectRequest(HSteamNetConnection incoming, const voi
         );
     };
 
-    std::vector<uint8_t> connectBytes(reinterpret_cast<const uint8_t*>(data), reinterpret_cast<const uint8_t*>(data) + size);
-    auto reqOpt = ConnectRequest::deserialize(connectBytes);
-    if (!reqOpt.has_value()) {
+    if (request == nullptr) {
         ConnectResponse response;
         response.ok = 0;
         response.reason = ConnectRejectReason::InvalidPacket;
@@ -1183,7 +1130,7 @@ void ServerNetwork::HandleConnectRequest(HSteamNetConnection incoming, const voi
         return;
     }
 
-    ConnectRequest req = std::move(*reqOpt);
+    const ConnectRequest& req = *request;
     if (req.protocolVersion != kVoxelOpsProtocolVersion) {
         ConnectResponse response;
         response.ok = 0;
@@ -1369,9 +1316,8 @@ void ServerNetwork::HandleConnectRequest(HSteamNetConnection incoming, const voi
         << " requested=" << requestedUsername << "\n";
 }
 
-void ServerNetwork::HandleMessagePacket(HSteamNetConnection incoming, const void* data, uint32_t size)
+void ServerNetwork::HandleMessagePacket(HSteamNetConnection incoming, const std::string& msg)
 {
-    std::string msg = ReadStringFromPacket(data, size, 1);
     std::string username;
     PlayerID playerId = 0;
     {
@@ -1463,20 +1409,8 @@ void ServerNetwork::HandleMessagePacket(HSteamNetConnection incoming, const void
     }
 }
 
-void ServerNetwork::HandlePlayerInputPacket(
-    HSteamNetConnection incoming,
-    const void* data,
-    uint32_t size,
-    uint64_t& playerInputPacketsThisLoop
-)
+void ServerNetwork::HandlePlayerInputPacket(HSteamNetConnection incoming, const PlayerInput& input)
 {
-    ++playerInputPacketsThisLoop;
-    PlayerInput input{};
-    if (!ParsePlayerInputPacket(reinterpret_cast<const uint8_t*>(data), size, input)) {
-        std::cout << "[recv] malformed PlayerInput (size=" << size << ")\n";
-        return;
-    }
-
     std::string username;
     PlayerID playerId = 0;
     {
@@ -1496,20 +1430,8 @@ void ServerNetwork::HandlePlayerInputPacket(
     }
 }
 
-void ServerNetwork::HandleChunkRequestPacket(
-    HSteamNetConnection incoming,
-    const void* data,
-    uint32_t size,
-    uint64_t& chunkRequestPacketsThisLoop
-)
+void ServerNetwork::HandleChunkRequestPacket(HSteamNetConnection incoming, const ChunkRequest& req)
 {
-    ++chunkRequestPacketsThisLoop;
-    ChunkRequest req{};
-    if (!ParseChunkRequestPacket(reinterpret_cast<const uint8_t*>(data), size, req)) {
-        std::cout << "[recv] malformed ChunkRequest (size=" << size << ")\n";
-        return;
-    }
-
     const glm::ivec3 centerChunk(req.chunkX, req.chunkY, req.chunkZ);
     const uint16_t clampedViewDistance = ClampViewDistance(req.viewDistance);
     bool registered = false;
@@ -1549,7 +1471,7 @@ void ServerNetwork::HandleChunkRequestPacket(
     }
 }
 
-void ServerNetwork::HandleBlockPlaceRequestPacket(HSteamNetConnection incoming, const void* data, uint32_t size)
+void ServerNetwork::HandleBlockPlaceRequestPacket(HSteamNetConnection incoming, const BlockPlaceRequest* requestPtr)
 {
     auto sendResult = [&](const BlockPlaceResult& res) {
         const std::vector<uint8_t> bytes = res.serialize();
@@ -1571,15 +1493,14 @@ void ServerNetwork::HandleBlockPlaceRequestPacket(HSteamNetConnection incoming,
         return corrective;
     };
 
-    BlockPlaceRequest request{};
-    if (!ParseBlockPlaceRequestPacket(reinterpret_cast<const uint8_t*>(data), size, request)) {
+    if (requestPtr == nullptr) {
         BlockPlaceResult result{};
         result.accepted = 0;
         result.rejectReason = BlockPlaceRejectReason::InvalidPacket;
         sendResult(result);
-        std::cerr << "[block/place] malformed request size=" << size << "\n";
         return;
     }
+    const BlockPlaceRequest& request = *requestPtr;
 
     PlayerID requesterId = 0;
     {
@@ -1627,6 +1548,17 @@ void ServerNetwork::HandleBlockPlaceRequestPacket(HSteamNetConnection incoming,
             sendResult(result);
             return;
         }
+        if (!m_chunkManager.hasChunkLoaded(chunkPos)) {
+            // Edits only apply to resident chunks; loading one here would stall the network thread.
+            touchedChunks.insert(chunkPos);
+            BlockPlaceResult result{};
+            result.requestId = request.requestId;
+            result.accepted = 0;
+            result.rejectReason = BlockPlaceRejectReason::ChunkNotLoaded;
+            result.correctiveChunks = buildCorrectiveChunks(touchedChunks);
+            sendResult(result);
+            return;
+        }
 
         normalizedEdits[worldPos] = static_cast<BlockID>(edit.blockId);
         touchedChunks.insert(chunkPos);
@@ -1642,9 +1574,9 @@ void ServerNetwork::HandleBlockPlaceRequestPacket(HSteamNetConnection incoming,
     }
 
     // Reject if any target cell intersects an alive player's collision capsule AABB.
-    const std::vector<ServerPlayer> players = m_playerManager.getAllPlayersCopy();
+    const PlayerKinematicsBuffer::View players = m_playerManager.publishedPlayers();
     constexpr float kOccupancyEpsilon = 0.001f;
-    auto playerOccupiesBlock = [&](const ServerPlayer& player, const glm::ivec3& blockPos) {
+    auto playerOccupiesBlock = [&](const PlayerKinematics& player, const glm::ivec3& blockPos) {
         const float pxMin = player.position.x - player.radius + kOccupancyEpsilon;
         const float pxMax = player.position.x + player.radius - kOccupancyEpsilon;
         const float pyMin = player.position.y + kOccupancyEpsilon;
@@ -1667,7 +1599,7 @@ void ServerNetwork::HandleBlockPlaceRequestPacket(HSteamNetConnection incoming,
 
     for (const auto& entry : normalizedEdits) {
         const glm::ivec3& worldPos = entry.first;
-        for (const ServerPlayer& player : players) {
+        for (const PlayerKinematics& player : players) {
             if (!player.isAlive) {
                 continue;
             }
@@ -1691,12 +1623,14 @@ void ServerNetwork::HandleBlockPlaceRequestPacket(HSteamNetConnection incoming,
     perChunkEdits.reserve(touchedChunks.size());
 
     for (const auto& [worldPos, newId] : normalizedEdits) {
-        const BlockID oldId = m_chunkManager.getBlockGlobal(worldPos.x, worldPos.y, worldPos.z);
-        if (oldId == newId) {
+        const std::optional<BlockID> oldId = m_chunkManager.tryGetBlockGlobal(worldPos);
+        if (!oldId || *oldId == newId) {
             continue;
         }
 
-        m_chunkManager.setBlockGlobal(worldPos.x, worldPos.y, worldPos.z, newId);
+        if (!m_chunkManager.setBlockIfLoaded(worldPos, newId)) {
+            continue;
+        }
 
         const glm::ivec3 chunkPos = m_chunkManager.worldToChunkPos(worldPos);
         const glm::ivec3 localPos = m_chunkManager.worldToLocalPos(worldPos);
@@ -1772,7 +1706,7 @@ void ServerNetwork::HandleBlockPlaceRequestPacket(HSteamNetConnection incoming,
     sendResult(result);
 }
 
-void ServerNetwork::HandleBlockBreakRequestPacket(HSteamNetConnection incoming, const void* data, uint32_t size)
+void ServerNetwork::HandleBlockBreakRequestPacket(HSteamNetConnection incoming, const BlockBreakRequest* requestPtr)
 {
     auto sendResult = [&](const BlockBreakResult& res) {
         const std::vector<uint8_t> bytes = res.serialize();
@@ -1794,15 +1728,14 @@ void ServerNetwork::HandleBlockBreakRequestPacket(HSteamNetConnection incoming,
         return corrective;
     };
 
-    BlockBreakRequest request{};
-    if (!ParseBlockBreakRequestPacket(reinterpret_cast<const uint8_t*>(data), size, request)) {
+    if (requestPtr == nullptr) {
         BlockBreakResult result{};
         result.accepted = 0;
         result.rejectReason = BlockBreakRejectReason::InvalidPacket;
         sendResult(result);
-        std::cerr << "[block/break] malformed request size=" << size << "\n";
         return;
     }
+    const BlockBreakRequest& request = *requestPtr;
 
     PlayerID requesterId = 0;
     {
@@ -1838,6 +1771,17 @@ void ServerNetwork::HandleBlockBreakRequestPacket(HSteamNetConnection incoming,
             sendResult(result);
             return;
         }
+        if (!m_chunkManager.hasChunkLoaded(chunkPos)) {
+            // Edits only apply to resident chunks; loading one here would stall the network thread.
+            touchedChunks.insert(chunkPos);
+            BlockBreakResult result{};
+            result.requestId = request.requestId;
+            result.accepted = 0;
+            result.rejectReason = BlockBreakRejectReason::ChunkNotLoaded;
+            result.correctiveChunks = buildCorrectiveChunks(touchedChunks);
+            sendResult(result);
+            return;
+        }
 
         normalizedEdits.insert(worldPos);
         touchedChunks.insert(chunkPos);
@@ -1853,9 +1797,9 @@ void ServerNetwork::HandleBlockBreakRequestPacket(HSteamNetConnection incoming,
     }
 
     // Keep break occupancy rules aligned with placement rules.
-    const std::vector<ServerPlayer> players = m_playerManager.getAllPlayersCopy();
+    const PlayerKinematicsBuffer::View players = m_playerManager.publishedPlayers();
     constexpr float kOccupancyEpsilon = 0.001f;
-    auto playerOccupiesBlock = [&](const ServerPlayer& player, const glm::ivec3& blockPos) {
+    auto playerOccupiesBlock = [&](const PlayerKinematics& player, const glm::ivec3& blockPos) {
         const float pxMin = player.position.x - player.radius + kOccupancyEpsilon;
         const float pxMax = player.position.x + player.radius - kOccupancyEpsilon;
         const float pyMin = player.position.y + kOccupancyEpsilon;
@@ -1877,7 +1821,7 @@ void ServerNetwork::HandleBlockBreakRequestPacket(HSteamNetConnection incoming,
     };
 
     for (const glm::ivec3& worldPos : normalizedEdits) {
-        for (const ServerPlayer& player : players) {
+        for (const PlayerKinematics& player : players) {
             if (!player.isAlive) {
                 continue;
             }
@@ -1901,12 +1845,14 @@ void ServerNetwork::HandleBlockBreakRequestPacket(HSteamNetConnection incoming,
     perChunkEdits.reserve(touchedChunks.size());
 
     for (const glm::ivec3& worldPos : normalizedEdits) {
-        const BlockID oldId = m_chunkManager.getBlockGlobal(worldPos.x, worldPos.y, worldPos.z);
-        if (oldId == BlockID::Air) {
+        const std::optional<BlockID> oldId = m_chunkManager.tryGetBlockGlobal(worldPos);
+        if (!oldId || *oldId == BlockID::Air) {
             continue;
         }
 
-        m_chunkManager.setBlockGlobal(worldPos.x, worldPos.y, worldPos.z, BlockID::Air);
+        if (!m_chunkManager.setBlockIfLoaded(worldPos, BlockID::Air)) {
+            continue;
+        }
 
         const glm::ivec3 chunkPos = m_chunkManager.worldToChunkPos(worldPos);
         const glm::ivec3 localPos = m_chunkManager.worldToLocalPos(worldPos);
@@ -1982,7 +1928,7 @@ void ServerNetwork::HandleBlockBreakRequestPacket(HSteamNetConnection incoming,
     sendResult(result);
 }
 
-void ServerNetwork::HandleShootRequestPacket(HSteamNetConnection incoming, const void* data, uint32_t size)
+void ServerNetwork::HandleShootRequestPacket(HSteamNetConnection incoming, const ShootRequest& req)
 {
     auto sendResult = [&](const ShootResult& res) {
         const std::vector<uint8_t> outBuf = res.serialize();
@@ -1995,11 +1941,6 @@ void ServerNetwork::HandleShootRequestPacket(HSteamNetConnection incoming, const
         );
     };
 
-    ShootRequest req{};
-    if (!ParseShootRequestPacket(reinterpret_cast<const uint8_t*>(data), size, req)) {
-        std::cerr << "[recv] malformed ShootRequest\n";
-        return;
-    }
     if (kEnableShootValidationLogs) {
         std::cout
             << "[shoot/validate] recv conn=" << incoming
@@ -2104,27 +2045,23 @@ void ServerNetwork::HandleShootRequestPacket(HSteamNetConnection incoming, const
         return;
     }
 
-    const LagCompFrame* lagCompFrame = nullptr;
+    // Rewind to the (sub-tick) moment the shooter was looking at; outside the window, use now.
     uint32_t lagCompTargetTick = currentServerTick;
+    uint8_t lagCompTargetFraction = 0;
     if (req.clientTick <= currentServerTick &&
-        (currentServerTick - req.clientTick) <= kShootLagCompensationMaxTicks) {
+        (currentServerTick - req.clientTick) <= m_lagCompMaxTicks) {
         lagCompTargetTick = req.clientTick;
+        lagCompTargetFraction = req.clientTickFraction;
     }
-    if (!m_lagCompFrames.empty()) {
-        for (auto it = m_lagCompFrames.rbegin(); it != m_lagCompFrames.rend(); ++it) {
-            if (!IsNewerU32(it->serverTick, lagCompTargetTick)) {
-                lagCompFrame = &(*it);
-                break;
-            }
-        }
-    }
+    const LagCompHistory::Rewind lagComp = m_lagCompHistory.rewind(lagCompTargetTick, lagCompTargetFraction);
 
-    auto shooterOpt = m_playerManager.getPlayerCopy(playerId);
-    if (!shooterOpt.has_value()) {
+    const PlayerKinematicsBuffer::View players = m_playerManager.publishedPlayers();
+    const PlayerKinematics* shooterEntry = players.find(playerId);
+    if (shooterEntry == nullptr) {
         sendResult(res);
         return;
     }
-    const ServerPlayer& shooter = *shooterOpt;
+    const PlayerKinematics& shooter = *shooterEntry;
     if (!shooter.isAlive) {
         sendResult(res);
         return;
@@ -2138,11 +2075,9 @@ void ServerNetwork::HandleShootRequestPacket(HSteamNetConnection incoming, const
     }
 
     glm::vec3 shooterBasePos = shooter.position;
-    if (lagCompFrame != nullptr) {
-        auto shooterLagIt = lagCompFrame->players.find(playerId);
-        if (shooterLagIt != lagCompFrame->players.end()) {
-            shooterBasePos = shooterLagIt->second.position;
-        }
+    LagCompHistory::Pose shooterPose{};
+    if (lagComp.pose(playerId, shooterPose)) {
+        shooterBasePos = shooterPose.position;
     }
 
     const glm::vec3 rayDir = glm::normalize(requestDir);
@@ -2175,60 +2110,102 @@ void ServerNetwork::HandleShootRequestPacket(HSteamNetConnection incoming, const
     if (kEnableShootValidationLogs) {
         std::cout
             << "[shoot/validate] shooter=" << playerId
-            << " lagCompTick=" << (lagCompFrame ? static_cast<int64_t>(lagCompFrame->serverTick) : -1)
+            << " lagCompTick=" << lagComp.baseTick()
+            << " lagCompFraction=" << static_cast<int>(lagCompTargetFraction)
             << " origin=(" << rayOrigin.x << "," << rayOrigin.y << "," << rayOrigin.z << ")"
             << " requestedOriginAccepted=" << (allowRequestedOrigin ? "yes" : "no")
             << " maxDistance=" << maxDistance
             << "\n";
     }
 
-    const std::vector<ServerPlayer> players = m_playerManager.getAllPlayersCopy();
     bool playerHit = false;
     PlayerID hitPlayerId = 0;
     HitRegion hitRegion = HitRegion::Unknown;
     glm::vec3 hitPoint = rayOrigin + rayDir * maxDistance;
     float bestPlayerDistance = maxDistance + 1.0f;
 
-    for (const ServerPlayer& target : players) {
+    float meshReferenceHeight = 0.0f;
+    const PlayerHitMeshBvh& hitMesh = GetSharedPlayerHitMesh(meshReferenceHeight);
+    float hitboxReferenceHeight = 0.0f;
+    float hitboxReferenceRadius = 0.0f;
+    const std::vector<Hitbox>* baseHitboxes = nullptr;
+    HitCapsule baseHitboxCapsule;
+    if (hitMesh.empty()) {
+        baseHitboxes = &GetSharedPlayerHitboxes(hitboxReferenceHeight, hitboxReferenceRadius);
+        static const HitCapsule cachedHitboxCapsule = BoundingCapsuleOfHitboxes(*baseHitboxes);
+        baseHitboxCapsule = cachedHitboxCapsule;
+    }
+
+    // Broadphase: rewound capsules the ray passes through, nearest first.
+    struct ShotCandidate {
+        PlayerID id = 0;
+        float enterDistance = 0.0f;
+        LagCompHistory::Pose pose;
+    };
+    thread_local std::vector<ShotCandidate> candidates;
+    thread_local std::vector<Hitbox> scaledHitboxes;
+    candidates.clear();
+    for (const PlayerKinematics& target : players) {
         if (target.id == playerId || !target.isAlive) {
             continue;
         }
 
-        glm::vec3 targetPosition = target.position;
-        float targetYaw = target.yaw;
-        float targetHeight = target.height;
-        float targetRadius = target.radius;
-        if (lagCompFrame != nullptr) {
-            auto targetLagIt = lagCompFrame->players.find(target.id);
-            if (targetLagIt != lagCompFrame->players.end()) {
-                const LagCompPlayerPose& pose = targetLagIt->second;
-                targetPosition = pose.position;
-                targetYaw = pose.yaw;
-                targetHeight = pose.height;
-                targetRadius = pose.radius;
-            }
+        ShotCandidate candidate;
+        candidate.id = target.id;
+        candidate.pose.position = target.position;
+        candidate.pose.yaw = target.yaw;
+        candidate.pose.height = target.height;
+        candidate.pose.radius = target.radius;
+        if (lagComp.valid() && !lagComp.pose(target.id, candidate.pose)) {
+            continue; // not in the world at the rewound tick
+        }
+
+        HitCapsule capsule;
+        if (!hitMesh.empty()) {
+            const float uniformScale = (meshReferenceHeight > 1e-4f) ? (candidate.pose.height / meshReferenceHeight) : 1.0f;
+            capsule = hitMesh.boundingCapsule();
+            capsule.radius *= uniformScale;
+            capsule.minY *= uniformScale;
+            capsule.maxY *= uniformScale;
+        }
+        else {
+            const float sx = (hitboxReferenceRadius > 1e-4f) ? (candidate.pose.radius / hitboxReferenceRadius) : 1.0f;
+            const float sy = (hitboxReferenceHeight > 1e-4f) ? (candidate.pose.height / hitboxReferenceHeight) : 1.0f;
+            capsule = baseHitboxCapsule;
+            capsule.radius = capsule.radius * sx + kShootHitboxPadXZ * 1.4142136f;
+            capsule.minY = capsule.minY * sy - kShootHitboxPadY;
+            capsule.maxY = capsule.maxY * sy + kShootHitboxPadY;
+        }
+        if (RayHitsCapsule(rayOrigin, rayDir, maxDistance, candidate.pose.position, capsule, candidate.enterDistance)) {
+            candidates.push_back(candidate);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const ShotCandidate& lhs, const ShotCandidate& rhs) {
+        return lhs.enterDistance < rhs.enterDistance;
+    });
+
+    for (const ShotCandidate& candidate : candidates) {
+        if (playerHit && candidate.enterDistance > bestPlayerDistance) {
+            break;
         }
+        const glm::vec3& targetPosition = candidate.pose.position;
+        const float targetYaw = candidate.pose.yaw;
+        const float targetHeight = candidate.pose.height;
+        const float targetRadius = candidate.pose.radius;
 
         const glm::mat4 targetModel = BuildPlayerModelMatrix(targetPosition, targetYaw);
-        float meshReferenceHeight = 0.0f;
-        const std::vector<MeshHitTriangle>& meshTriangles = GetSharedPlayerMeshHitTriangles(meshReferenceHeight);
         HitResult hit;
-        if (!meshTriangles.empty()) {
+        if (!hitMesh.empty()) {
             const float uniformScale = (meshReferenceHeight > 1e-4f) ? (targetHeight / meshReferenceHeight) : 1.0f;
-            hit = RaycastMeshTriangles(rayOrigin, rayDir, meshTriangles, targetModel, uniformScale, maxDistance);
+            hit = RaycastPlayerHitMesh(rayOrigin, rayDir, hitMesh, targetModel, uniformScale, maxDistance);
         }
         else {
-            float referenceHeight = 0.0f;
-            float referenceRadius = 0.0f;
-            const std::vector<Hitbox>& baseHitboxes =
-                GetSharedPlayerHitboxes(referenceHeight, referenceRadius);
-            const float sx = (referenceRadius > 1e-4f) ? (targetRadius / referenceRadius) : 1.0f;
-            const float sy = (referenceHeight > 1e-4f) ? (targetHeight / referenceHeight) : 1.0f;
+            const float sx = (hitboxReferenceRadius > 1e-4f) ? (targetRadius / hitboxReferenceRadius) : 1.0f;
+            const float sy = (hitboxReferenceHeight > 1e-4f) ? (targetHeight / hitboxReferenceHeight) : 1.0f;
             const float sz = sx;
 
-            std::vector<Hitbox> scaledHitboxes;
-            scaledHitboxes.reserve(baseHitboxes.size());
-            for (const Hitbox& base : baseHitboxes) {
+            scaledHitboxes.clear();
+            for (const Hitbox& base : *baseHitboxes) {
                 Hitbox scaled = base;
                 scaled.min = glm::vec3(
                     base.min.x * sx - kShootHitboxPadXZ,
@@ -2256,7 +2233,7 @@ void ServerNetwork::HandleShootRequestPacket(HSteamNetConnection incoming, const
             : HitRegion::Unknown;
         if (kEnableShootValidationLogs && hit.hit) {
             std::cout
-                << "[shoot/validate] candidate player=" << target.id
+                << "[shoot/validate] candidate player=" << candidate.id
                 << " dist=" << hit.distance
                 << " region=" << HitRegionName(resolvedRegion)
                 << " hit=(" << hit.hitPointWorld.x << "," << hit.hitPointWorld.y << "," << hit.hitPointWorld.z << ")"
@@ -2264,7 +2241,7 @@ void ServerNetwork::HandleShootRequestPacket(HSteamNetConnection incoming, const
         }
         if (hit.hit && hit.distance < bestPlayerDistance) {
             playerHit = true;
-            hitPlayerId = target.id;
+            hitPlayerId = candidate.id;
             hitRegion = resolvedRegion;
             hitPoint = hit.hitPointWorld;
             bestPlayerDistance = hit.distance;
@@ -2416,12 +2393,13 @@ void ServerNetwork::SpawnDroppedItem(PlayerID dropperId, uint16_t itemId, uint16
         return;
     }
 
-    const std::optional<ServerPlayer> playerOpt = m_playerManager.getPlayerCopy(dropperId);
-    if (!playerOpt.has_value()) {
+    const PlayerKinematicsBuffer::View players = m_playerManager.publishedPlayers();
+    const PlayerKinematics* dropper = players.find(dropperId);
+    if (dropper == nullptr) {
         return;
     }
 
-    const ServerPlayer& player = *playerOpt;
+    const PlayerKinematics& player = *dropper;
     const float yawRad = glm::radians(player.yaw);
     const glm::vec3 forward(std::cos(yawRad), 0.0f, std::sin(yawRad));
 
@@ -2477,7 +2455,7 @@ void ServerNetwork::UpdateWorldItems(double deltaSeconds)
         WorldItemPhysicsSystem::kPickupRadius * WorldItemPhysicsSystem::kPickupRadius;
     std::unordered_set<PlayerID> inventoryChangedPlayers;
 
-    const std::vector<ServerPlayer> players = m_playerManager.getAllPlayersCopy();
+    const PlayerKinematicsBuffer::View players = m_playerManager.publishedPlayers();
 
     for (auto it = m_worldItems.begin(); it != m_worldItems.end();) {
         WorldItemEntity& item = it->second;
@@ -2488,10 +2466,10 @@ void ServerNetwork::UpdateWorldItems(double deltaSeconds)
             continue;
         }
 
-        WorldItemPhysicsSystem::Step(item, dt, static_cast<float>(kServerTickRateHz), m_chunkManager);
+        WorldItemPhysicsSystem::Step(item, dt, static_cast<float>(m_tickRateHz), m_chunkManager);
 
         if (item.pickupCooldownSeconds <= 0.0f) {
-            for (const ServerPlayer& player : players) {
+            for (const PlayerKinematics& player : players) {
                 if (!player.isAlive) {
                     continue;
                 }
@@ -2530,60 +2508,68 @@ void ServerNetwork::UpdateWorldItems(double deltaSeconds)
     }
 }
 
-void ServerNetwork::SendWorldItemSnapshots(
+void ServerNetwork::BuildWorldItemSnapshots(
     const std::vector<std::pair<HSteamNetConnection, PlayerID>>& recipients,
-    uint32_t serverTick
+    uint32_t serverTick,
+    std::vector<std::vector<uint8_t>>& outFrames
 ) {
-    for (const auto& [conn, playerId] : recipients) {
-        const std::optional<ServerPlayer> playerOpt = m_playerManager.getPlayerCopy(playerId);
-        if (!playerOpt.has_value()) {
-            continue;
-        }
-
-        WorldItemSnapshot snapshot{};
-        snapshot.serverTick = serverTick;
-        const glm::vec3 playerPos = playerOpt->position;
-        constexpr float kItemReplicateRadius = 40.0f;
-        const float radiusSq = kItemReplicateRadius * kItemReplicateRadius;
-
-        snapshot.items.reserve(m_worldItems.size());
-        for (const auto& [_, item] : m_worldItems) {
-            const glm::vec3 delta = item.position - playerPos;
-            if (glm::dot(delta, delta) > radiusSq) {
-                continue;
+    constexpr float kItemReplicateRadius = 40.0f;
+    constexpr size_t kMinRecipientsForParallelEncode = 8;
+    constexpr size_t kEncodeGrain = 2;
+
+    outFrames.resize(recipients.size());
+    for (std::vector<uint8_t>& frame : outFrames) {
+        frame.clear();
+    }
+
+    m_worldItemGrid.clear();
+    m_worldItemIndex.clear();
+    for (const auto& [_, item] : m_worldItems) {
+        m_worldItemGrid.insert(static_cast<uint32_t>(m_worldItemIndex.size()), item.position);
+        m_worldItemIndex.push_back(&item);
+    }
+    m_worldItemGrid.build();
+
+    const PlayerKinematicsBuffer::View players = m_playerManager.publishedPlayers();
+    m_playerManager.workerPool().run(
+        recipients.size(),
+        kEncodeGrain,
+        kMinRecipientsForParallelEncode,
+        [this, &recipients, &outFrames, &players, serverTick](size_t index) {
+            const PlayerKinematics* player = players.find(recipients[index].second);
+            if (player == nullptr) {
+                return;
             }
-            WorldItemState state{};
-            state.id = item.id;
-            state.itemId = item.itemId;
-            state.quantity = item.quantity;
-            state.px = item.position.x;
-            state.py = item.position.y;
-            state.pz = item.position.z;
-            state.vx = item.velocity.x;
-            state.vy = item.velocity.y;
-            state.vz = item.velocity.z;
-            snapshot.items.push_back(state);
-        }
 
-        const std::vector<uint8_t> bytes = snapshot.serialize();
-        (void)SteamNetworkingSockets()->SendMessageToConnection(
-            conn,
-            bytes.data(),
-            static_cast<uint32_t>(bytes.size()),
-            k_nSteamNetworkingSend_UnreliableNoDelay,
-            nullptr
-        );
-    }
+            thread_local std::vector<InterestGrid::Hit> hits;
+            thread_local WorldItemSnapshot snapshot;
+            hits.clear();
+            m_worldItemGrid.query(player->position, kItemReplicateRadius, hits);
+
+            snapshot.serverTick = serverTick;
+            snapshot.items.clear();
+            snapshot.items.reserve(hits.size());
+            for (const InterestGrid::Hit& hit : hits) {
+                const WorldItemEntity& item = *m_worldItemIndex[hit.index];
+                WorldItemState state{};
+                state.id = item.id;
+                state.itemId = item.itemId;
+                state.quantity = item.quantity;
+                state.px = item.position.x;
+                state.py = item.position.y;
+                state.pz = item.position.z;
+                state.vx = item.velocity.x;
+                state.vy = item.velocity.y;
+                state.vz = item.velocity.z;
+                snapshot.items.push_back(state);
+            }
+            snapshot.serialize(outFrames[index]);
+        }
+    );
 }
 
-void ServerNetwork::HandleInventoryActionRequestPacket(HSteamNetConnection incoming, const void* data, uint32_t size)
+void ServerNetwork::HandleInventoryActionRequestPacket(HSteamNetConnection incoming, const InventoryActionRequest& request)
 {
-    InventoryActionRequest request{};
-    if (!ParseInventoryActionRequestPacket(reinterpret_cast<const uint8_t*>(data), size, request)) {
-        std::cerr << "[recv] malformed InventoryActionRequest\n";
-        return;
-    }
-
     PlayerID playerId = 0;
     {
         std::lock_guard<std::mutex> lk(m_mutex);
@@ -2658,42 +2644,211 @@ void ServerNetwork::HandleInventoryActionRequestPacket(HSteamNetConnection incom
     }
 }
 
-void ServerNetwork::DispatchInboundPacket(
-    HSteamNetConnection incoming,
-    PacketType packetType,
-    const void* data,
-    uint32_t size,
+void ServerNetwork::StartNetIoThread()
+{
+    m_netIoStop.store(false, std::memory_order_release);
+    m_netIoThread = std::thread([this]() { NetIoLoop(); });
+}
+
+void ServerNetwork::StopNetIoThread()
+{
+    m_netIoStop.store(true, std::memory_order_release);
+    if (m_netIoThread.joinable()) {
+        m_netIoThread.join();
+    }
+}
+
+void ServerNetwork::NetIoLoop()
+{
+    constexpr int kReceiveBatch = 64;
+    constexpr auto kIdleSleep = std::chrono::microseconds(200);
+    constexpr auto kRingCachePruneInterval = std::chrono::seconds(1);
+
+    // Rings this thread produces into. Entries are dropped once the simulation thread retires
+    // the connection, so a recycled handle gets a fresh ring.
+    std::unordered_map<HSteamNetConnection, std::shared_ptr<InboundCommandQueues::Ring>> rings;
+    auto nextPruneAt = std::chrono::steady_clock::now() + kRingCachePruneInterval;
+    SteamNetworkingMessage_t* messages[kReceiveBatch];
+    InboundCommand command;
+
+    while (!m_netIoStop.load(std::memory_order_acquire)) {
+        const int received = SteamNetworkingSockets()->ReceiveMessagesOnPollGroup(m_pollGroup, messages, kReceiveBatch);
+        if (received <= 0) {
+            std::this_thread::sleep_for(kIdleSleep);
+        }
+
+        for (int i = 0; i < received; ++i) {
+            SteamNetworkingMessage_t* pMsg = messages[i];
+            const HSteamNetConnection incoming = pMsg->m_conn;
+            const void* data = pMsg->m_pData;
+            const uint32_t cb = pMsg->m_cbSize;
+
+            if (cb < 1 || cb > kMaxInboundPacketBytes) {
+                std::cerr
+                    << "[recv] invalid packet size=" << cb
+                    << " conn=" << incoming
+                    << " (closing connection)\n";
+                SteamNetworkingSockets()->CloseConnection(incoming, 0, "invalid packet size", false);
+                pMsg->Release();
+                continue;
+            }
+
+            const PacketType packetType = static_cast<PacketType>(reinterpret_cast<const uint8_t*>(data)[0]);
+            if (!IsInboundPacketSizeValid(packetType, cb)) {
+                std::cerr
+                    << "[recv] packet size/type mismatch type=" << static_cast<int>(packetType)
+                    << " size=" << cb
+                    << " conn=" << incoming << "\n";
+                pMsg->Release();
+                continue;
+            }
+
+            if (IsInboundRateLimitExceeded(incoming, packetType, cb)) {
+                pMsg->Release();
+                continue;
+            }
+
+            const bool parsed = ParseInboundCommand(packetType, data, cb, command);
+            pMsg->Release();
+            if (!parsed) {
+                continue;
+            }
+
+            std::shared_ptr<InboundCommandQueues::Ring>& ring = rings[incoming];
+            if (!ring || ring->retired.load(std::memory_order_acquire)) {
+                ring = m_inboundCommands.acquire(incoming);
+            }
+            if (!ring->commands.push(command)) {
+                const uint64_t dropped = m_inboundCommandsDropped.fetch_add(1, std::memory_order_relaxed) + 1;
+                if ((dropped & 0xFFu) == 1u) {
+                    std::cerr
+                        << "[recv] inbound queue full conn=" << incoming
+                        << " type=" << static_cast<int>(packetType)
+                        << " droppedTotal=" << dropped << "\n";
+                }
+            }
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= nextPruneAt) {
+            nextPruneAt = now + kRingCachePruneInterval;
+            for (auto it = rings.begin(); it != rings.end();) {
+                if (!it->second || it->second->retired.load(std::memory_order_acquire)) {
+                    it = rings.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    }
+}
+
+void ServerNetwork::DrainInboundCommands(
+    uint64_t& commandsThisLoop,
     uint64_t& playerInputPacketsThisLoop,
     uint64_t& chunkRequestPacketsThisLoop
 )
 {
-    switch (packetType) {
+    // Bounded per connection so one flooding client cannot delay the tick for everyone else, and
+    // in total so a burst across many connections cannot either; anything left stays queued for
+    // the next loop, which starts at the connection this one stopped on.
+    m_inboundCommands.list(m_inboundRingScratch);
+    const size_t ringCount = m_inboundRingScratch.size();
+    size_t firstRing = 0;
+    for (size_t r = 0; r < ringCount; ++r) {
+        if (m_inboundRingScratch[r].first == m_inboundDrainResume) {
+            firstRing = r;
+            break;
+        }
+    }
+
+    const auto drainStart = std::chrono::steady_clock::now();
+    size_t drained = 0;
+    bool outOfBudget = false;
+    InboundCommand command;
+    for (size_t r = 0; r < ringCount && !outOfBudget; ++r) {
+        const auto& [conn, ring] = m_inboundRingScratch[(firstRing + r) % ringCount];
+        for (size_t i = 0; i < kMaxInboundCommandsPerConnection; ++i) {
+            if (ring->retired.load(std::memory_order_acquire) || ring->commands.empty()) {
+                break;
+            }
+            const int64_t elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - drainStart
+            ).count();
+            if (drained >= kMaxInboundCommandsPerLoop || elapsedUs >= kInboundCommandBudgetUs) {
+                m_inboundDrainResume = conn;
+                outOfBudget = true;
+                break;
+            }
+            if (!ring->commands.pop(command)) {
+                break;
+            }
+            ++drained;
+            ++commandsThisLoop;
+            if (command.type == PacketType::PlayerInput) {
+                ++playerInputPacketsThisLoop;
+            } else if (command.type == PacketType::ChunkRequest) {
+                ++chunkRequestPacketsThisLoop;
+            }
+            DispatchInboundCommand(conn, command);
+        }
+    }
+    if (!outOfBudget && ringCount > 0) {
+        // everything fit: still rotate who goes first
+        m_inboundDrainResume = m_inboundRingScratch[(firstRing + 1) % ringCount].first;
+    }
+
+    // A packet that raced a disconnect can recreate a ring after its connection was removed;
+    // retire such leftovers once they have been drained.
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (m_inboundRingScratch.size() > m_clients.size()) {
+            for (const auto& [conn, ring] : m_inboundRingScratch) {
+                if (m_clients.find(conn) == m_clients.end()) {
+                    m_inboundCommands.remove(conn);
+                }
+            }
+        }
+    }
+    m_inboundRingScratch.clear();
+}
+
+void ServerNetwork::DispatchInboundCommand(HSteamNetConnection incoming, const InboundCommand& command)
+{
+    switch (command.type) {
     case PacketType::ConnectRequest:
-        HandleConnectRequest(incoming, data, size);
+        HandleConnectRequest(incoming, std::get_if<ConnectRequest>(&command.payload));
         return;
     case PacketType::Message:
-        HandleMessagePacket(incoming, data, size);
+        if (const std::string* msg = std::get_if<std::string>(&command.payload)) {
+            HandleMessagePacket(incoming, *msg);
+        }
         return;
     case PacketType::PlayerInput:
-        HandlePlayerInputPacket(incoming, data, size, playerInputPacketsThisLoop);
-        return;
-    case PacketType::PlayerPosition:
-        // Legacy packet still accepted on the wire but ignored by authoritative movement.
+        if (const PlayerInput* input = std::get_if<PlayerInput>(&command.payload)) {
+            HandlePlayerInputPacket(incoming, *input);
+        }
         return;
     case PacketType::ChunkRequest:
-        HandleChunkRequestPacket(incoming, data, size, chunkRequestPacketsThisLoop);
+        if (const ChunkRequest* req = std::get_if<ChunkRequest>(&command.payload)) {
+            HandleChunkRequestPacket(incoming, *req);
+        }
         return;
     case PacketType::BlockPlaceRequest:
-        HandleBlockPlaceRequestPacket(incoming, data, size);
+        HandleBlockPlaceRequestPacket(incoming, std::get_if<BlockPlaceRequest>(&command.payload));
         return;
     case PacketType::BlockBreakRequest:
-        HandleBlockBreakRequestPacket(incoming, data, size);
+        HandleBlockBreakRequestPacket(incoming, std::get_if<BlockBreakRequest>(&command.payload));
         return;
-	case PacketType::ShootRequest:
-        HandleShootRequestPacket(incoming, data, size);
+    case PacketType::ShootRequest:
+        if (const ShootRequest* req = std::get_if<ShootRequest>(&command.payload)) {
+            HandleShootRequestPacket(incoming, *req);
+        }
         return;
     case PacketType::InventoryActionRequest:
-        HandleInventoryActionRequestPacket(incoming, data, size);
+        if (const InventoryActionRequest* request = std::get_if<InventoryActionRequest>(&command.payload)) {
+            HandleInventoryActionRequestPacket(incoming, *request);
+        }
         return;
     default:
         return;
@@ -2702,27 +2857,27 @@ void ServerNetwork::DispatchInboundPacket(
 
 void ServerNetwork::MainLoop()
 {
-    auto lastFrameTime = std::chrono::steady_clock::now();
-    auto lastSnapshotTime = lastFrameTime;
-    constexpr double kServerTickSeconds = 1.0 / static_cast<double>(kServerTickRateHz);
+    TickScheduler tickScheduler(m_tickRateHz);
+    const double serverTickSeconds = tickScheduler.tickSeconds();
     constexpr uint32_t kSnapshotSendRateHz = 60u;  // Match server tick rate for smooth reconciliation (CS:GO/Valorant style)
-    constexpr double kSnapshotSendSeconds = 1.0 / static_cast<double>(kSnapshotSendRateHz);
+    // Snapshots ride on simulated ticks so they stay evenly spaced whatever the tick rate.
+    const uint32_t snapshotEveryTicks = std::max<uint32_t>(
+        1u,
+        (tickScheduler.tickRateHz() + kSnapshotSendRateHz / 2u) / kSnapshotSendRateHz
+    );
+    uint32_t nextSnapshotTick = 0;
     constexpr size_t kMaxSimCatchupTicksPerLoop = 4;
     constexpr size_t kChunkInterestUpdatesPerLoop = 4;
-    constexpr size_t kMaxInboundMessagesPerLoop = 256;
-    constexpr int64_t kInboundMessageBudgetUs = 3000;
     const auto kChunkInterestUpdateInterval = std::chrono::milliseconds(100);
     constexpr int kCollisionPrewarmRadiusXZ = 1;
     constexpr int kCollisionPrewarmRadiusY = 1;
-    constexpr size_t kMaxCollisionPrewarmGenerationsPerLoop = 8;
+    constexpr size_t kMaxCollisionPrewarmRequestsPerLoop = 8;
     constexpr int64_t kCollisionPrewarmBudgetUs = 1500;
     const auto kCollisionPrewarmInterval = std::chrono::milliseconds(50);
     constexpr size_t kChunkSendGlobalBudgetPerFlush = 8;
     constexpr size_t kChunkSendPerClientBudgetPerFlush = 4;
     const auto kChunkSendFlushInterval = std::chrono::milliseconds(16);
     const auto kScoreboardBroadcastInterval = std::chrono::seconds(1);
-    const auto snapshotInterval = std::chrono::duration<double>(kSnapshotSendSeconds);
-    double simAccumulator = 0.0;
     uint32_t serverTick = 0;
     auto nextChunkSendFlushAt = std::chrono::steady_clock::now();
     auto nextCollisionPrewarmAt = std::chrono::steady_clock::now();
@@ -2732,7 +2887,7 @@ void ServerNetwork::MainLoop()
     uint64_t perfPlayerInputs = 0;
     uint64_t perfChunkRequests = 0;
     uint64_t perfSimTicks = 0;
-    uint64_t perfCollisionPrewarmGenerated = 0;
+    uint64_t perfCollisionPrewarmRequested = 0;
     uint64_t perfChunkInterestTasks = 0;
     uint64_t perfChunksSent = 0;
     uint64_t perfScoreboardBroadcasts = 0;
@@ -2742,6 +2897,8 @@ void ServerNetwork::MainLoop()
     double perfSimUsTotal = 0.0;
     double perfCollisionPrewarmUsTotal = 0.0;
     double perfSnapshotUsTotal = 0.0;
+    double perfSnapshotEncodeUsTotal = 0.0;
+    double perfSnapshotSubmitUsTotal = 0.0;
     double perfChunkInterestUsTotal = 0.0;
     double perfChunkSendUsTotal = 0.0;
     auto nextScoreboardBroadcastAt = std::chrono::steady_clock::now();
@@ -2752,85 +2909,13 @@ void ServerNetwork::MainLoop()
         uint64_t playerInputPacketsThisLoop = 0;
         uint64_t chunkRequestPacketsThisLoop = 0;
 
-        const auto frameNow = std::chrono::steady_clock::now();
-        double deltaSeconds = std::chrono::duration<double>(frameNow - lastFrameTime).count();
-        if (deltaSeconds > 0.25) {
-            deltaSeconds = 0.25;
-        }
-        lastFrameTime = frameNow;
-        simAccumulator += deltaSeconds;
+        const size_t dueTicks = tickScheduler.consumeDueTicks(loopStart, kMaxSimCatchupTicksPerLoop);
 
         SteamNetworkingSockets()->RunCallbacks();
 
-        // Receive messages on poll group (any connection assigned to it).
-        // Drain with a bounded budget so message bursts do not starve simulation ticks.
+        // Packets are received and parsed on the network I/O thread; apply what it queued.
         const auto messageDrainStart = std::chrono::steady_clock::now();
-        SteamNetworkingMessage_t* pMsg = nullptr;
-        size_t inboundMessagesProcessed = 0;
-        const auto reachedMessageDrainBudget = [&]() {
-            ++inboundMessagesProcessed;
-            const int64_t elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
-                std::chrono::steady_clock::now() - messageDrainStart
-            ).count();
-            return elapsedUs >= kInboundMessageBudgetUs;
-        };
-        while (
-            inboundMessagesProcessed < kMaxInboundMessagesPerLoop &&
-            SteamNetworkingSockets()->ReceiveMessagesOnPollGroup(m_pollGroup, &pMsg, 1) > 0 &&
-            pMsg
-        ) {
-            HSteamNetConnection incoming = pMsg->m_conn;
-            const void* data = pMsg->m_pData;
-            const uint32_t cb = pMsg->m_cbSize;
-
-            if (cb < 1 || cb > kMaxInboundPacketBytes) {
-                std::cerr
-                    << "[recv] invalid packet size=" << cb
-                    << " conn=" << incoming
-                    << " (closing connection)\n";
-                SteamNetworkingSockets()->CloseConnection(incoming, 0, "invalid packet size", false);
-                pMsg->Release();
-                if (reachedMessageDrainBudget()) {
-                    break;
-                }
-                continue;
-            }
-
-            const PacketType packetType = static_cast<PacketType>(reinterpret_cast<const uint8_t*>(data)[0]);
-            if (!IsInboundPacketSizeValid(packetType, cb)) {
-                std::cerr
-                    << "[recv] packet size/type mismatch type=" << static_cast<int>(packetType)
-                    << " size=" << cb
-                    << " conn=" << incoming << "\n";
-                pMsg->Release();
-                if (reachedMessageDrainBudget()) {
-                    break;
-                }
-                continue;
-            }
-
-            if (IsInboundRateLimitExceeded(incoming, packetType, cb)) {
-                pMsg->Release();
-                if (reachedMessageDrainBudget()) {
-                    break;
-                }
-                continue;
-            }
-
-            ++msgPacketsThisLoop;
-            DispatchInboundPacket(
-                incoming,
-                packetType,
-                data,
-                cb,
-                playerInputPacketsThisLoop,
-                chunkRequestPacketsThisLoop
-            );
-            pMsg->Release();
-            if (reachedMessageDrainBudget()) {
-                break;
-            }
-        }
+        DrainInboundCommands(msgPacketsThisLoop, playerInputPacketsThisLoop, chunkRequestPacketsThisLoop);
 
         // Optional: extra safeguard - check connection states for any connections left (callback already handles most)
         std::vector<std::pair<HSteamNetConnection, ClientSession>> staleConnections;
@@ -2852,6 +2937,7 @@ void ServerNetwork::MainLoop()
         for (const auto& [conn, session] : staleConnections) {
             std::cout << "[cleanup] remove conn=" << conn << " user=" << session.username << "\n";
             ClearChunkPipelineForConnection(conn);
+            m_inboundCommands.remove(conn);
             if (session.playerId != 0) {
                 {
                     std::lock_guard<std::mutex> lk(m_mutex);
@@ -2875,15 +2961,13 @@ void ServerNetwork::MainLoop()
 
         const auto simStart = std::chrono::steady_clock::now();
         uint64_t simTicksThisLoop = 0;
-        while (
-            simAccumulator >= kServerTickSeconds &&
-            simTicksThisLoop < kMaxSimCatchupTicksPerLoop
-        ) {
-            m_playerManager.update(kServerTickSeconds, m_chunkManager);
-            UpdateWorldItems(kServerTickSeconds);
-            simAccumulator -= kServerTickSeconds;
+        while (simTicksThisLoop < dueTicks) {
+            tickScheduler.markTickStart(std::chrono::steady_clock::now());
+            m_playerManager.update(serverTickSeconds, m_chunkManager);
+            UpdateWorldItems(serverTickSeconds);
             ++serverTick;
             m_serverTick.store(serverTick, std::memory_order_release);
+            ServerChunk::setAccessEpoch(serverTick);
             RecordLagCompFrame(serverTick);
             ++simTicksThisLoop;
         }
@@ -2892,16 +2976,17 @@ void ServerNetwork::MainLoop()
                 std::chrono::steady_clock::now() - simStart
             ).count()
         );
-        const bool simBacklog = (simAccumulator >= kServerTickSeconds);
-        size_t collisionPrewarmGeneratedThisLoop = 0;
+        const bool simBacklog = tickScheduler.isBehind(std::chrono::steady_clock::now());
+        size_t collisionPrewarmRequestedThisLoop = 0;
         double collisionPrewarmUs = 0.0;
 
-        const auto snapshotNow = std::chrono::steady_clock::now();
         const auto snapshotStart = std::chrono::steady_clock::now();
         bool snapshotRan = false;
-        if (snapshotNow - lastSnapshotTime >= snapshotInterval) {
+        double snapshotEncodeUs = 0.0;
+        double snapshotSubmitUs = 0.0;
+        if (simTicksThisLoop > 0 && serverTick >= nextSnapshotTick) {
             snapshotRan = true;
-            lastSnapshotTime = snapshotNow;
+            nextSnapshotTick = serverTick + snapshotEveryTicks;
 
             std::vector<std::pair<HSteamNetConnection, PlayerID>> recipients;
             {
@@ -2920,32 +3005,63 @@ void ServerNetwork::MainLoop()
             for (const auto& [_, playerId] : recipients) {
                 recipientIds.push_back(playerId);
             }
-            std::vector<std::vector<uint8_t>> snapshots =
-                m_playerManager.buildSnapshotsForRecipients(recipientIds, serverTick);
 
-            const size_t snapshotCount = std::min(recipients.size(), snapshots.size());
+            // Encode: every recipient's frames, fanned out over the worker pool.
+            m_playerManager.buildSnapshotsForRecipients(recipientIds, serverTick, m_playerSnapshotFrames);
             std::vector<std::pair<HSteamNetConnection, PlayerID>> activeRecipients;
-            activeRecipients.reserve(snapshotCount);
-            for (size_t i = 0; i < snapshotCount; ++i) {
-                const HSteamNetConnection conn = recipients[i].first;
-                const PlayerID recipientPlayerId = recipients[i].second;
-                std::vector<uint8_t>& snapshot = snapshots[i];
-                if (snapshot.empty()) {
-                    staleRecipients.push_back(conn);
+            std::vector<size_t> activeFrameIndices;
+            activeRecipients.reserve(recipients.size());
+            activeFrameIndices.reserve(recipients.size());
+            for (size_t i = 0; i < recipients.size(); ++i) {
+                if (m_playerSnapshotFrames[i].empty()) {
+                    staleRecipients.push_back(recipients[i].first);
+                    continue;
+                }
+                activeRecipients.push_back(recipients[i]);
+                activeFrameIndices.push_back(i);
+            }
+            BuildWorldItemSnapshots(activeRecipients, serverTick, m_worldItemSnapshotFrames);
+            const auto snapshotSubmitStart = std::chrono::steady_clock::now();
+            snapshotEncodeUs = static_cast<double>(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    snapshotSubmitStart - snapshotStart
+                ).count()
+            );
+
+            // Submit: hand the encoded buffers to GNS without copying, in a single call.
+            m_outboundSnapshotMessages.clear();
+            for (size_t i = 0; i < activeRecipients.size(); ++i) {
+                const HSteamNetConnection conn = activeRecipients[i].first;
+                if (SteamNetworkingMessage_t* message = m_snapshotBufferPool.wrap(
+                        conn,
+                        k_nSteamNetworkingSend_UnreliableNoDelay,
+                        m_playerSnapshotFrames[activeFrameIndices[i]])) {
+                    m_outboundSnapshotMessages.push_back(message);
+                }
+                std::vector<uint8_t>& itemFrame = m_worldItemSnapshotFrames[i];
+                if (itemFrame.empty()) {
                     continue;
                 }
-                activeRecipients.emplace_back(conn, recipientPlayerId);
-                SteamNetworkingSockets()->SendMessageToConnection(
-                    conn,
-                    snapshot.data(),
-                    static_cast<uint32_t>(snapshot.size()),
-                    k_nSteamNetworkingSend_UnreliableNoDelay,
+                if (SteamNetworkingMessage_t* message = m_snapshotBufferPool.wrap(
+                        conn,
+                        k_nSteamNetworkingSend_UnreliableNoDelay,
+                        itemFrame)) {
+                    m_outboundSnapshotMessages.push_back(message);
+                }
+            }
+            if (!m_outboundSnapshotMessages.empty()) {
+                // Unreliable snapshots are fire-and-forget; per-message results are not needed.
+                SteamNetworkingSockets()->SendMessages(
+                    static_cast<int>(m_outboundSnapshotMessages.size()),
+                    m_outboundSnapshotMessages.data(),
                     nullptr
                 );
             }
-            if (!activeRecipients.empty()) {
-                SendWorldItemSnapshots(activeRecipients, serverTick);
-            }
+            snapshotSubmitUs = static_cast<double>(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - snapshotSubmitStart
+                ).count()
+            );
 
             if (!staleRecipients.empty()) {
                 std::vector<std::pair<HSteamNetConnection, ClientSession>> removedSessions;
@@ -2962,6 +3078,7 @@ void ServerNetwork::MainLoop()
 
                 for (const auto& [conn, session] : removedSessions) {
                     ClearChunkPipelineForConnection(conn);
+                    m_inboundCommands.remove(conn);
                     if (session.playerId != 0) {
                         std::lock_guard<std::mutex> lk(m_mutex);
                         m_matchScores.erase(session.playerId);
@@ -3220,8 +3337,9 @@ void ServerNetwork::MainLoop()
                     }
                 }
 
+                const PlayerKinematicsBuffer::View publishedPlayers = m_playerManager.publishedPlayers();
                 for (PlayerID playerId : activePlayerIds) {
-                    if (collisionPrewarmGeneratedThisLoop >= kMaxCollisionPrewarmGenerationsPerLoop) {
+                    if (collisionPrewarmRequestedThisLoop >= kMaxCollisionPrewarmRequestsPerLoop) {
                         break;
                     }
                     const int64_t elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
@@ -3231,16 +3349,15 @@ void ServerNetwork::MainLoop()
                         break;
                     }
 
-                    const auto playerOpt = m_playerManager.getPlayerCopy(playerId);
-                    if (!playerOpt.has_value()) {
+                    const PlayerKinematics* player = publishedPlayers.find(playerId);
+                    if (player == nullptr) {
                         continue;
                     }
 
-                    const ServerPlayer& player = *playerOpt;
                     const glm::ivec3 playerWorldPos(
-                        static_cast<int>(std::floor(player.position.x)),
-                        static_cast<int>(std::floor(player.position.y)),
-                        static_cast<int>(std::floor(player.position.z))
+                        static_cast<int>(std::floor(player->position.x)),
+                        static_cast<int>(std::floor(player->position.y)),
+                        static_cast<int>(std::floor(player->position.z))
                     );
                     const glm::ivec3 centerChunk = m_chunkManager.worldToChunkPos(playerWorldPos);
 
@@ -3263,9 +3380,10 @@ void ServerNetwork::MainLoop()
                                 if (m_chunkManager.hasChunkLoaded(chunkPos)) {
                                     continue;
                                 }
-                                m_chunkManager.generateTerrainChunkAt(chunkPos);
-                                ++collisionPrewarmGeneratedThisLoop;
-                                if (collisionPrewarmGeneratedThisLoop >= kMaxCollisionPrewarmGenerationsPerLoop) {
+                                // Generation runs on the prep workers; the tick never waits for it.
+                                (void)m_chunkManager.ensureChunkLoadedAsync(chunkPos);
+                                ++collisionPrewarmRequestedThisLoop;
+                                if (collisionPrewarmRequestedThisLoop >= kMaxCollisionPrewarmRequestsPerLoop) {
                                     hitLoopBudget = true;
                                     break;
                                 }
@@ -3299,7 +3417,7 @@ void ServerNetwork::MainLoop()
         perfPlayerInputs += playerInputPacketsThisLoop;
         perfChunkRequests += chunkRequestPacketsThisLoop;
         perfSimTicks += simTicksThisLoop;
-        perfCollisionPrewarmGenerated += collisionPrewarmGeneratedThisLoop;
+        perfCollisionPrewarmRequested += collisionPrewarmRequestedThisLoop;
         perfChunkInterestTasks += chunkInterestTasks.size();
         perfChunksSent += chunksSentThisLoop;
         if (scoreboardBroadcastedThisLoop) {
@@ -3310,6 +3428,8 @@ void ServerNetwork::MainLoop()
         perfSimUsTotal += simUs;
         perfCollisionPrewarmUsTotal += collisionPrewarmUs;
         perfSnapshotUsTotal += snapshotUs;
+        perfSnapshotEncodeUsTotal += snapshotEncodeUs;
+        perfSnapshotSubmitUsTotal += snapshotSubmitUs;
         perfChunkInterestUsTotal += chunkInterestUs;
         perfChunkSendUsTotal += chunkSendUs;
 
@@ -3321,41 +3441,59 @@ void ServerNetwork::MainLoop()
                 << " msgDrainUs=" << messageDrainUs
                 << " prewarmUs=" << collisionPrewarmUs
                 << " snapshotUs=" << snapshotUs
+                << " snapshotEncodeUs=" << snapshotEncodeUs
+                << " snapshotSubmitUs=" << snapshotSubmitUs
                 << " chunkInterestUs=" << chunkInterestUs
                 << " chunkSendUs=" << chunkSendUs
                 << " simTicks=" << simTicksThisLoop
                 << " msgs=" << msgPacketsThisLoop
                 << " inputs=" << playerInputPacketsThisLoop
                 << " chunkReq=" << chunkRequestPacketsThisLoop
-                << " prewarmGenerated=" << collisionPrewarmGeneratedThisLoop
+                << " prewarmRequested=" << collisionPrewarmRequestedThisLoop
                 << " chunkInterestTasks=" << chunkInterestTasks.size()
                 << " chunksSent=" << chunksSentThisLoop
                 << "\n";
         }
 
         const auto perfNow = std::chrono::steady_clock::now();
-        if (g_enableServerPerfDiagnostics.load(std::memory_order_acquire) &&
-            (perfNow - perfWindowStart) >= kServerPerfLogInterval) {
-            const double loops = (perfLoops > 0) ? static_cast<double>(perfLoops) : 1.0;
-            std::cerr
-                << "[perf/server] 1s loops=" << perfLoops
-                << " avgLoopMs=" << (perfLoopUsTotal / loops) / 1000.0
-                << " maxLoopMs=" << perfLoopUsMax / 1000.0
-                << " avgMsgDrainMs=" << (perfMessageDrainUsTotal / loops) / 1000.0
-                << " avgSimMs=" << (perfSimUsTotal / loops) / 1000.0
-                << " avgPrewarmMs=" << (perfCollisionPrewarmUsTotal / loops) / 1000.0
-                << " avgSnapshotMs=" << (perfSnapshotUsTotal / loops) / 1000.0
-                << " avgChunkInterestMs=" << (perfChunkInterestUsTotal / loops) / 1000.0
-                << " avgChunkSendMs=" << (perfChunkSendUsTotal / loops) / 1000.0
-                << " simTicks=" << perfSimTicks
-                << " msgs=" << perfMessages
-                << " inputs=" << perfPlayerInputs
-                << " chunkReq=" << perfChunkRequests
-                << " prewarmGenerated=" << perfCollisionPrewarmGenerated
-                << " chunkInterestTasks=" << perfChunkInterestTasks
-                << " chunksSent=" << perfChunksSent
-                << " scoreboardBroadcasts=" << perfScoreboardBroadcasts
-                << "\n";
+        if ((perfNow - perfWindowStart) >= kServerPerfLogInterval) {
+            const TickJitterStats tickJitter = tickScheduler.takeJitter();
+            {
+                std::lock_guard<std::mutex> lk(m_tickJitterMutex);
+                m_lastTickJitter = tickJitter;
+            }
+            if (g_enableServerPerfDiagnostics.load(std::memory_order_acquire)) {
+                const double loops = (perfLoops > 0) ? static_cast<double>(perfLoops) : 1.0;
+                std::cerr
+                    << "[perf/server] 1s loops=" << perfLoops
+                    << " avgLoopMs=" << (perfLoopUsTotal / loops) / 1000.0
+                    << " maxLoopMs=" << perfLoopUsMax / 1000.0
+                    << " avgMsgDrainMs=" << (perfMessageDrainUsTotal / loops) / 1000.0
+                    << " avgSimMs=" << (perfSimUsTotal / loops) / 1000.0
+                    << " avgPrewarmMs=" << (perfCollisionPrewarmUsTotal / loops) / 1000.0
+                    << " avgSnapshotMs=" << (perfSnapshotUsTotal / loops) / 1000.0
+                    << " avgSnapshotEncodeMs=" << (perfSnapshotEncodeUsTotal / loops) / 1000.0
+                    << " avgSnapshotSubmitMs=" << (perfSnapshotSubmitUsTotal / loops) / 1000.0
+                    << " avgChunkInterestMs=" << (perfChunkInterestUsTotal / loops) / 1000.0
+                    << " avgChunkSendMs=" << (perfChunkSendUsTotal / loops) / 1000.0
+                    << " simTicks=" << perfSimTicks
+                    << " msgs=" << perfMessages
+                    << " inputs=" << perfPlayerInputs
+                    << " chunkReq=" << perfChunkRequests
+                    << " inboundDropped=" << m_inboundCommandsDropped.load(std::memory_order_relaxed)
+                    << " prewarmRequested=" << perfCollisionPrewarmRequested
+                    << " chunkInterestTasks=" << perfChunkInterestTasks
+                    << " chunksSent=" << perfChunksSent
+                    << " scoreboardBroadcasts=" << perfScoreboardBroadcasts
+                    << "\n";
+                std::cerr
+                    << "[perf/tick] 1s rateHz=" << tickJitter.tickRateHz
+                    << " ticks=" << tickJitter.samples
+                    << " jitterP50Us=" << tickJitter.p50Us
+                    << " jitterP99Us=" << tickJitter.p99Us
+                    << " jitterMaxUs=" << tickJitter.maxUs
+                    << "\n";
+            }
 
             perfWindowStart = perfNow;
             perfLoops = 0;
@@ -3363,7 +3501,7 @@ void ServerNetwork::MainLoop()
             perfPlayerInputs = 0;
             perfChunkRequests = 0;
             perfSimTicks = 0;
-            perfCollisionPrewarmGenerated = 0;
+            perfCollisionPrewarmRequested = 0;
             perfChunkInterestTasks = 0;
             perfChunksSent = 0;
             perfScoreboardBroadcasts = 0;
@@ -3373,15 +3511,14 @@ void ServerNetwork::MainLoop()
             perfSimUsTotal = 0.0;
             perfCollisionPrewarmUsTotal = 0.0;
             perfSnapshotUsTotal = 0.0;
+            perfSnapshotEncodeUsTotal = 0.0;
+            perfSnapshotSubmitUsTotal = 0.0;
             perfChunkInterestUsTotal = 0.0;
             perfChunkSendUsTotal = 0.0;
         }
 
-        if (simBacklog) {
-            std::this_thread::yield();
-        }
-        else {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (!tickScheduler.isBehind(std::chrono::steady_clock::now())) {
+            tickScheduler.sleepUntilNextTick();
         }
 
     }
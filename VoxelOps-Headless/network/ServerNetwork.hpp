@@ -6,6 +6,7 @@
 #include <unordered_set>
 #include <vector>
 #include <deque>
+#include <queue>
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
@@ -30,11 +31,17 @@
 #include "../player/PlayerManager.hpp"
 #include "../graphics/ChunkManager.hpp"
 #include "WorldItemPhysics.hpp"
+#include "InterestGrid.hpp"
+#include "MessageBufferPool.hpp"
+#include "InboundCommands.hpp"
+#include "LagCompHistory.hpp"
+#include "ChunkSaver.hpp"
+#include "../runtime/TickScheduler.hpp"
 
 
 class ServerNetwork {
 public:
-
+    static constexpr uint32_t kDefaultTickRateHz = 60;
 
 
     ServerNetwork();
@@ -58,6 +65,15 @@ public:
     void LoadHistoryFromFile();
     void SaveAdminsToFile();
     void LoadAdminsFromFile();
+    void OpenWorldStore();
+    void SaveWorldToDisk();
+    // Must be called before Start().
+    void SetWorldSaveConfig(const ChunkSaverConfig& config);
+    // Must be called before Start(). Clamped to TickScheduler's supported range.
+    void SetTickRateHz(uint32_t tickRateHz);
+    uint32_t GetTickRateHz() const { return m_tickRateHz; }
+    // Tick-interval jitter over the most recently completed perf window (about one second).
+    TickJitterStats GetTickJitterStats() const;
 
     bool SetAdminByUsername(const std::string& username, bool isAdmin);
     bool IsAdminUsername(const std::string& username);
@@ -79,30 +95,40 @@ private:
     void ShutdownNetworking();
     static std::string ReadStringFromPacket(const void* data, uint32_t size, size_t offset = 1);
     bool IsInboundRateLimitExceeded(HSteamNetConnection incoming, PacketType packetType, uint32_t bytes);
-    void HandleConnectRequest(HSteamNetConnection incoming, const void* data, uint32_t size);
-    void HandleMessagePacket(HSteamNetConnection incoming, const void* data, uint32_t size);
-    void HandlePlayerInputPacket(HSteamNetConnection incoming, const void* data, uint32_t size, uint64_t& playerInputPacketsThisLoop);
-    void HandleChunkRequestPacket(HSteamNetConnection incoming, const void* data, uint32_t size, uint64_t& chunkRequestPacketsThisLoop);
-    void HandleBlockPlaceRequestPacket(HSteamNetConnection incoming, const void* data, uint32_t size);
-    void HandleBlockBreakRequestPacket(HSteamNetConnection incoming, const void* data, uint32_t size);
-    void HandleShootRequestPacket(HSteamNetConnection incoming, const void* data, uint32_t size);
-    void HandleInventoryActionRequestPacket(HSteamNetConnection incoming, const void* data, uint32_t size);
+    // Handlers run on the simulation thread with commands parsed by the I/O thread. A null request
+    // means the packet was malformed and the handler should answer with a rejection.
+    void HandleConnectRequest(HSteamNetConnection incoming, const ConnectRequest* request);
+    void HandleMessagePacket(HSteamNetConnection incoming, const std::string& msg);
+    void HandlePlayerInputPacket(HSteamNetConnection incoming, const PlayerInput& input);
+    void HandleChunkRequestPacket(HSteamNetConnection incoming, const ChunkRequest& req);
+    void HandleBlockPlaceRequestPacket(HSteamNetConnection incoming, const BlockPlaceRequest* request);
+    void HandleBlockBreakRequestPacket(HSteamNetConnection incoming, const BlockBreakRequest* request);
+    void HandleShootRequestPacket(HSteamNetConnection incoming, const ShootRequest& req);
+    void HandleInventoryActionRequestPacket(HSteamNetConnection incoming, const InventoryActionRequest& request);
     void SpawnDroppedItem(PlayerID dropperId, uint16_t itemId, uint16_t quantity);
     void UpdateWorldItems(double deltaSeconds);
-    void SendWorldItemSnapshots(
+    // One WorldItemSnapshot per recipient into outFrames (buffers reused), encoded in parallel.
+    void BuildWorldItemSnapshots(
         const std::vector<std::pair<HSteamNetConnection, PlayerID>>& recipients,
-        uint32_t serverTick
+        uint32_t serverTick,
+        std::vector<std::vector<uint8_t>>& outFrames
     );
     void SendInventorySnapshotToPlayer(PlayerID playerId);
     void RecordLagCompFrame(uint32_t serverTick);
-    void DispatchInboundPacket(
-        HSteamNetConnection incoming,
-        PacketType packetType,
-        const void* data,
-        uint32_t size,
+    // Network I/O thread: receives, validates and parses packets into per-connection rings.
+    void StartNetIoThread();
+    void StopNetIoThread();
+    void NetIoLoop();
+    // Simulation thread: runs queued commands, at most kMaxInboundCommandsPerConnection from each
+    // connection and kMaxInboundCommandsPerLoop / kInboundCommandBudgetUs in total per call, so
+    // neither one noisy client nor a burst across many can stretch a tick. The next call resumes
+    // at the connection the budget ran out on.
+    void DrainInboundCommands(
+        uint64_t& commandsThisLoop,
         uint64_t& playerInputPacketsThisLoop,
         uint64_t& chunkRequestPacketsThisLoop
     );
+    void DispatchInboundCommand(HSteamNetConnection incoming, const InboundCommand& command);
 
     // Callback bridge: Steam expects a free function pointer; we implement a static
     // bridge function that calls the instance method.
@@ -156,18 +182,6 @@ private:
         bool hasLastShootClientShotId = false;
     };
 
-    struct LagCompPlayerPose {
-        glm::vec3 position{ 0.0f };
-        float yaw = 0.0f;
-        float height = 2.56f;
-        float radius = 0.3f;
-    };
-
-    struct LagCompFrame {
-        uint32_t serverTick = 0;
-        std::unordered_map<PlayerID, LagCompPlayerPose> players;
-    };
-
     struct MatchScore {
         uint32_t kills = 0;
         uint32_t deaths = 0;
@@ -183,8 +197,19 @@ private:
     void UpdateChunkStreamingForClient(HSteamNetConnection conn, const glm::ivec3& centerChunk, uint16_t viewDistance);
     bool SendChunkData(HSteamNetConnection conn, const ChunkCoord& coord);
     bool SendChunkUnload(HSteamNetConnection conn, const ChunkCoord& coord);
+    // ChunkData packet bytes for the chunk's current version, cached on the chunk for other senders.
+    static ServerChunk::SharedBytes BuildChunkDataWireBytes(ServerChunk& chunk, const ChunkCoord& coord);
+    static void ReleaseSharedChunkBytes(SteamNetworkingMessage_t* message);
     bool PrepareChunkForStreaming(const ChunkCoord& coord);
-    bool QueueChunkPreparation(HSteamNetConnection conn, const ChunkCoord& coord);
+    // Lower values are prepared first: horizontal distance to the client's interest center,
+    // then (on initial sync) layers at/below the vertical anchor, then vertical distance.
+    static uint64_t ChunkStreamPriority(
+        const ChunkCoord& coord,
+        const glm::ivec3& centerChunk,
+        int verticalAnchorY,
+        bool isInitialSync
+    );
+    bool QueueChunkPreparation(HSteamNetConnection conn, const ChunkCoord& coord, uint64_t priority);
     size_t FlushChunkSendQueueForClient(HSteamNetConnection conn, size_t maxSends);
     size_t FlushChunkSendQueues(size_t globalBudget, size_t perClientBudget);
     size_t GetChunkSendQueueDepthForClient(HSteamNetConnection conn);
@@ -196,6 +221,8 @@ private:
     void StartChunkPipeline();
     void StopChunkPipeline();
     void ChunkPrepWorkerLoop();
+    // ChunkManager::ensureChunkLoadedAsync hook: wakes a prep worker to run the load.
+    static void WakeChunkPrepWorker(void* context);
 
     struct ChunkPipelineKey {
         HSteamNetConnection conn = k_HSteamNetConnection_Invalid;
@@ -215,15 +242,36 @@ private:
         }
     };
 
-    struct ChunkPrepTask {
-        HSteamNetConnection conn = k_HSteamNetConnection_Invalid;
+    // One job per chunk; every connection that asked for it while queued or running is a waiter
+    // and gets the chunk queued for sending once the job finishes.
+    struct ChunkPrepJob {
+        uint64_t priority = 0;
+        uint64_t sequence = 0;
+        bool running = false;
+        std::unordered_set<HSteamNetConnection> waiters;
+    };
+
+    struct ChunkPrepHeapEntry {
+        uint64_t priority = 0;
+        uint64_t sequence = 0;
         ChunkCoord coord{};
+
+        // std::priority_queue pops the largest element; invert so the lowest priority key
+        // (then the oldest request) comes out first.
+        bool operator<(const ChunkPrepHeapEntry& other) const noexcept {
+            if (priority != other.priority) return priority > other.priority;
+            return sequence > other.sequence;
+        }
     };
 
     std::atomic<bool> m_quit;
     std::atomic<bool> m_started{ false };
     std::atomic<uint32_t> m_serverTick{ 0 };
-    std::deque<LagCompFrame> m_lagCompFrames;
+    uint32_t m_tickRateHz = kDefaultTickRateHz;
+    uint32_t m_lagCompMaxTicks = 0; // shoot rewind window in ticks at m_tickRateHz
+    mutable std::mutex m_tickJitterMutex;
+    TickJitterStats m_lastTickJitter;
+    LagCompHistory m_lagCompHistory;
     std::mutex m_mutex;
     std::mutex m_shutdownMutex;
     bool m_shutdownComplete = false;
@@ -233,6 +281,14 @@ private:
     std::unordered_map<PlayerID, MatchScore> m_matchScores;
     std::unordered_map<uint64_t, WorldItemEntity> m_worldItems;
     uint64_t m_nextWorldItemId = 1;
+    // BuildWorldItemSnapshots scratch: items bucketed by position, rebuilt on every send.
+    InterestGrid m_worldItemGrid{ 16.0f };
+    std::vector<const WorldItemEntity*> m_worldItemIndex;
+    // Snapshot fan-out, reused every send: encoded frames, then one SendMessages batch.
+    std::vector<std::vector<uint8_t>> m_playerSnapshotFrames;
+    std::vector<std::vector<uint8_t>> m_worldItemSnapshotFrames;
+    std::vector<SteamNetworkingMessage_t*> m_outboundSnapshotMessages;
+    MessageBufferPool m_snapshotBufferPool;
     PlayerManager m_playerManager;
     ChunkManager m_chunkManager;
     std::chrono::steady_clock::time_point m_matchStartTime = std::chrono::steady_clock::now();
@@ -246,18 +302,34 @@ private:
     const char* HISTORY_FILE = "chat_history.txt";
     std::unordered_set<std::string> m_adminIdentities;
     const char* ADMINS_FILE = "admins.txt";
+    const char* WORLD_DIR = "world";
+    ChunkSaverConfig m_worldSaveConfig;
 
     HSteamNetPollGroup m_pollGroup;
     HSteamListenSocket m_listenSock;
+
+    static constexpr size_t kMaxInboundCommandsPerConnection = 32;
+    static constexpr size_t kMaxInboundCommandsPerLoop = 256;
+    static constexpr int64_t kInboundCommandBudgetUs = 3000;
+    std::thread m_netIoThread;
+    std::atomic<bool> m_netIoStop{ false };
+    InboundCommandQueues m_inboundCommands;
+    InboundCommandQueues::RingList m_inboundRingScratch; // simulation thread only
+    HSteamNetConnection m_inboundDrainResume = k_HSteamNetConnection_Invalid; // simulation thread only
+    std::atomic<uint64_t> m_inboundCommandsDropped{ 0 }; // ring full
     uint32_t m_nextAutoUsername = 0;
 
     static constexpr size_t kMaxChunkPrepQueue = 2048;
     static constexpr size_t kMaxChunkSendQueuePerClient = 256;
     std::atomic<bool> m_chunkPrepQuit{ false };
-    std::thread m_chunkPrepThread;
+    static constexpr unsigned kMaxChunkPrepWorkers = 8;
+    std::vector<std::thread> m_chunkPrepThreads;
     std::mutex m_chunkPipelineMutex;
     std::condition_variable m_chunkPrepCv;
-    std::deque<ChunkPrepTask> m_chunkPrepQueue;
+    std::unordered_map<ChunkCoord, ChunkPrepJob, ChunkCoordHash> m_chunkPrepJobs;
+    // May hold stale entries (job pruned or re-prioritized); workers skip them on pop.
+    std::priority_queue<ChunkPrepHeapEntry> m_chunkPrepHeap;
+    uint64_t m_nextChunkPrepSequence = 0;
     std::unordered_set<ChunkPipelineKey, ChunkPipelineKeyHash> m_chunkPrepQueued;
     std::unordered_map<HSteamNetConnection, std::deque<ChunkCoord>> m_chunkSendQueues;
     std::unordered_set<ChunkPipelineKey, ChunkPipelineKeyHash> m_chunkSendQueued;
@@ -80,6 +80,7 @@ void ServerNetwork::OnConnectionStatusChanged(SteamNetConnectionStatusChangedCal
             m_playerManager.removePlayer(session.playerId);
         }
         ClearChunkPipelineForConnection(hConn);
+        m_inboundCommands.remove(hConn);
         if (!session.username.empty()) {
             std::string out;
             out.push_back(static_cast<char>(PacketType::ClientDisconnect));
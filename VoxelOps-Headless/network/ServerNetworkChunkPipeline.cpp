@@ -106,27 +106,47 @@ void ServerNetwork::StartChunkPipeline()
 {
     {
         std::lock_guard<std::mutex> lk(m_chunkPipelineMutex);
-        m_chunkPrepQueue.clear();
+        m_chunkPrepJobs.clear();
+        m_chunkPrepHeap = {};
         m_chunkPrepQueued.clear();
         m_chunkSendQueues.clear();
         m_chunkSendQueued.clear();
     }
     m_chunkPrepQuit.store(false, std::memory_order_release);
-    if (!m_chunkPrepThread.joinable()) {
-        m_chunkPrepThread = std::thread([this]() { ChunkPrepWorkerLoop(); });
+    if (!m_chunkPrepThreads.empty()) {
+        return;
     }
+
+    // Leave a core for the simulation thread and one for networking/saving.
+    const unsigned hardwareThreads = std::thread::hardware_concurrency();
+    const unsigned workerCount = std::clamp(
+        hardwareThreads > 2 ? hardwareThreads - 2 : 1u,
+        1u,
+        kMaxChunkPrepWorkers
+    );
+    m_chunkManager.setChunkLoadRequestedCallback(&ServerNetwork::WakeChunkPrepWorker, this);
+    m_chunkPrepThreads.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        m_chunkPrepThreads.emplace_back([this]() { ChunkPrepWorkerLoop(); });
+    }
+    std::cout << "[chunk/prep] started " << workerCount << " prep worker(s)\n";
 }
 
 void ServerNetwork::StopChunkPipeline()
 {
+    m_chunkManager.setChunkLoadRequestedCallback(nullptr, nullptr);
     m_chunkPrepQuit.store(true, std::memory_order_release);
     m_chunkPrepCv.notify_all();
-    if (m_chunkPrepThread.joinable()) {
-        m_chunkPrepThread.join();
+    for (std::thread& worker : m_chunkPrepThreads) {
+        if (worker.joinable()) {
+            worker.join();
+        }
     }
+    m_chunkPrepThreads.clear();
     {
         std::lock_guard<std::mutex> lk(m_chunkPipelineMutex);
-        m_chunkPrepQueue.clear();
+        m_chunkPrepJobs.clear();
+        m_chunkPrepHeap = {};
         m_chunkPrepQueued.clear();
         m_chunkSendQueues.clear();
         m_chunkSendQueued.clear();
@@ -134,6 +154,23 @@ void ServerNetwork::StopChunkPipeline()
     m_chunkPrepQuit.store(false, std::memory_order_release);
 }
 
+uint64_t ServerNetwork::ChunkStreamPriority(
+    const ChunkCoord& coord,
+    const glm::ivec3& centerChunk,
+    int verticalAnchorY,
+    bool isInitialSync
+)
+{
+    const int64_t dx = static_cast<int64_t>(coord.x) - centerChunk.x;
+    const int64_t dz = static_cast<int64_t>(coord.z) - centerChunk.z;
+    const uint64_t horizDist2 = static_cast<uint64_t>(dx * dx + dz * dz);
+    const uint64_t aboveAnchor = (isInitialSync && coord.y > verticalAnchorY) ? 1u : 0u;
+    const uint64_t vertDist = static_cast<uint64_t>(
+        std::min<int64_t>(std::abs(static_cast<int64_t>(coord.y) - verticalAnchorY), 0x7FFFFFFF)
+    );
+    return (std::min<uint64_t>(horizDist2, 0xFFFFFFFFu) << 32) | (aboveAnchor << 31) | vertDist;
+}
+
 bool ServerNetwork::PrepareChunkForStreaming(const ChunkCoord& coord)
 {
     // Materialize neighborhood off the network thread so chunk sends stay lightweight.
@@ -158,72 +195,138 @@ bool ServerNetwork::PrepareChunkForStreaming(const ChunkCoord& coord)
     return chunk != nullptr;
 }
 
+void ServerNetwork::WakeChunkPrepWorker(void* context)
+{
+    auto* self = static_cast<ServerNetwork*>(context);
+    {
+        // Pairs with the worker's predicate check so the wake-up cannot slip in before its wait.
+        std::lock_guard<std::mutex> lk(self->m_chunkPipelineMutex);
+    }
+    self->m_chunkPrepCv.notify_one();
+}
+
 void ServerNetwork::ChunkPrepWorkerLoop()
 {
+    std::vector<HSteamNetConnection> waiters;
     while (true) {
-        ChunkPrepTask task;
+        ChunkCoord coord{};
+        waiters.clear();
         {
             std::unique_lock<std::mutex> lk(m_chunkPipelineMutex);
-            m_chunkPrepCv.wait(lk, [this]() {
-                return m_chunkPrepQuit.load(std::memory_order_acquire) || !m_chunkPrepQueue.empty();
-            });
-            if (m_chunkPrepQuit.load(std::memory_order_acquire) && m_chunkPrepQueue.empty()) {
-                return;
+            bool haveJob = false;
+            while (!haveJob) {
+                m_chunkPrepCv.wait(lk, [this]() {
+                    return m_chunkPrepQuit.load(std::memory_order_acquire) ||
+                        !m_chunkPrepHeap.empty() ||
+                        m_chunkManager.hasPendingChunkLoads();
+                });
+                if (m_chunkPrepQuit.load(std::memory_order_acquire)) {
+                    return;
+                }
+
+                // ensureChunkLoadedAsync requests are single terrain loads that gameplay code is
+                // waiting on; serve them ahead of stream preparation.
+                if (m_chunkManager.hasPendingChunkLoads()) {
+                    lk.unlock();
+                    m_chunkManager.runPendingChunkLoads(1);
+                    lk.lock();
+                    continue;
+                }
+
+                const ChunkPrepHeapEntry entry = m_chunkPrepHeap.top();
+                m_chunkPrepHeap.pop();
+                auto jobIt = m_chunkPrepJobs.find(entry.coord);
+                if (
+                    jobIt == m_chunkPrepJobs.end() ||
+                    jobIt->second.running ||
+                    jobIt->second.sequence != entry.sequence
+                ) {
+                    continue;
+                }
+
+                jobIt->second.running = true;
+                coord = entry.coord;
+                waiters.assign(jobIt->second.waiters.begin(), jobIt->second.waiters.end());
+                haveJob = true;
             }
-            task = m_chunkPrepQueue.front();
-            m_chunkPrepQueue.pop_front();
         }
 
         bool stillNeeded = false;
         {
             std::lock_guard<std::mutex> lk(m_mutex);
-            auto it = m_clients.find(task.conn);
-            if (it != m_clients.end()) {
-                stillNeeded = it->second.pendingChunkData.find(task.coord) != it->second.pendingChunkData.end();
+            for (HSteamNetConnection conn : waiters) {
+                auto it = m_clients.find(conn);
+                if (it != m_clients.end() &&
+                    it->second.pendingChunkData.find(coord) != it->second.pendingChunkData.end()) {
+                    stillNeeded = true;
+                    break;
+                }
             }
         }
 
-        const bool prepared = stillNeeded && PrepareChunkForStreaming(task.coord);
-        const ChunkPipelineKey key{ task.conn, task.coord };
+        const bool prepared = stillNeeded && PrepareChunkForStreaming(coord);
         {
             std::lock_guard<std::mutex> lk(m_chunkPipelineMutex);
-            m_chunkPrepQueued.erase(key);
-            if (
-                prepared &&
-                !m_chunkPrepQuit.load(std::memory_order_acquire) &&
-                m_chunkSendQueued.find(key) == m_chunkSendQueued.end()
-            ) {
-                auto& sendQ = m_chunkSendQueues[task.conn];
+            auto jobIt = m_chunkPrepJobs.find(coord);
+            if (jobIt == m_chunkPrepJobs.end()) {
+                continue;
+            }
+
+            // Waiters that joined while the job was running get the result too.
+            const bool canQueueSends = prepared && !m_chunkPrepQuit.load(std::memory_order_acquire);
+            for (HSteamNetConnection conn : jobIt->second.waiters) {
+                const ChunkPipelineKey key{ conn, coord };
+                m_chunkPrepQueued.erase(key);
+                if (!canQueueSends || m_chunkSendQueued.find(key) != m_chunkSendQueued.end()) {
+                    continue;
+                }
+                auto& sendQ = m_chunkSendQueues[conn];
                 if (sendQ.size() < kMaxChunkSendQueuePerClient) {
-                    sendQ.push_back(task.coord);
+                    sendQ.push_back(coord);
                     m_chunkSendQueued.insert(key);
                 }
             }
+            m_chunkPrepJobs.erase(jobIt);
         }
     }
 }
 
-bool ServerNetwork::QueueChunkPreparation(HSteamNetConnection conn, const ChunkCoord& coord)
+bool ServerNetwork::QueueChunkPreparation(HSteamNetConnection conn, const ChunkCoord& coord, uint64_t priority)
 {
     const ChunkPipelineKey key{ conn, coord };
-    bool queued = false;
+    bool notify = false;
     {
         std::lock_guard<std::mutex> lk(m_chunkPipelineMutex);
-        if (m_chunkPrepQueued.find(key) != m_chunkPrepQueued.end() ||
-            m_chunkSendQueued.find(key) != m_chunkSendQueued.end()) {
+        auto jobIt = m_chunkPrepJobs.find(coord);
+        const bool alreadyWaiting =
+            jobIt != m_chunkPrepJobs.end() && jobIt->second.waiters.find(conn) != jobIt->second.waiters.end();
+        if (alreadyWaiting || m_chunkSendQueued.find(key) != m_chunkSendQueued.end()) {
             return true;
         }
-        if (m_chunkPrepQueue.size() >= kMaxChunkPrepQueue) {
+        if (m_chunkPrepQueued.size() >= kMaxChunkPrepQueue) {
             return false;
         }
-        m_chunkPrepQueue.push_back(ChunkPrepTask{ conn, coord });
+
+        if (jobIt == m_chunkPrepJobs.end()) {
+            jobIt = m_chunkPrepJobs.emplace(coord, ChunkPrepJob{}).first;
+            jobIt->second.priority = priority;
+            jobIt->second.sequence = m_nextChunkPrepSequence++;
+            m_chunkPrepHeap.push(ChunkPrepHeapEntry{ priority, jobIt->second.sequence, coord });
+            notify = true;
+        }
+        else if (!jobIt->second.running && priority < jobIt->second.priority) {
+            // A closer client joined; re-push under a fresh sequence so the old heap entry goes stale.
+            jobIt->second.priority = priority;
+            jobIt->second.sequence = m_nextChunkPrepSequence++;
+            m_chunkPrepHeap.push(ChunkPrepHeapEntry{ priority, jobIt->second.sequence, coord });
+        }
+        jobIt->second.waiters.insert(conn);
         m_chunkPrepQueued.insert(key);
-        queued = true;
     }
-    if (queued) {
+    if (notify) {
         m_chunkPrepCv.notify_one();
     }
-    return queued;
+    return true;
 }
 
 size_t ServerNetwork::FlushChunkSendQueueForClient(HSteamNetConnection conn, size_t maxSends)
@@ -314,14 +417,15 @@ void ServerNetwork::PruneChunkPipelineForClient(
 {
     std::lock_guard<std::mutex> lk(m_chunkPipelineMutex);
 
-    for (auto it = m_chunkPrepQueue.begin(); it != m_chunkPrepQueue.end();) {
-        if (it->conn == conn && desired.find(it->coord) == desired.end()) {
-            m_chunkPrepQueued.erase(ChunkPipelineKey{ conn, it->coord });
-            it = m_chunkPrepQueue.erase(it);
-        }
-        else {
-            ++it;
+    for (auto it = m_chunkPrepJobs.begin(); it != m_chunkPrepJobs.end();) {
+        if (desired.find(it->first) == desired.end() && it->second.waiters.erase(conn) > 0) {
+            m_chunkPrepQueued.erase(ChunkPipelineKey{ conn, it->first });
+            if (it->second.waiters.empty() && !it->second.running) {
+                it = m_chunkPrepJobs.erase(it);
+                continue;
+            }
         }
+        ++it;
     }
 
     auto sendIt = m_chunkSendQueues.find(conn);
@@ -358,9 +462,9 @@ void ServerNetwork::ClearChunkPipelineForConnection(HSteamNetConnection conn)
 
     m_chunkSendQueues.erase(conn);
 
-    for (auto it = m_chunkPrepQueue.begin(); it != m_chunkPrepQueue.end();) {
-        if (it->conn == conn) {
-            it = m_chunkPrepQueue.erase(it);
+    for (auto it = m_chunkPrepJobs.begin(); it != m_chunkPrepJobs.end();) {
+        if (it->second.waiters.erase(conn) > 0 && it->second.waiters.empty() && !it->second.running) {
+            it = m_chunkPrepJobs.erase(it);
         }
         else {
             ++it;
@@ -396,38 +500,68 @@ bool ServerNetwork::SendChunkData(HSteamNetConnection conn, const ChunkCoord& co
         return false;
     }
 
-    ChunkData packet;
-    packet.chunkX = coord.x;
-    packet.chunkY = coord.y;
-    packet.chunkZ = coord.z;
-    packet.version = static_cast<uint64_t>(std::max<int64_t>(0, chunk->version()));
-    const std::vector<uint8_t> rawPayload = chunk->serializeCompressed();
-    const CompressedChunkPayload compressedPayload = CompressChunkPayload(rawPayload);
-    packet.flags = compressedPayload.compressed ? 0x1u : 0u;
-    packet.payload = compressedPayload.payload;
+    ServerChunk::SharedBytes bytes = chunk->cachedWireBytes();
+    if (!bytes) {
+        bytes = BuildChunkDataWireBytes(*chunk, coord);
+    }
 
-    const std::vector<uint8_t> bytes = packet.serialize();
-    const EResult result = SteamNetworkingSockets()->SendMessageToConnection(
-        conn,
-        bytes.data(),
-        static_cast<uint32_t>(bytes.size()),
-        k_nSteamNetworkingSend_Reliable,
-        nullptr
-    );
-    if (result != k_EResultOK) {
+    // The message borrows the shared buffer; the free callback drops this connection's reference.
+    SteamNetworkingMessage_t* message = SteamNetworkingUtils()->AllocateMessage(0);
+    if (!message) {
+        return false;
+    }
+    auto* holder = new ServerChunk::SharedBytes(bytes);
+    message->m_conn = conn;
+    message->m_nFlags = k_nSteamNetworkingSend_Reliable;
+    message->m_pData = const_cast<uint8_t*>(bytes->data());
+    message->m_cbSize = static_cast<int>(bytes->size());
+    message->m_nUserData = static_cast<int64_t>(reinterpret_cast<intptr_t>(holder));
+    message->m_pfnFreeData = &ServerNetwork::ReleaseSharedChunkBytes;
+
+    // SendMessages takes ownership of the message whether or not the send succeeds.
+    int64_t sendResult = 0;
+    SteamNetworkingSockets()->SendMessages(1, &message, &sendResult);
+    if (sendResult < 0) {
+        const EResult result = static_cast<EResult>(-sendResult);
         SteamNetConnectionInfo_t info{};
         const bool haveInfo = SteamNetworkingSockets()->GetConnectionInfo(conn, &info);
         std::cerr
-            << "[chunk/send] SendMessageToConnection failed result=" << result
+            << "[chunk/send] SendMessages failed result=" << result
             << " conn=" << conn
             << " chunk=(" << coord.x << "," << coord.y << "," << coord.z << ")"
-            << " bytes=" << bytes.size();
+            << " bytes=" << bytes->size();
         if (haveInfo) {
             std::cerr << " connState=" << info.m_eState;
         }
         std::cerr << "\n";
+        return false;
     }
-    return result == k_EResultOK;
+    return true;
+}
+
+ServerChunk::SharedBytes ServerNetwork::BuildChunkDataWireBytes(ServerChunk& chunk, const ChunkCoord& coord)
+{
+    const int64_t version = chunk.version();
+
+    ChunkData packet;
+    packet.chunkX = coord.x;
+    packet.chunkY = coord.y;
+    packet.chunkZ = coord.z;
+    packet.version = static_cast<uint64_t>(std::max<int64_t>(0, version));
+    const std::vector<uint8_t> rawPayload = chunk.serializeCompressed();
+    CompressedChunkPayload compressedPayload = CompressChunkPayload(rawPayload);
+    packet.flags = compressedPayload.compressed ? 0x1u : 0u;
+    packet.payload = std::move(compressedPayload.payload);
+
+    auto bytes = std::make_shared<const std::vector<uint8_t>>(packet.serialize());
+    // Not cached if an edit landed mid-build; the next send rebuilds from the newer version.
+    chunk.storeWireBytes(version, bytes);
+    return bytes;
+}
+
+void ServerNetwork::ReleaseSharedChunkBytes(SteamNetworkingMessage_t* message)
+{
+    delete reinterpret_cast<ServerChunk::SharedBytes*>(static_cast<intptr_t>(message->m_nUserData));
 }
 
 bool ServerNetwork::SendChunkUnload(HSteamNetConnection conn, const ChunkCoord& coord)
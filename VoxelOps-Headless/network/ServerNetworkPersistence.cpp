@@ -125,6 +125,33 @@ void ServerNetwork::LoadAdminsFromFile()
     }
 }
 
+void ServerNetwork::SetWorldSaveConfig(const ChunkSaverConfig& config)
+{
+    m_worldSaveConfig = config;
+}
+
+void ServerNetwork::OpenWorldStore()
+{
+    if (!m_chunkManager.openChunkStore(WORLD_DIR, m_worldSaveConfig)) {
+        std::cerr << "[world/store] could not open " << WORLD_DIR << "; world edits will not persist\n";
+        return;
+    }
+    std::cout
+        << "[world/store] region store at " << WORLD_DIR
+        << " flushIntervalMs=" << m_worldSaveConfig.flushInterval.count()
+        << " maxDirtyAgeMs=" << m_worldSaveConfig.maxDirtyAge.count() << "\n";
+}
+
+void ServerNetwork::SaveWorldToDisk()
+{
+    const auto saveStart = std::chrono::steady_clock::now();
+    m_chunkManager.closeChunkStore();
+    const auto saveUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - saveStart
+    ).count();
+    std::cout << "[world/store] final save finished in " << saveUs << "us\n";
+}
+
 bool ServerNetwork::SetAdminByUsername(const std::string& target, bool isAdmin)
 {
     if (target.empty()) {
@@ -1,93 +1,30 @@
 #include "RayManager.hpp"
 
-#include <algorithm>
-#include <cfloat>
+#include <span>
 
-RayManager::RayManager() {
-
-}
+namespace {
+// Below kMinParallelRays rays the fork/join handoff costs more than the walks it spreads out.
+constexpr size_t kRayGrain = 8;
+constexpr size_t kMinParallelRays = 32;
 
-RayResult RayManager::rayHasBlockIntersectSingle(const Ray& ray, const ChunkManager& chunkManager, float maxDistance) {
+RayResult ToRayResult(const Shared::Voxel::VoxelRayHit& hit, float maxDistance) {
     RayResult result{};
-    result.hit = false;
-    result.distance = maxDistance;
-    
-    glm::vec3 rayDir = glm::normalize(ray.direction);
-    //// ====== 1. Setup DDA for block traversal ======
-    glm::ivec3 currentBlock = glm::floor(ray.origin); // starting voxel
-
-    glm::ivec3 step = glm::sign(rayDir); // step: -1, 0, or +1
-
-    glm::vec3 tMax;
-    glm::vec3 tDelta;
-
-    // Compute tMax and tDelta
-    for (int i = 0; i < 3; i++) {
-        if (rayDir[i] != 0.0f) {
-            float nextBoundary = (step[i] > 0)
-                ? (currentBlock[i] + 1.0f)
-                : (currentBlock[i]);
-            tMax[i] = (nextBoundary - ray.origin[i]) / rayDir[i];
-            tDelta[i] = std::abs(1.0f / rayDir[i]);
-        }
-        else {
-            tMax[i] = FLT_MAX;
-            tDelta[i] = FLT_MAX;
-        }
-    }
-
-    // ====== Traverse blocks ======
-    for (int i = 0; i < 1024; i++) { // safety cap
-        float traveled = std::min({ tMax.x, tMax.y, tMax.z });
-        if (traveled > maxDistance)
-            break;
-
-        // Get the chunk this block belongs to
-        glm::ivec3 chunkCoords = chunkManager.worldToChunkPos(currentBlock);
-
-        if (const ServerChunk* chunk = chunkManager.getChunkIfExists(chunkCoords)) {
-            const glm::ivec3 blockInChunk = currentBlock - chunk->getWorldPosition();
-            if (ServerChunk::inBounds(blockInChunk.x, blockInChunk.y, blockInChunk.z)) {
-                BlockID block = chunk->getBlockUnchecked(blockInChunk.x, blockInChunk.y, blockInChunk.z);
-                if (block != BlockID::Air) {
-                    result.hit = true;
-                    result.hitBlockWorld = currentBlock;
-                    result.hitChunk = chunkCoords;
-                    result.distance = traveled;
-                    return result;
-                }
-            }
-        }
-
-        // ====== Step to next block ======
-        if (tMax.x < tMax.y) {
-            if (tMax.x < tMax.z) {
-                currentBlock.x += step.x;
-                tMax.x += tDelta.x;
-            }
-            else {
-                currentBlock.z += step.z;
-                tMax.z += tDelta.z;
-            }
-        }
-        else {
-            if (tMax.y < tMax.z) {
-                currentBlock.y += step.y;
-                tMax.y += tDelta.y;
-            }
-            else {
-                currentBlock.z += step.z;
-                tMax.z += tDelta.z;
-            }
-        }
-
-
-    }
-    
+    result.hit = hit.hit;
+    result.hitBlockWorld = hit.block;
+    result.hitChunk = hit.chunk;
+    result.distance = hit.hit ? hit.distance : maxDistance;
+    return result;
+}
+}
 
+RayManager::RayManager() {
 
+}
 
-    return result; // no hit found
+RayResult RayManager::rayHasBlockIntersectSingle(const Ray& ray, const ChunkManager& chunkManager, float maxDistance) {
+    Shared::Voxel::VoxelRayHit hit;
+    Shared::Voxel::Raycast(ChunkRayWorld{ chunkManager }, ray.origin, ray.direction, maxDistance, hit);
+    return ToRayResult(hit, maxDistance);
 }
 
 
@@ -97,15 +34,34 @@ RayResult RayManager::rayHasBlockIntersectSinglePrecise(const Ray& ray, const Ch
 
 
 
-RayResult RayManager::rayHasBlockIntersectBatch(std::list<Ray>& rays) {
-	RayResult result{};
-	result.hit = false;
-	result.distance = 0.0f;
-	for (auto& ray : rays) {
-		(void)ray;
-	}
-	return result;
-}
-
-
+void RayManager::rayHasBlockIntersectBatch(
+    const std::vector<Ray>& rays,
+    const ChunkManager& chunkManager,
+    float maxDistance,
+    std::vector<RayResult>& outResults,
+    ForkJoinPool* pool
+) {
+    std::vector<Shared::Voxel::VoxelRay> voxelRays(rays.size());
+    for (size_t i = 0; i < rays.size(); ++i) {
+        voxelRays[i].origin = rays[i].origin;
+        voxelRays[i].direction = rays[i].direction;
+        voxelRays[i].maxDistance = maxDistance;
+    }
+    std::vector<Shared::Voxel::VoxelRayHit> hits(rays.size());
+
+    const ChunkRayWorld world{ chunkManager };
+    if (pool != nullptr) {
+        Shared::Voxel::RaycastBatch(world, std::span<const Shared::Voxel::VoxelRay>(voxelRays), std::span(hits),
+            [pool](size_t count, auto&& fn) {
+                pool->run(count, kRayGrain, kMinParallelRays, fn);
+            });
+    }
+    else {
+        Shared::Voxel::RaycastBatch(world, std::span<const Shared::Voxel::VoxelRay>(voxelRays), std::span(hits));
+    }
 
+    outResults.resize(rays.size());
+    for (size_t i = 0; i < rays.size(); ++i) {
+        outResults[i] = ToRayResult(hits[i], maxDistance);
+    }
+}
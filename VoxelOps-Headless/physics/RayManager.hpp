@@ -2,12 +2,15 @@
 
 #include "Raycast.hpp"
 #include "../graphics/ChunkManager.hpp"
+#include "../runtime/ForkJoinPool.hpp"
+#include "../../Shared/voxel/VoxelRaycast.hpp"
 
 
 #include <glm/glm.hpp>
 #include <glm/fwd.hpp>
 #include <list>
 #include <iostream>
+#include <vector>
 
 
 
@@ -18,13 +21,32 @@ struct RayResult {
 	float distance;
 };
 
+// Shared::Voxel::Raycast view of the loaded chunks. Lookups are lock-free and never generate
+// terrain; unloaded chunks read as air.
+struct ChunkRayWorld {
+	using Chunk = ServerChunk;
+
+	const ChunkManager& chunkManager;
+
+	const ServerChunk* findChunk(const glm::ivec3& chunkPos) const { return chunkManager.getChunkIfExists(chunkPos); }
+	uint64_t brickOccupancy(const ServerChunk& chunk) const { return chunk.brickOccupancy(); }
+	bool isSolid(const ServerChunk& chunk, int x, int y, int z) const { return chunk.getBlockUnchecked(x, y, z) != BlockID::Air; }
+};
+
 
 
 class RayManager {
 public:
 	RayManager();
 
-	RayResult rayHasBlockIntersectBatch(std::list<Ray>& rays);
+	// One result per ray, in order. Spreads the rays over `pool` when given.
+	void rayHasBlockIntersectBatch(
+		const std::vector<Ray>& rays,
+		const ChunkManager& chunkManager,
+		float maxDistance,
+		std::vector<RayResult>& outResults,
+		ForkJoinPool* pool = nullptr
+	);
 	RayResult rayHasBlockIntersectSingle(const Ray& ray, const ChunkManager& chunkManager, float maxDistance); //for block breaking/placing
 
 	RayResult rayHasBlockIntersectSinglePrecise(const Ray& ray, const ChunkManager& chunkManager, float maxDistance);//for shooting
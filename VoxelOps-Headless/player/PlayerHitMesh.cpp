@@ -0,0 +1,369 @@
+#include "PlayerHitMesh.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VOXELOPS_HITMESH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+constexpr float kTriangleEpsilon = 1e-6f;
+
+// Four floats processed in lock-step; SSE2 where available, plain arrays otherwise.
+#if defined(VOXELOPS_HITMESH_SSE2)
+struct Float4 {
+    __m128 v;
+
+    static Float4 load(const float* p) { return { _mm_load_ps(p) }; }
+    static Float4 splat(float x) { return { _mm_set1_ps(x) }; }
+    friend Float4 operator+(Float4 a, Float4 b) { return { _mm_add_ps(a.v, b.v) }; }
+    friend Float4 operator-(Float4 a, Float4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+    friend Float4 operator*(Float4 a, Float4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+    friend Float4 operator/(Float4 a, Float4 b) { return { _mm_div_ps(a.v, b.v) }; }
+    static Float4 abs(Float4 a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+};
+
+struct Mask4 {
+    __m128 v;
+
+    friend Mask4 operator&(Mask4 a, Mask4 b) { return { _mm_and_ps(a.v, b.v) }; }
+    int bits() const { return _mm_movemask_ps(v); }
+};
+
+Mask4 Greater(Float4 a, Float4 b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+Mask4 GreaterEqual(Float4 a, Float4 b) { return { _mm_cmpge_ps(a.v, b.v) }; }
+Mask4 LessEqual(Float4 a, Float4 b) { return { _mm_cmple_ps(a.v, b.v) }; }
+Mask4 Less(Float4 a, Float4 b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+#else
+struct Float4 {
+    float v[4];
+
+    static Float4 load(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+    static Float4 splat(float x) { return { { x, x, x, x } }; }
+    template <typename Op>
+    static Float4 zip(Float4 a, Float4 b, Op op) {
+        return { { op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3]) } };
+    }
+    friend Float4 operator+(Float4 a, Float4 b) { return zip(a, b, [](float x, float y) { return x + y; }); }
+    friend Float4 operator-(Float4 a, Float4 b) { return zip(a, b, [](float x, float y) { return x - y; }); }
+    friend Float4 operator*(Float4 a, Float4 b) { return zip(a, b, [](float x, float y) { return x * y; }); }
+    friend Float4 operator/(Float4 a, Float4 b) { return zip(a, b, [](float x, float y) { return x / y; }); }
+    static Float4 abs(Float4 a) { return { { std::abs(a.v[0]), std::abs(a.v[1]), std::abs(a.v[2]), std::abs(a.v[3]) } }; }
+    void store(float* p) const { for (int i = 0; i < 4; ++i) p[i] = v[i]; }
+};
+
+struct Mask4 {
+    int v;
+
+    friend Mask4 operator&(Mask4 a, Mask4 b) { return { a.v & b.v }; }
+    int bits() const { return v; }
+};
+
+template <typename Cmp>
+Mask4 Compare(Float4 a, Float4 b, Cmp cmp) {
+    int bits = 0;
+    for (int i = 0; i < 4; ++i) {
+        if (cmp(a.v[i], b.v[i])) bits |= (1 << i);
+    }
+    return { bits };
+}
+Mask4 Greater(Float4 a, Float4 b) { return Compare(a, b, [](float x, float y) { return x > y; }); }
+Mask4 GreaterEqual(Float4 a, Float4 b) { return Compare(a, b, [](float x, float y) { return x >= y; }); }
+Mask4 LessEqual(Float4 a, Float4 b) { return Compare(a, b, [](float x, float y) { return x <= y; }); }
+Mask4 Less(Float4 a, Float4 b) { return Compare(a, b, [](float x, float y) { return x < y; }); }
+#endif
+
+bool RayHitsBox(
+    const glm::vec3& origin,
+    const glm::vec3& invDir,
+    const glm::vec3& boxMin,
+    const glm::vec3& boxMax,
+    float maxT
+) {
+    float tMin = 0.0f;
+    float tMax = maxT;
+    for (int axis = 0; axis < 3; ++axis) {
+        float t0 = (boxMin[axis] - origin[axis]) * invDir[axis];
+        float t1 = (boxMax[axis] - origin[axis]) * invDir[axis];
+        if (t0 > t1) std::swap(t0, t1);
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+        if (tMin > tMax) {
+            return false;
+        }
+    }
+    return true;
+}
+
+float SafeInverse(float x) {
+    constexpr float kHuge = 1e30f;
+    if (std::abs(x) < 1e-12f) {
+        return std::signbit(x) ? -kHuge : kHuge;
+    }
+    return 1.0f / x;
+}
+}
+
+bool RayHitsCapsule(
+    const glm::vec3& origin,
+    const glm::vec3& dir,
+    float maxDistance,
+    const glm::vec3& base,
+    const HitCapsule& capsule,
+    float& outEnterDistance
+) {
+    // Closest points between the ray segment and the capsule axis (Ericson, 5.1.9), using the
+    // axis being vertical: d2 = (0, len, 0).
+    const glm::vec3 axisStart = base + glm::vec3(0.0f, capsule.minY, 0.0f);
+    const float axisLength = std::max(0.0f, capsule.maxY - capsule.minY);
+    const glm::vec3 r = origin - axisStart;
+    const float e = axisLength * axisLength;
+    const float b = dir.y * axisLength;
+    const float c = glm::dot(dir, r);
+    const float f = r.y * axisLength;
+    float s = 0.0f; // along the ray, in [0, maxDistance]
+    float t = 0.0f; // along the axis, in [0, 1]
+    if (e <= 1e-12f) {
+        s = std::clamp(-c, 0.0f, maxDistance);
+    }
+    else {
+        const float denom = e - b * b; // a = 1 for a unit ray direction
+        s = (denom > 1e-8f) ? std::clamp((b * f - c * e) / denom, 0.0f, maxDistance) : 0.0f;
+        t = (b * s + f) / e;
+        if (t < 0.0f) {
+            t = 0.0f;
+            s = std::clamp(-c, 0.0f, maxDistance);
+        }
+        else if (t > 1.0f) {
+            t = 1.0f;
+            s = std::clamp(b - c, 0.0f, maxDistance);
+        }
+    }
+    const glm::vec3 onRay = origin + dir * s;
+    const glm::vec3 onAxis = axisStart + glm::vec3(0.0f, axisLength * t, 0.0f);
+    const glm::vec3 gap = onRay - onAxis;
+    if (glm::dot(gap, gap) > capsule.radius * capsule.radius) {
+        return false;
+    }
+
+    // Every point of the capsule lies within halfLength + radius of its centre.
+    const glm::vec3 centre = axisStart + glm::vec3(0.0f, axisLength * 0.5f, 0.0f);
+    outEnterDistance = std::max(0.0f, glm::dot(centre - origin, dir) - (axisLength * 0.5f + capsule.radius));
+    return true;
+}
+
+HitCapsule BoundingCapsuleOfHitboxes(const std::vector<Hitbox>& hitboxes)
+{
+    HitCapsule out;
+    if (hitboxes.empty()) {
+        return out;
+    }
+    out.minY = std::numeric_limits<float>::max();
+    out.maxY = std::numeric_limits<float>::lowest();
+    for (const Hitbox& box : hitboxes) {
+        const float reachX = std::max(std::abs(box.min.x), std::abs(box.max.x));
+        const float reachZ = std::max(std::abs(box.min.z), std::abs(box.max.z));
+        out.radius = std::max(out.radius, std::sqrt(reachX * reachX + reachZ * reachZ));
+        out.minY = std::min(out.minY, box.min.y);
+        out.maxY = std::max(out.maxY, box.max.y);
+    }
+    return out;
+}
+
+void PlayerHitMeshBvh::build(const std::vector<Triangle>& triangles)
+{
+    nodes.clear();
+    packets.clear();
+    capsule = HitCapsule{};
+    sourceTriangleCount = triangles.size();
+    if (triangles.empty()) {
+        return;
+    }
+
+    capsule.minY = std::numeric_limits<float>::max();
+    capsule.maxY = std::numeric_limits<float>::lowest();
+    for (const Triangle& tri : triangles) {
+        for (const glm::vec3& v : { tri.a, tri.b, tri.c }) {
+            capsule.radius = std::max(capsule.radius, std::sqrt(v.x * v.x + v.z * v.z));
+            capsule.minY = std::min(capsule.minY, v.y);
+            capsule.maxY = std::max(capsule.maxY, v.y);
+        }
+    }
+
+    std::vector<uint32_t> order(triangles.size());
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    nodes.reserve(2 * (triangles.size() / kPacketWidth + 1));
+    packets.reserve(triangles.size() / kPacketWidth + 1);
+    buildRange(order, triangles, 0, static_cast<uint32_t>(order.size()), 0);
+}
+
+uint32_t PlayerHitMeshBvh::buildRange(
+    std::vector<uint32_t>& order,
+    const std::vector<Triangle>& triangles,
+    uint32_t begin,
+    uint32_t end,
+    uint32_t depth
+) {
+    const uint32_t nodeIndex = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+    glm::vec3 centroidMin = boundsMin;
+    glm::vec3 centroidMax = boundsMax;
+    for (uint32_t i = begin; i < end; ++i) {
+        const Triangle& tri = triangles[order[i]];
+        boundsMin = glm::min(boundsMin, glm::min(tri.a, glm::min(tri.b, tri.c)));
+        boundsMax = glm::max(boundsMax, glm::max(tri.a, glm::max(tri.b, tri.c)));
+        const glm::vec3 centroid = (tri.a + tri.b + tri.c) / 3.0f;
+        centroidMin = glm::min(centroidMin, centroid);
+        centroidMax = glm::max(centroidMax, centroid);
+    }
+    nodes[nodeIndex].min = boundsMin;
+    nodes[nodeIndex].max = boundsMax;
+
+    const uint32_t count = end - begin;
+    const glm::vec3 extent = centroidMax - centroidMin;
+    const int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : ((extent.y >= extent.z) ? 1 : 2);
+    if (count <= kPacketWidth || depth >= kMaxDepth || extent[axis] <= 0.0f) {
+        nodes[nodeIndex].index = static_cast<uint32_t>(packets.size());
+        nodes[nodeIndex].packetCount = (count + kPacketWidth - 1) / kPacketWidth;
+        for (uint32_t first = begin; first < end; first += kPacketWidth) {
+            TrianglePacket& packet = packets.emplace_back();
+            for (uint32_t lane = 0; lane < kPacketWidth && first + lane < end; ++lane) {
+                const Triangle& tri = triangles[order[first + lane]];
+                const glm::vec3 e1 = tri.b - tri.a;
+                const glm::vec3 e2 = tri.c - tri.a;
+                packet.v0x[lane] = tri.a.x; packet.v0y[lane] = tri.a.y; packet.v0z[lane] = tri.a.z;
+                packet.e1x[lane] = e1.x; packet.e1y[lane] = e1.y; packet.e1z[lane] = e1.z;
+                packet.e2x[lane] = e2.x; packet.e2y[lane] = e2.y; packet.e2z[lane] = e2.z;
+                packet.region[lane] = tri.region;
+            }
+        }
+        return nodeIndex;
+    }
+
+    // Median split along the widest centroid axis.
+    const uint32_t mid = begin + count / 2;
+    std::nth_element(
+        order.begin() + begin,
+        order.begin() + mid,
+        order.begin() + end,
+        [&triangles, axis](uint32_t lhs, uint32_t rhs) {
+            const Triangle& l = triangles[lhs];
+            const Triangle& r = triangles[rhs];
+            return (l.a[axis] + l.b[axis] + l.c[axis]) < (r.a[axis] + r.b[axis] + r.c[axis]);
+        }
+    );
+    buildRange(order, triangles, begin, mid, depth + 1);
+    nodes[nodeIndex].index = buildRange(order, triangles, mid, end, depth + 1);
+    return nodeIndex;
+}
+
+bool PlayerHitMeshBvh::intersectPacket(
+    const TrianglePacket& packet,
+    const glm::vec3& origin,
+    const glm::vec3& dir,
+    float& inOutT,
+    HitRegion& outRegion
+) const {
+    const Float4 dx = Float4::splat(dir.x), dy = Float4::splat(dir.y), dz = Float4::splat(dir.z);
+    const Float4 e1x = Float4::load(packet.e1x), e1y = Float4::load(packet.e1y), e1z = Float4::load(packet.e1z);
+    const Float4 e2x = Float4::load(packet.e2x), e2y = Float4::load(packet.e2y), e2z = Float4::load(packet.e2z);
+
+    // pvec = dir x e2, det = e1 . pvec
+    const Float4 px = dy * e2z - dz * e2y;
+    const Float4 py = dz * e2x - dx * e2z;
+    const Float4 pz = dx * e2y - dy * e2x;
+    const Float4 det = e1x * px + e1y * py + e1z * pz;
+    const Mask4 nonDegenerate = Greater(Float4::abs(det), Float4::splat(kTriangleEpsilon));
+    if (nonDegenerate.bits() == 0) {
+        return false;
+    }
+    const Float4 invDet = Float4::splat(1.0f) / det;
+
+    const Float4 tx = Float4::splat(origin.x) - Float4::load(packet.v0x);
+    const Float4 ty = Float4::splat(origin.y) - Float4::load(packet.v0y);
+    const Float4 tz = Float4::splat(origin.z) - Float4::load(packet.v0z);
+    const Float4 u = (tx * px + ty * py + tz * pz) * invDet;
+
+    // qvec = tvec x e1
+    const Float4 qx = ty * e1z - tz * e1y;
+    const Float4 qy = tz * e1x - tx * e1z;
+    const Float4 qz = tx * e1y - ty * e1x;
+    const Float4 v = (dx * qx + dy * qy + dz * qz) * invDet;
+    const Float4 t = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+
+    const Float4 zero = Float4::splat(0.0f);
+    const Float4 one = Float4::splat(1.0f);
+    const Mask4 hits =
+        nonDegenerate &
+        GreaterEqual(u, zero) & LessEqual(u, one) &
+        GreaterEqual(v, zero) & LessEqual(u + v, one) &
+        Greater(t, Float4::splat(kTriangleEpsilon)) & Less(t, Float4::splat(inOutT));
+    int bits = hits.bits();
+    if (bits == 0) {
+        return false;
+    }
+
+    alignas(16) float tLanes[kPacketWidth];
+    t.store(tLanes);
+    bool found = false;
+    for (uint32_t lane = 0; lane < kPacketWidth; ++lane, bits >>= 1) {
+        if ((bits & 1) != 0 && tLanes[lane] < inOutT) {
+            inOutT = tLanes[lane];
+            outRegion = packet.region[lane];
+            found = true;
+        }
+    }
+    return found;
+}
+
+bool PlayerHitMeshBvh::raycast(
+    const glm::vec3& origin,
+    const glm::vec3& dir,
+    float maxDistance,
+    float& outT,
+    HitRegion& outRegion
+) const {
+    if (nodes.empty()) {
+        return false;
+    }
+    const glm::vec3 invDir(SafeInverse(dir.x), SafeInverse(dir.y), SafeInverse(dir.z));
+
+    float bestT = maxDistance;
+    bool found = false;
+    uint32_t stack[kMaxDepth + 2];
+    uint32_t stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const Node& node = nodes[stack[--stackSize]];
+        if (!RayHitsBox(origin, invDir, node.min, node.max, bestT)) {
+            continue;
+        }
+        if (node.packetCount > 0) {
+            for (uint32_t p = 0; p < node.packetCount; ++p) {
+                found |= intersectPacket(packets[node.index + p], origin, dir, bestT, outRegion);
+            }
+            continue;
+        }
+        // Visit the child on the ray's near side first so bestT shrinks sooner.
+        const uint32_t first = static_cast<uint32_t>(&node - nodes.data()) + 1;
+        const uint32_t second = node.index;
+        const glm::vec3 firstCentre = (nodes[first].min + nodes[first].max) * 0.5f;
+        const glm::vec3 secondCentre = (nodes[second].min + nodes[second].max) * 0.5f;
+        const bool firstIsNear = glm::dot(firstCentre - secondCentre, dir) <= 0.0f;
+        stack[stackSize++] = firstIsNear ? second : first;
+        stack[stackSize++] = firstIsNear ? first : second;
+    }
+    if (found) {
+        outT = bestT;
+    }
+    return found;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "Hitbox.hpp"
+
+// Vertical capsule enclosing a player's hit geometry in model space: feet at the origin and
+// yaw about +Y, so the same capsule holds for any yaw.
+struct HitCapsule {
+    float radius = 0.0f; // furthest reach from the Y axis
+    float minY = 0.0f;
+    float maxY = 0.0f;
+};
+
+// Broadphase test of a unit-direction ray segment [0, maxDistance] against `capsule` placed at
+// `base`. On a hit, outEnterDistance is a lower bound on where along the ray the capsule's
+// contents can start, for nearest-first ordering.
+bool RayHitsCapsule(
+    const glm::vec3& origin,
+    const glm::vec3& dir,
+    float maxDistance,
+    const glm::vec3& base,
+    const HitCapsule& capsule,
+    float& outEnterDistance
+);
+
+HitCapsule BoundingCapsuleOfHitboxes(const std::vector<Hitbox>& hitboxes);
+
+// Bounding-volume hierarchy over the shared player hit mesh, built once in model space at the
+// mesh's reference scale. Leaves hold up to four triangles laid out for a 4-wide
+// Moller-Trumbore test.
+class PlayerHitMeshBvh {
+public:
+    struct Triangle {
+        glm::vec3 a{ 0.0f };
+        glm::vec3 b{ 0.0f };
+        glm::vec3 c{ 0.0f };
+        HitRegion region = HitRegion::Body;
+    };
+
+    void build(const std::vector<Triangle>& triangles);
+    bool empty() const noexcept { return nodes.empty(); }
+    size_t triangleCount() const noexcept { return sourceTriangleCount; }
+    const HitCapsule& boundingCapsule() const noexcept { return capsule; }
+
+    // Nearest hit of a unit-direction ray in mesh space with t <= maxDistance.
+    bool raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance, float& outT, HitRegion& outRegion) const;
+
+private:
+    static constexpr uint32_t kPacketWidth = 4;
+    static constexpr uint32_t kMaxDepth = 48;
+
+    struct Node {
+        glm::vec3 min{ 0.0f };
+        glm::vec3 max{ 0.0f };
+        // Leaf: first packet. Interior: index of the second child (the first follows this node).
+        uint32_t index = 0;
+        uint32_t packetCount = 0; // 0 for interior nodes
+    };
+
+    // Vertex 0 and both edges per lane; empty lanes are degenerate and never hit.
+    struct TrianglePacket {
+        alignas(16) float v0x[kPacketWidth]{};
+        alignas(16) float v0y[kPacketWidth]{};
+        alignas(16) float v0z[kPacketWidth]{};
+        alignas(16) float e1x[kPacketWidth]{};
+        alignas(16) float e1y[kPacketWidth]{};
+        alignas(16) float e1z[kPacketWidth]{};
+        alignas(16) float e2x[kPacketWidth]{};
+        alignas(16) float e2y[kPacketWidth]{};
+        alignas(16) float e2z[kPacketWidth]{};
+        HitRegion region[kPacketWidth]{ HitRegion::Unknown, HitRegion::Unknown, HitRegion::Unknown, HitRegion::Unknown };
+    };
+
+    uint32_t buildRange(std::vector<uint32_t>& order, const std::vector<Triangle>& triangles, uint32_t begin, uint32_t end, uint32_t depth);
+    bool intersectPacket(const TrianglePacket& packet, const glm::vec3& origin, const glm::vec3& dir, float& inOutT, HitRegion& outRegion) const;
+
+    std::vector<Node> nodes;
+    std::vector<TrianglePacket> packets;
+    HitCapsule capsule;
+    size_t sourceTriangleCount = 0;
+};
@@ -0,0 +1,55 @@
+#include "PlayerKinematics.hpp"
+
+#include <algorithm>
+#include <thread>
+
+PlayerKinematicsBuffer::View::View(View&& other) noexcept
+    : players(other.players), pins(other.pins) {
+    other.pins = nullptr;
+}
+
+PlayerKinematicsBuffer::View::~View() {
+    if (pins != nullptr) {
+        pins->fetch_sub(1);
+    }
+}
+
+const PlayerKinematics* PlayerKinematicsBuffer::View::find(PlayerID id) const noexcept {
+    auto it = std::lower_bound(
+        players->begin(),
+        players->end(),
+        id,
+        [](const PlayerKinematics& entry, PlayerID value) { return entry.id < value; }
+    );
+    if (it == players->end() || it->id != id) {
+        return nullptr;
+    }
+    return &(*it);
+}
+
+PlayerKinematicsBuffer::View PlayerKinematicsBuffer::read() const {
+    // Pin, then confirm the array is still the front. If the writer flipped in between it may
+    // already be refilling this array, so drop the pin and retry against the new front.
+    for (;;) {
+        const uint32_t index = front.load();
+        const Buffer& buffer = buffers[index];
+        buffer.pins.fetch_add(1);
+        if (front.load() == index) {
+            return View(buffer.players, buffer.pins);
+        }
+        buffer.pins.fetch_sub(1);
+    }
+}
+
+std::vector<PlayerKinematics>& PlayerKinematicsBuffer::beginPublish() {
+    Buffer& back = buffers[front.load() ^ 1u];
+    while (back.pins.load() != 0) {
+        std::this_thread::yield();
+    }
+    back.players.clear();
+    return back.players;
+}
+
+void PlayerKinematicsBuffer::endPublish() {
+    front.store(front.load() ^ 1u);
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "ServerPlayer.hpp"
+
+#include <glm/vec3.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// What other systems need to know about a player between ticks: where it is and how big it is.
+struct PlayerKinematics {
+    PlayerID id = 0;
+    glm::vec3 position{ 0.0f };
+    glm::vec3 velocity{ 0.0f };
+    float yaw = 0.0f;
+    float pitch = 0.0f;
+    float height = 0.0f;
+    float radius = 0.0f;
+    float health = 0.0f;
+    bool isAlive = false;
+};
+
+// Double-buffered array of player kinematics. One writer publishes a full array per tick; readers
+// on any thread pin the front array without locking and without allocating. A pinned array stays
+// untouched until its View is dropped, so a View must not be held across the writer's next publish
+// on the same thread.
+class PlayerKinematicsBuffer {
+public:
+    class View {
+    public:
+        View(View&& other) noexcept;
+        View(const View&) = delete;
+        View& operator=(const View&) = delete;
+        View& operator=(View&&) = delete;
+        ~View();
+
+        const PlayerKinematics* begin() const noexcept { return players->data(); }
+        const PlayerKinematics* end() const noexcept { return players->data() + players->size(); }
+        size_t size() const noexcept { return players->size(); }
+        bool empty() const noexcept { return players->empty(); }
+
+        // Entries are in ascending id order, so this is a binary search.
+        const PlayerKinematics* find(PlayerID id) const noexcept;
+
+    private:
+        friend class PlayerKinematicsBuffer;
+        View(const std::vector<PlayerKinematics>& players, std::atomic<uint32_t>& pins) noexcept
+            : players(&players), pins(&pins) {}
+
+        const std::vector<PlayerKinematics>* players;
+        std::atomic<uint32_t>* pins;
+    };
+
+    View read() const;
+
+    // Writer side. beginPublish() hands out the back array (cleared, capacity kept) once no reader
+    // still pins it; endPublish() makes it the front.
+    std::vector<PlayerKinematics>& beginPublish();
+    void endPublish();
+
+private:
+    struct Buffer {
+        std::vector<PlayerKinematics> players;
+        mutable std::atomic<uint32_t> pins{ 0 };
+    };
+
+    std::array<Buffer, 2> buffers;
+    std::atomic<uint32_t> front{ 0 };
+};
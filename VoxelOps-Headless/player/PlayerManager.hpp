@@ -1,20 +1,25 @@
 #pragma once
 #include "ServerPlayer.hpp"
-#include <unordered_map>
-#include <list>
+#include "PlayerTable.hpp"
+#include "PlayerKinematics.hpp"
+#include "../network/InterestGrid.hpp"
+#include "../runtime/ForkJoinPool.hpp"
 #include <mutex>
 #include <atomic>
 #include <vector>
 #include <optional>
 
-// Forward declaration for serialization helpers
-struct PlayerSnapshot;
 class ChunkManager;
+struct VoxelCollisionGrid;
+namespace Shared::Movement { struct State; }
 
 class PlayerManager {
 public:
     PlayerManager();
-    ~PlayerManager() = default;
+    ~PlayerManager();
+
+    PlayerManager(const PlayerManager&) = delete;
+    PlayerManager& operator=(const PlayerManager&) = delete;
 
     // Called when a new connection is accepted
     PlayerID onPlayerConnect(std::shared_ptr<ConnectionHandle> conn, const glm::vec3& spawnPos);
@@ -35,9 +40,13 @@ public:
 
     // Build a snapshot for sending (returns raw bytes to send to a client)
     std::vector<uint8_t> buildSnapshotFor(PlayerID recipientId, uint32_t serverTick);
-    std::vector<std::vector<uint8_t>> buildSnapshotsForRecipients(
+    // Encodes one frame per recipient into outFrames (resized to match; buffers are cleared and
+    // reused). Recipients are encoded in parallel and must be distinct. An empty frame means the
+    // recipient is gone.
+    void buildSnapshotsForRecipients(
         const std::vector<PlayerID>& recipientIds,
-        uint32_t serverTick
+        uint32_t serverTick,
+        std::vector<std::vector<uint8_t>>& outFrames
     );
 
     // Send snapshots to all players (calls connection->send). This is a convenience
@@ -45,8 +54,11 @@ public:
     void broadcastSnapshots();
 
     // Lookup
-    std::optional<ServerPlayer> getPlayerCopy(PlayerID id);
-    std::vector<ServerPlayer> getAllPlayersCopy();
+    // Kinematics of every player as of the end of the last update(). Lock-free; drop the view
+    // before calling update() again on the same thread.
+    PlayerKinematicsBuffer::View publishedPlayers() const { return kinematics.read(); }
+    // Shared with other per-tick jobs on the simulation thread; never run from inside update().
+    ForkJoinPool& workerPool() { return workers; }
     bool applyDamage(PlayerID id, float damage, float& outHealthAfter, bool& outKilled);
     bool requestRespawn(PlayerID id);
     bool applyInventoryAction(
@@ -68,24 +80,47 @@ public:
 private:
     PlayerID addPlayerInternal();
     glm::vec3 chooseRespawnPositionLocked(PlayerID respawningId) const;
-    void respawnPlayerLocked(ServerPlayer& player, const glm::vec3& position);
+    void respawnPlayerLocked(size_t row, const glm::vec3& position);
+    void clearMotionLocked(size_t row);
+    // Pops the input for the next expected tick (or skips ahead across a long gap).
+    std::optional<PlayerInput> takeNextInputLocked(size_t row);
+    Shared::Movement::State loadMovementStateLocked(size_t row) const;
+    void storeMovementStateLocked(size_t row, const Shared::Movement::State& state);
 
-    bool checkCollision(const ServerPlayer& p, const glm::vec3& pos, ChunkManager& chunkManager) const;
+    bool checkCollision(
+        size_t row,
+        const glm::vec3& pos,
+        const VoxelCollisionGrid& grid,
+        ChunkManager& chunkManager
+    ) const;
     void moveAndCollide(
-        ServerPlayer& p,
+        size_t row,
         const glm::vec3& delta,
         ChunkManager& chunkManager,
         bool allowStepUp
     );
-    void simulatePhysicsFor(ServerPlayer& p, double dt, ChunkManager& chunkManager);
+    void simulatePhysicsFor(size_t row, double dt, ChunkManager& chunkManager);
+    // Per-tick work that touches only `row` and reads the world: physics, or input draining while dead.
+    void advancePlayerFor(size_t row, double dt, ChunkManager& chunkManager);
+
+    void publishKinematicsLocked();
+    PlayerSnapshot snapshotRowLocked(size_t row, Clock::time_point now) const;
+    // Builds and records one recipient's frame. Touches only that recipient's cold state, so
+    // recipients can be encoded concurrently once the shared per-tick inputs are ready.
+    void encodeSnapshotLocked(PlayerID recipientId, uint32_t serverTick, Clock::time_point now, std::vector<uint8_t>& frame);
     void sendBytes(const std::shared_ptr<ConnectionHandle>& conn, const std::vector<uint8_t>& buf);
 
-    std::unordered_map<PlayerID, ServerPlayer> playersById;
-    std::list<PlayerID> playersOrder; // insertion order / iteration order
+    PlayerTable players; // rows in join order
+    PlayerKinematicsBuffer kinematics;
+    std::vector<Shared::SnapshotCodec::PlayerState> remoteSnapshotStates; // scratch, guarded by mtx
+    InterestGrid snapshotInterestGrid;                 // rows by position, guarded by mtx
 
     std::mutex mtx;
     std::atomic<PlayerID> nextId{ 1 };
 
+    // Physics steps and snapshot encoding fan out over this pool while the caller holds mtx.
+    ForkJoinPool workers;
+
     // Config
     std::chrono::seconds heartbeatTimeout{ 300 };
     std::chrono::milliseconds respawnDelay{ 3000 };
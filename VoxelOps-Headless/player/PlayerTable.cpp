@@ -0,0 +1,110 @@
+#include "PlayerTable.hpp"
+
+#include <utility>
+
+PlayerHandle PlayerTable::insert(ServerPlayer player) {
+    if (slotById.find(player.id) != slotById.end()) {
+        return PlayerHandle{};
+    }
+
+    uint32_t slot = 0;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else {
+        slot = static_cast<uint32_t>(slotRows.size());
+        slotRows.push_back(kFreeRow);
+        slotGenerations.push_back(0);
+    }
+
+    const uint32_t row = static_cast<uint32_t>(ids.size());
+    slotRows[slot] = row;
+    rowSlots.push_back(slot);
+    slotById.emplace(player.id, slot);
+
+    ids.push_back(player.id);
+    positions.push_back(player.position);
+    velocities.push_back(player.velocity);
+    yaws.push_back(player.yaw);
+    pitches.push_back(player.pitch);
+    heights.push_back(player.height);
+    radii.push_back(player.radius);
+    healths.push_back(player.health);
+    moveXs.push_back(player.moveX);
+    moveZs.push_back(player.moveZ);
+    timesSinceGrounded.push_back(player.timeSinceGrounded);
+    jumpBufferTimers.push_back(player.jumpBufferTimer);
+    equippedWeaponIds.push_back(player.equippedWeaponId);
+    activeInputFlags.push_back(player.activeInputFlags);
+    onGround.push_back(player.onGround ? 1u : 0u);
+    flyMode.push_back(player.flyMode ? 1u : 0u);
+    allowFlyMode.push_back(player.allowFlyMode ? 1u : 0u);
+    isAlive.push_back(player.isAlive ? 1u : 0u);
+    jumpPressedLastTick.push_back(player.jumpPressedLastTick ? 1u : 0u);
+
+    PlayerColdState coldState;
+    coldState.conn = std::move(player.conn);
+    coldState.lastHeartbeat = player.lastHeartbeat;
+    coldState.lastInputReceived = player.lastInputReceived;
+    coldState.pendingInputs = std::move(player.pendingInputs);
+    coldState.lastProcessedInputTick = player.lastProcessedInputTick;
+    coldState.hasReceivedInput = player.hasReceivedInput;
+    coldState.maxHealth = player.maxHealth;
+    coldState.respawnAt = player.respawnAt;
+    coldState.pendingRespawnRequest = player.pendingRespawnRequest;
+    coldState.inventory = std::move(player.inventory);
+    cold.push_back(std::move(coldState));
+
+    return PlayerHandle{ slot, slotGenerations[slot] };
+}
+
+bool PlayerTable::erase(PlayerID id) {
+    auto it = slotById.find(id);
+    if (it == slotById.end()) {
+        return false;
+    }
+
+    const uint32_t slot = it->second;
+    const size_t row = slotRows[slot];
+    slotById.erase(it);
+    slotRows[slot] = kFreeRow;
+    ++slotGenerations[slot];
+    freeSlots.push_back(slot);
+
+    // Shift rather than swap so rows stay in join order; player counts are small and leaves rare.
+    forEachColumn([row](auto& column) {
+        column.erase(column.begin() + static_cast<std::ptrdiff_t>(row));
+    });
+    rowSlots.erase(rowSlots.begin() + static_cast<std::ptrdiff_t>(row));
+    for (size_t r = row; r < rowSlots.size(); ++r) {
+        slotRows[rowSlots[r]] = static_cast<uint32_t>(r);
+    }
+    return true;
+}
+
+PlayerHandle PlayerTable::handleOf(PlayerID id) const {
+    auto it = slotById.find(id);
+    if (it == slotById.end()) {
+        return PlayerHandle{};
+    }
+    return PlayerHandle{ it->second, slotGenerations[it->second] };
+}
+
+size_t PlayerTable::rowOf(PlayerHandle handle) const noexcept {
+    if (!handle.valid() || handle.slot >= slotRows.size()) {
+        return kNoRow;
+    }
+    if (slotGenerations[handle.slot] != handle.generation || slotRows[handle.slot] == kFreeRow) {
+        return kNoRow;
+    }
+    return slotRows[handle.slot];
+}
+
+size_t PlayerTable::findRow(PlayerID id) const {
+    auto it = slotById.find(id);
+    if (it == slotById.end()) {
+        return kNoRow;
+    }
+    return slotRows[it->second];
+}
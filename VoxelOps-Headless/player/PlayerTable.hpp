@@ -0,0 +1,127 @@
+#pragma once
+
+#include "ServerPlayer.hpp"
+#include "../../Shared/network/SnapshotCodec.hpp"
+
+#include <glm/vec3.hpp>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+// Stable reference to a player row. Rows move when earlier players leave; handles do not,
+// and a handle whose player has left resolves to no row even if its slot was reused.
+struct PlayerHandle {
+    static constexpr uint32_t kInvalidSlot = std::numeric_limits<uint32_t>::max();
+
+    uint32_t slot = kInvalidSlot;
+    uint32_t generation = 0;
+
+    bool valid() const noexcept { return slot != kInvalidSlot; }
+};
+
+// Snapshot frames recently sent to one player, so the next frame can be a delta against whichever
+// of them the client acks. Indexed by serverTick modulo kFrames.
+struct SnapshotHistory {
+    static constexpr size_t kFrames = 32;
+
+    struct Frame {
+        bool valid = false;
+        uint32_t serverTick = 0;
+        std::vector<Shared::SnapshotCodec::PlayerState> players; // ascending id
+        // Tick at which each entry last carried fresh state. Players in a slow rate tier repeat
+        // their previous entry in between.
+        std::vector<uint32_t> refreshedAt;
+    };
+
+    const Frame* find(uint32_t serverTick) const noexcept {
+        const Frame& frame = frames[serverTick % kFrames];
+        return (frame.valid && frame.serverTick == serverTick) ? &frame : nullptr;
+    }
+    Frame& slotFor(uint32_t serverTick) noexcept { return frames[serverTick % kFrames]; }
+
+    std::array<Frame, kFrames> frames;
+    bool hasLastSent = false;
+    uint32_t lastSentTick = 0;
+};
+
+// Everything a tick does not touch for every player: connection, input queue, timers, inventory,
+// snapshot acks.
+struct PlayerColdState {
+    std::shared_ptr<ConnectionHandle> conn; // nullable
+    Clock::time_point lastHeartbeat{};
+    Clock::time_point lastInputReceived{};
+    std::map<uint32_t, PlayerInput> pendingInputs;
+    uint32_t lastProcessedInputTick = 0;
+    bool hasReceivedInput = false;
+    float maxHealth = 100.0f;
+    Clock::time_point respawnAt{};
+    bool pendingRespawnRequest = false;
+    Inventory inventory{};
+    bool hasSnapshotAck = false;
+    uint32_t ackedSnapshotTick = 0;
+    SnapshotHistory snapshotHistory;
+};
+
+// Dense structure-of-arrays player store. Row r of every column belongs to the same player and
+// rows are kept in join order. Physics and snapshot building walk the hot columns contiguously;
+// cold state sits in a parallel side table. Flags are uint8_t rather than bool so that threads
+// stepping different rows never share a vector<bool> word.
+class PlayerTable {
+public:
+    static constexpr size_t kNoRow = std::numeric_limits<size_t>::max();
+
+    size_t size() const noexcept { return ids.size(); }
+    bool empty() const noexcept { return ids.empty(); }
+
+    // Appends `player` as the last row. Returns an invalid handle if the id is already present.
+    PlayerHandle insert(ServerPlayer player);
+    bool erase(PlayerID id);
+
+    PlayerHandle handleOf(PlayerID id) const;
+    size_t rowOf(PlayerHandle handle) const noexcept;
+    size_t findRow(PlayerID id) const;
+
+    // Hot columns
+    std::vector<PlayerID> ids;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> velocities;
+    std::vector<float> yaws;
+    std::vector<float> pitches;
+    std::vector<float> heights;
+    std::vector<float> radii;
+    std::vector<float> healths;
+    std::vector<float> moveXs;
+    std::vector<float> moveZs;
+    std::vector<float> timesSinceGrounded;
+    std::vector<float> jumpBufferTimers;
+    std::vector<uint16_t> equippedWeaponIds;
+    std::vector<uint8_t> activeInputFlags;
+    std::vector<uint8_t> onGround;
+    std::vector<uint8_t> flyMode;
+    std::vector<uint8_t> allowFlyMode;
+    std::vector<uint8_t> isAlive;
+    std::vector<uint8_t> jumpPressedLastTick;
+
+    // Cold side table
+    std::vector<PlayerColdState> cold;
+
+private:
+    template <typename Fn>
+    void forEachColumn(Fn&& fn) {
+        fn(ids); fn(positions); fn(velocities); fn(yaws); fn(pitches);
+        fn(heights); fn(radii); fn(healths); fn(moveXs); fn(moveZs);
+        fn(timesSinceGrounded); fn(jumpBufferTimers); fn(equippedWeaponIds); fn(activeInputFlags);
+        fn(onGround); fn(flyMode); fn(allowFlyMode); fn(isAlive); fn(jumpPressedLastTick);
+        fn(cold);
+    }
+
+    std::unordered_map<PlayerID, uint32_t> slotById;
+    std::vector<uint32_t> slotRows;        // slot -> row, kFreeRow when unused
+    std::vector<uint32_t> slotGenerations; // bumped whenever a slot is released
+    std::vector<uint32_t> freeSlots;
+    std::vector<uint32_t> rowSlots;        // row -> slot
+
+    static constexpr uint32_t kFreeRow = std::numeric_limits<uint32_t>::max();
+};
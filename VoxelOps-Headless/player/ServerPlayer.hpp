@@ -2,7 +2,6 @@
 #include <cstdint>
 #include <chrono>
 #include <glm/vec3.hpp>
-#include <list>
 #include <memory>
 #include <map>
 #include <limits>
@@ -54,7 +53,4 @@ struct ServerPlayer {
     float timeSinceGrounded = 0.0f;
     float jumpBufferTimer = 0.0f;
     Inventory inventory{};
-
-    // For fast O(1) removal from order list (set by PlayerManager)
-    std::list<PlayerID>::iterator orderIt;
 };
@@ -0,0 +1,92 @@
+#include "ForkJoinPool.hpp"
+
+#include <algorithm>
+
+ForkJoinPool::ForkJoinPool(unsigned helperCount) {
+    threads.reserve(helperCount);
+    for (unsigned i = 0; i < helperCount; ++i) {
+        threads.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+ForkJoinPool::~ForkJoinPool() {
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        stop = true;
+    }
+    startCv.notify_all();
+    for (std::thread& worker : threads) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+unsigned ForkJoinPool::DefaultHelperCount(unsigned maxHelpers) {
+    const unsigned hardwareThreads = std::thread::hardware_concurrency();
+    return std::min(hardwareThreads > 1 ? hardwareThreads - 1 : 0u, maxHelpers);
+}
+
+size_t ForkJoinPool::runErased(size_t count, size_t grain, size_t minParallelCount, void* context, Job job) {
+    if (threads.empty() || count < minParallelCount || count <= grain) {
+        for (size_t index = 0; index < count; ++index) {
+            job(context, index);
+        }
+        return 1;
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        batchCount = count;
+        batchGrain = std::max<size_t>(grain, 1);
+        batchContext = context;
+        batchJob = job;
+        nextIndex.store(0, std::memory_order_relaxed);
+        pendingWorkers = threads.size();
+        ++generation;
+    }
+    startCv.notify_all();
+
+    drain();
+
+    std::unique_lock<std::mutex> lk(mutex);
+    doneCv.wait(lk, [this]() { return pendingWorkers == 0; });
+    return threads.size() + 1;
+}
+
+void ForkJoinPool::drain() {
+    const size_t count = batchCount;
+    const size_t grain = batchGrain;
+    for (;;) {
+        const size_t begin = nextIndex.fetch_add(grain, std::memory_order_relaxed);
+        if (begin >= count) {
+            return;
+        }
+        const size_t end = std::min(begin + grain, count);
+        for (size_t index = begin; index < end; ++index) {
+            batchJob(batchContext, index);
+        }
+    }
+}
+
+void ForkJoinPool::workerLoop() {
+    // Generation 0 is "no batch yet". Starting from it rather than from the current value keeps a
+    // helper that was slow to start from skipping a batch that already counts on it.
+    std::unique_lock<std::mutex> lk(mutex);
+    uint64_t seenGeneration = 0;
+    for (;;) {
+        startCv.wait(lk, [this, &seenGeneration]() {
+            return stop || generation != seenGeneration;
+        });
+        if (stop) {
+            return;
+        }
+        seenGeneration = generation;
+        lk.unlock();
+        drain();
+        lk.lock();
+        if (--pendingWorkers == 0) {
+            doneCv.notify_one();
+        }
+    }
+}
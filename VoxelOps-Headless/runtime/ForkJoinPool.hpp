@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Helper threads for data-parallel loops run from the simulation thread. run() hands out the
+// indices [0, count) `grain` at a time to the helpers and to the calling thread, and returns once
+// every index is done. Only one run() may be in flight at a time.
+class ForkJoinPool {
+public:
+    explicit ForkJoinPool(unsigned helperCount);
+    ~ForkJoinPool();
+
+    ForkJoinPool(const ForkJoinPool&) = delete;
+    ForkJoinPool& operator=(const ForkJoinPool&) = delete;
+
+    size_t helperCount() const noexcept { return threads.size(); }
+
+    // Calls fn(index) for every index. Below minParallelCount (or without helpers) the loop runs
+    // inline. Returns the number of threads that took part.
+    template <typename Fn>
+    size_t run(size_t count, size_t grain, size_t minParallelCount, Fn&& fn) {
+        return runErased(count, grain, minParallelCount, &fn, [](void* context, size_t index) {
+            (*static_cast<std::remove_reference_t<Fn>*>(context))(index);
+        });
+    }
+
+    // Helpers to use on this machine when the calling thread takes part too, capped at maxHelpers.
+    static unsigned DefaultHelperCount(unsigned maxHelpers);
+
+private:
+    using Job = void (*)(void* context, size_t index);
+
+    size_t runErased(size_t count, size_t grain, size_t minParallelCount, void* context, Job job);
+    void drain();
+    void workerLoop();
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable startCv;
+    std::condition_variable doneCv;
+    uint64_t generation = 0;
+    size_t pendingWorkers = 0;
+    bool stop = false;
+
+    // Current batch; written under `mutex` before the generation bump.
+    size_t batchCount = 0;
+    size_t batchGrain = 1;
+    void* batchContext = nullptr;
+    Job batchJob = nullptr;
+    std::atomic<size_t> nextIndex{ 0 };
+};
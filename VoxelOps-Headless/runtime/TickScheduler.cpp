@@ -0,0 +1,135 @@
+#include "TickScheduler.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <thread>
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+namespace {
+// Wake this long before the deadline and spin the rest; covers typical timer slack and
+// wake-up latency on an idle Linux box without burning much CPU per tick.
+constexpr auto kSpinMargin = std::chrono::microseconds(300);
+
+void SleepUntil(TickScheduler::Clock::time_point deadline)
+{
+#if defined(__linux__)
+    // steady_clock is CLOCK_MONOTONIC on Linux, so its epoch offsets are valid absolute times.
+    const auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch());
+    if (sinceEpoch.count() <= 0) {
+        return;
+    }
+    timespec ts{};
+    ts.tv_sec = static_cast<time_t>(sinceEpoch.count() / 1000000000LL);
+    ts.tv_nsec = static_cast<long>(sinceEpoch.count() % 1000000000LL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+#else
+    std::this_thread::sleep_until(deadline);
+#endif
+}
+}
+
+void TickJitterHistogram::record(double jitterUs)
+{
+    jitterUs = std::max(0.0, jitterUs);
+    const size_t bucket = std::min(
+        static_cast<size_t>(jitterUs / static_cast<double>(kBucketUs)),
+        kBucketCount - 1
+    );
+    ++buckets[bucket];
+    ++samples;
+    maxUs = std::max(maxUs, jitterUs);
+}
+
+void TickJitterHistogram::reset()
+{
+    buckets.fill(0);
+    samples = 0;
+    maxUs = 0.0;
+}
+
+double TickJitterHistogram::percentileUs(double fraction) const
+{
+    if (samples == 0) {
+        return 0.0;
+    }
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(samples))));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min(static_cast<double>((i + 1) * kBucketUs), maxUs);
+        }
+    }
+    return maxUs;
+}
+
+TickJitterStats TickJitterHistogram::summarize(uint32_t tickRateHz) const
+{
+    TickJitterStats stats{};
+    stats.tickRateHz = tickRateHz;
+    stats.samples = samples;
+    stats.p50Us = percentileUs(0.50);
+    stats.p99Us = percentileUs(0.99);
+    stats.maxUs = maxUs;
+    return stats;
+}
+
+TickScheduler::TickScheduler(uint32_t tickRateHz)
+    : rateHz(std::clamp(tickRateHz, kMinTickRateHz, kMaxTickRateHz)),
+    interval(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / static_cast<double>(rateHz))))
+{
+    reset(Clock::now());
+}
+
+void TickScheduler::reset(Clock::time_point now)
+{
+    nextDeadline = now + interval;
+    hasLastTickStart = false;
+}
+
+size_t TickScheduler::consumeDueTicks(Clock::time_point now, size_t maxTicks)
+{
+    size_t due = 0;
+    while (now >= nextDeadline && due < maxTicks) {
+        nextDeadline += interval;
+        ++due;
+    }
+    if (now >= nextDeadline) {
+        // Too far behind to catch up within the cap; drop the backlog instead of spiralling.
+        nextDeadline = now + interval;
+    }
+    return due;
+}
+
+void TickScheduler::markTickStart(Clock::time_point now)
+{
+    if (hasLastTickStart) {
+        const double actualUs = std::chrono::duration<double, std::micro>(now - lastTickStart).count();
+        const double nominalUs = std::chrono::duration<double, std::micro>(interval).count();
+        jitter.record(std::abs(actualUs - nominalUs));
+    }
+    lastTickStart = now;
+    hasLastTickStart = true;
+}
+
+void TickScheduler::sleepUntilNextTick() const
+{
+    const Clock::time_point deadline = nextDeadline;
+    if (Clock::now() + kSpinMargin < deadline) {
+        SleepUntil(deadline - kSpinMargin);
+    }
+    while (Clock::now() < deadline) {
+    }
+}
+
+TickJitterStats TickScheduler::takeJitter()
+{
+    const TickJitterStats stats = jitter.summarize(rateHz);
+    jitter.reset();
+    return stats;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Tick-interval jitter summary: how far the spacing between consecutive tick starts strayed from
+// the nominal interval, in microseconds.
+struct TickJitterStats {
+    uint32_t tickRateHz = 0;
+    uint64_t samples = 0;
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+};
+
+// Fixed-bucket histogram of |interval - nominal|. Percentiles resolve to the upper edge of their
+// bucket; the maximum is exact.
+class TickJitterHistogram {
+public:
+    static constexpr uint32_t kBucketUs = 25;
+    static constexpr size_t kBucketCount = 400; // last bucket collects everything >= 10 ms
+
+    void record(double jitterUs);
+    void reset();
+    TickJitterStats summarize(uint32_t tickRateHz) const;
+
+private:
+    double percentileUs(double fraction) const;
+
+    std::array<uint32_t, kBucketCount> buckets{};
+    uint64_t samples = 0;
+    double maxUs = 0.0;
+};
+
+// Fixed-rate clock for the simulation thread. Deadlines are absolute multiples of the tick
+// interval from reset(), so oversleeping one tick is not carried into the next. sleepUntilNextTick()
+// sleeps to just short of the deadline and spins the remainder.
+class TickScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr uint32_t kMinTickRateHz = 10;
+    static constexpr uint32_t kMaxTickRateHz = 240;
+
+    explicit TickScheduler(uint32_t tickRateHz);
+
+    uint32_t tickRateHz() const noexcept { return rateHz; }
+    double tickSeconds() const noexcept { return 1.0 / static_cast<double>(rateHz); }
+    Clock::time_point nextTickAt() const noexcept { return nextDeadline; }
+
+    void reset(Clock::time_point now);
+
+    // Ticks whose deadline has passed, at most maxTicks. When the backlog exceeds maxTicks the
+    // surplus is dropped and the schedule restarts from `now`.
+    size_t consumeDueTicks(Clock::time_point now, size_t maxTicks);
+    bool isBehind(Clock::time_point now) const noexcept { return now >= nextDeadline; }
+
+    // Call at the start of each simulated tick.
+    void markTickStart(Clock::time_point now);
+
+    void sleepUntilNextTick() const;
+
+    // Jitter since the last takeJitter() call; restarts the window.
+    TickJitterStats takeJitter();
+
+private:
+    uint32_t rateHz = 60;
+    Clock::duration interval{};
+    Clock::time_point nextDeadline{};
+    Clock::time_point lastTickStart{};
+    bool hasLastTickStart = false;
+    TickJitterHistogram jitter;
+};
@@ -52,11 +52,14 @@ static void print_console_help() {
         << "  admin grant <username|id:identity>\n"
         << "  admin revoke <username|id:identity>\n"
         << "  debug [on|off]\n"
+        << "  tick\n"
         << "  stop | quit | exit\n";
 }
 
 struct ServerLaunchOptions {
     uint16_t port = 27015;
+    ChunkSaverConfig worldSave;
+    uint32_t tickRateHz = ServerNetwork::kDefaultTickRateHz;
     bool showHelp = false;
 };
 
@@ -64,6 +67,9 @@ static void print_startup_help() {
     std::cout
         << "VoxelOps headless server options:\n"
         << "  --port <port> (default: 27015)\n"
+        << "  --save-interval <ms> (default: 5000)\n"
+        << "  --max-dirty-age <ms> (default: 30000)\n"
+        << "  --tick-rate <hz> (default: 60, range: 10-240)\n"
         << "  --help\n";
 }
 
@@ -92,6 +98,42 @@ static bool parse_port(std::string_view value, uint16_t& outPort) {
     return true;
 }
 
+static bool parse_millis(std::string_view value, std::chrono::milliseconds& outMillis) {
+    if (value.empty() || value.size() > 9) {
+        return false;
+    }
+    for (char c : value) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+    }
+
+    const long parsed = std::stol(std::string(value));
+    if (parsed <= 0) {
+        return false;
+    }
+    outMillis = std::chrono::milliseconds(parsed);
+    return true;
+}
+
+static bool parse_tick_rate(std::string_view value, uint32_t& outTickRateHz) {
+    if (value.empty() || value.size() > 3) {
+        return false;
+    }
+    for (char c : value) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+    }
+
+    const unsigned long parsed = std::stoul(std::string(value));
+    if (parsed < TickScheduler::kMinTickRateHz || parsed > TickScheduler::kMaxTickRateHz) {
+        return false;
+    }
+    outTickRateHz = static_cast<uint32_t>(parsed);
+    return true;
+}
+
 static bool parse_launch_options(int argc, char** argv, ServerLaunchOptions& outOptions) {
     for (int i = 1; i < argc; ++i) {
         const std::string_view arg = (argv[i] != nullptr) ? std::string_view(argv[i]) : std::string_view();
@@ -118,6 +160,33 @@ static bool parse_launch_options(int argc, char** argv, ServerLaunchOptions& out
             continue;
         }
 
+        if (arg == "--save-interval" || arg == "--max-dirty-age") {
+            if (i + 1 >= argc || argv[i + 1] == nullptr) {
+                std::cerr << "Missing value for " << arg << "\n";
+                return false;
+            }
+            std::chrono::milliseconds& target = (arg == "--save-interval")
+                ? outOptions.worldSave.flushInterval
+                : outOptions.worldSave.maxDirtyAge;
+            if (!parse_millis(argv[++i], target)) {
+                std::cerr << "Invalid duration (ms): " << argv[i] << "\n";
+                return false;
+            }
+            continue;
+        }
+
+        if (arg == "--tick-rate") {
+            if (i + 1 >= argc || argv[i + 1] == nullptr) {
+                std::cerr << "Missing value for " << arg << "\n";
+                return false;
+            }
+            if (!parse_tick_rate(argv[++i], outOptions.tickRateHz)) {
+                std::cerr << "Invalid tick rate (Hz): " << argv[i] << "\n";
+                return false;
+            }
+            continue;
+        }
+
         std::cerr << "Unknown option: " << arg << "\n";
         return false;
     }
@@ -237,6 +306,18 @@ static void process_console_command(const std::string& rawCommand, ServerNetwork
         return;
     }
 
+    if (cmd == "tick") {
+        const TickJitterStats jitter = serverNet.GetTickJitterStats();
+        std::cout
+            << "[Console] tick rateHz=" << serverNet.GetTickRateHz()
+            << " ticks=" << jitter.samples
+            << " jitterP50Us=" << jitter.p50Us
+            << " jitterP99Us=" << jitter.p99Us
+            << " jitterMaxUs=" << jitter.maxUs
+            << "\n";
+        return;
+    }
+
     std::cout << "[Console] Unknown command: " << command << "\n";
     print_console_help();
 }
@@ -263,7 +344,8 @@ int main(int argc, char** argv) {
 
     const uint16_t port = launchOptions.port;
     ServerNetwork serverNet;
-
+    serverNet.SetWorldSaveConfig(launchOptions.worldSave);
+    serverNet.SetTickRateHz(launchOptions.tickRateHz);
     
     if (!serverNet.Start(port)) {
         std::cerr << "Failed to start ServerNetwork on port " << port << "\n";
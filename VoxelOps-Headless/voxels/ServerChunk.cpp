@@ -1,5 +1,7 @@
 #include "ServerChunk.hpp"
 
+#include "../../Shared/voxel/VoxelRaycast.hpp"
+
 #include <fstream>
 #include <sstream>
 #include <random>
@@ -7,38 +9,127 @@
 #include <iostream>
 #include <iomanip>
 
+// ---- storage reader epochs --------------------------------------------------------
+// Lock-free block readers pin the storage epoch they started in; a retired block buffer is freed
+// only once no pinned reader is at or before the epoch it was retired in. Threads claim a slot on
+// their first read and give it back on exit. A thread that finds every slot taken counts itself in
+// s_overflowReaders instead, which holds off all frees while it reads.
+namespace {
+    constexpr uint64_t kReaderIdle = ~uint64_t(0);
+    constexpr size_t kMaxStorageReaders = 256;
+
+    struct alignas(64) StorageReaderSlot {
+        std::atomic<uint64_t> epoch{ kReaderIdle };
+        std::atomic<bool> claimed{ false };
+    };
+
+    std::atomic<uint64_t> s_storageEpoch{ 1 };
+    std::atomic<uint32_t> s_overflowReaders{ 0 };
+    std::array<StorageReaderSlot, kMaxStorageReaders> s_storageReaders;
+
+    constinit thread_local uint32_t t_storageReadDepth = 0;
+    constinit thread_local StorageReaderSlot* t_storageReaderSlot = nullptr;
+    constinit thread_local bool t_storageReaderClaimed = false;
+
+    // Gives the thread's slot back on exit; only instantiated once the thread has claimed one.
+    struct StorageReaderRelease {
+        ~StorageReaderRelease() {
+            if (t_storageReaderSlot) t_storageReaderSlot->claimed.store(false, std::memory_order_release);
+        }
+    };
+
+    void claimStorageReaderSlot() {
+        t_storageReaderClaimed = true;
+        for (auto& candidate : s_storageReaders) {
+            bool expected = false;
+            if (!candidate.claimed.load(std::memory_order_relaxed) &&
+                candidate.claimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                t_storageReaderSlot = &candidate;
+                thread_local StorageReaderRelease release;
+                break;
+            }
+        }
+    }
+
+    // Lowest epoch any reader is pinned at (kReaderIdle if none). Pairs with the fence in
+    // ReadScope: a reader this scan misses is ordered after the caller's storage change. Acquire
+    // orders the loads of a reader that already left before whatever the caller frees.
+    uint64_t oldestPinnedStorageEpoch() noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (s_overflowReaders.load(std::memory_order_acquire) != 0) return 0;
+        uint64_t oldest = kReaderIdle;
+        for (const auto& slot : s_storageReaders) {
+            oldest = std::min(oldest, slot.epoch.load(std::memory_order_acquire));
+        }
+        return oldest;
+    }
+}
+
+ServerChunk::ReadScope::ReadScope() noexcept {
+    if (t_storageReadDepth++ != 0) return;
+    if (!t_storageReaderClaimed) claimStorageReaderSlot();
+    if (t_storageReaderSlot) {
+        t_storageReaderSlot->epoch.store(s_storageEpoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    else {
+        s_overflowReaders.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+ServerChunk::ReadScope::~ReadScope() {
+    if (--t_storageReadDepth != 0) return;
+    if (t_storageReaderSlot) {
+        t_storageReaderSlot->epoch.store(kReaderIdle, std::memory_order_release);
+    }
+    else {
+        s_overflowReaders.fetch_sub(1, std::memory_order_release);
+    }
+}
+
 // ---- constructor ----------------------------------------------------------------
 ServerChunk::ServerChunk(glm::ivec3 pos)
     : position(pos)
 {
-    // initialize all to "air" (assume BlockID(0) == air)
-    m_blocks.fill(static_cast<BlockID>(0));
-    m_nonAirCount = 0;
+    // initialize all to "air" (assume BlockID(0) == air): a uniform chunk needs no block storage
+    m_storageMode.store(StorageMode::Uniform, std::memory_order_relaxed);
+    m_palette[0].store(static_cast<BlockID>(0), std::memory_order_relaxed);
+    m_paletteSize = 1;
+    m_nonAirCount.store(0, std::memory_order_relaxed);
+    m_brickOccupancy.store(0, std::memory_order_relaxed);
     m_version.store(0);
     m_dirty.store(false);
-    m_lastAccessNs.store(nowNs(), std::memory_order_relaxed);
+    touchAccess();
+}
+
+ServerChunk::~ServerChunk() {
+    for (auto& buffer : m_storageBuffers) {
+        delete[] buffer.load(std::memory_order_relaxed);
+    }
 }
 
 // ---- accessors ------------------------------------------------------------------
-// getBlock: shared lock for concurrent readers; updates last-access atomically
+// getBlock: lock-free seqlock read; access tracking is a relaxed epoch store at most
 BlockID ServerChunk::getBlock(int x, int y, int z) const noexcept {
     if (!inBounds(x, y, z)) return static_cast<BlockID>(0);
-    std::shared_lock<std::shared_mutex> lk(m_mutex);
-    touchLockedAtomic();
-    return m_blocks[idx(x, y, z)];
+    touchAccess();
+    return readBlock(idx(x, y, z));
 }
 
 BlockID ServerChunk::getBlockUnchecked(int x, int y, int z) const noexcept {
-    // caller promises in-bounds; use shared lock for thread-safety
-    std::shared_lock<std::shared_mutex> lk(m_mutex);
-    touchLockedAtomic();
-    return m_blocks[idx(x, y, z)];
+    // caller promises in-bounds
+    touchAccess();
+    return readBlock(idx(x, y, z));
 }
 
 bool ServerChunk::isCompletelyAir() const noexcept {
-    std::shared_lock<std::shared_mutex> lk(m_mutex);
-    touchLockedAtomic();
-    return m_nonAirCount == 0;
+    touchAccess();
+    return m_nonAirCount.load(std::memory_order_relaxed) == 0;
+}
+
+uint64_t ServerChunk::brickOccupancy() const noexcept {
+    touchAccess();
+    return m_brickOccupancy.load(std::memory_order_relaxed);
 }
 
 // ---- edit application -----------------------------------------------------------
@@ -46,22 +137,46 @@ int64_t ServerChunk::applyEdit(int x, int y, int z, BlockID id) {
     if (!inBounds(x, y, z)) return m_version.load(std::memory_order_acquire);
     std::unique_lock<std::shared_mutex> lk(m_mutex);
     const int index = idx(x, y, z);
-    BlockID prev = m_blocks[index];
+    BlockID prev = readBlockRelaxed(index);
 
     if (prev == id) {
-        // Option: bump version even on no-op to keep monotonic operation ordering.
-        // If you prefer not to change version for no-op, return current version instead.
-        int64_t newv = m_version.fetch_add(1) + 1;
-        touchLockedAtomic();
-        m_dirty.store(true, std::memory_order_relaxed);
-        return newv;
+        // No-op edits leave version and dirty state alone so they never trigger a save.
+        touchAccess();
+        return m_version.load(std::memory_order_acquire);
     }
 
     // update non-air count
-    if (prev == static_cast<BlockID>(0) && id != static_cast<BlockID>(0)) ++m_nonAirCount;
-    else if (prev != static_cast<BlockID>(0) && id == static_cast<BlockID>(0)) --m_nonAirCount;
+    uint16_t nonAirCount = m_nonAirCount.load(std::memory_order_relaxed);
+    if (prev == static_cast<BlockID>(0) && id != static_cast<BlockID>(0)) ++nonAirCount;
+    else if (prev != static_cast<BlockID>(0) && id == static_cast<BlockID>(0)) --nonAirCount;
+    m_nonAirCount.store(nonAirCount, std::memory_order_relaxed);
+
+    beginStorageWriteLocked();
+    if (nonAirCount == 0) {
+        // emptied out: drop back to uniform air instead of keeping a palette of one used entry
+        m_storageMode.store(StorageMode::Uniform, std::memory_order_relaxed);
+        m_palette[0].store(static_cast<BlockID>(0), std::memory_order_relaxed);
+        m_paletteSize = 1;
+    }
+    else {
+        writeBlockLocked(index, id);
+    }
+    endStorageWriteLocked();
 
-    m_blocks[index] = id;
+    uint64_t bricks = m_brickOccupancy.load(std::memory_order_relaxed);
+    const uint64_t brickBit = Shared::Voxel::BrickBit(x, y, z);
+    if (nonAirCount == 0) {
+        bricks = 0;
+    }
+    else if (id != static_cast<BlockID>(0)) {
+        bricks |= brickBit;
+    }
+    else if (!Shared::Voxel::BrickHasSolid(Shared::Voxel::BrickIndex(x, y, z), [this](int bx, int by, int bz) {
+        return readBlockRelaxed(idx(bx, by, bz)) != static_cast<BlockID>(0);
+    })) {
+        bricks &= ~brickBit;
+    }
+    m_brickOccupancy.store(bricks, std::memory_order_relaxed);
 
     int64_t newVersion = m_version.fetch_add(1) + 1;
 
@@ -75,15 +190,278 @@ int64_t ServerChunk::applyEdit(int x, int y, int z, BlockID id) {
     m_editLog.push_back(op);
     if (m_editLog.size() > m_maxEditLog) m_editLog.pop_front();
 
-    touchLockedAtomic();
-    m_dirty.store(true, std::memory_order_relaxed);
+    dropWireCache();
+    touchAccess();
+    markDirty();
     return newVersion;
 }
 
+void ServerChunk::assignBlocks(const std::array<BlockID, CHUNK_VOLUME>& blocks) {
+    std::unique_lock<std::shared_mutex> lk(m_mutex);
+    beginStorageWriteLocked();
+    encodeBlocksLocked(blocks.data());
+    endStorageWriteLocked();
+    m_version.fetch_add(1);
+    m_editLog.clear();
+    dropWireCache();
+    touchAccess();
+}
+
+// ---- block storage -------------------------------------------------------------
+BlockID ServerChunk::readBlock(int index) const noexcept {
+    ReadScope scope;
+    while (true) {
+        const uint32_t seqBefore = m_storageSeq.load(std::memory_order_acquire);
+        if ((seqBefore & 1u) == 0) {
+            const BlockID id = readBlockRelaxed(index);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_storageSeq.load(std::memory_order_relaxed) == seqBefore) {
+                return id;
+            }
+        }
+    }
+}
+
+BlockID ServerChunk::readBlockRelaxed(int index) const noexcept {
+    const StorageMode mode = m_storageMode.load(std::memory_order_relaxed);
+    if (mode == StorageMode::Uniform) {
+        return m_palette[0].load(std::memory_order_relaxed);
+    }
+
+    const std::atomic<uint8_t>* buffer = m_storageBuffers[storageBufferSlot(mode)].load(std::memory_order_acquire);
+    if (!buffer) {
+        // torn view of a mode switch; the sequence check makes the caller retry
+        return static_cast<BlockID>(0);
+    }
+    if (mode == StorageMode::Dense) {
+        return static_cast<BlockID>(buffer[static_cast<size_t>(index)].load(std::memory_order_relaxed));
+    }
+
+    // bits per block divides 8, so an index never straddles a byte
+    const unsigned bits = static_cast<unsigned>(mode);
+    const unsigned bitOffset = static_cast<unsigned>(index) * bits;
+    const unsigned mask = (1u << bits) - 1u;
+    const unsigned slot = (buffer[bitOffset >> 3].load(std::memory_order_relaxed) >> (bitOffset & 7u)) & mask;
+    return m_palette[slot].load(std::memory_order_relaxed);
+}
+
+void ServerChunk::beginStorageWriteLocked() noexcept {
+    m_storageSeq.store(m_storageSeq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void ServerChunk::endStorageWriteLocked() noexcept {
+    updateRetiredStorageLocked();
+    m_storageSeq.store(m_storageSeq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+size_t ServerChunk::updateRetiredStorageLocked() noexcept {
+    const StorageMode mode = m_storageMode.load(std::memory_order_relaxed);
+    uint64_t oldestPinned = 0;
+    bool scanned = false;
+    size_t freedBytes = 0;
+    for (size_t slot = 0; slot < kStorageBufferCount; ++slot) {
+        std::atomic<uint8_t>* buffer = m_storageBuffers[slot].load(std::memory_order_relaxed);
+        if (!buffer) continue;
+
+        const uint8_t bit = static_cast<uint8_t>(1u << slot);
+        if (mode != StorageMode::Uniform && storageBufferSlot(mode) == slot) {
+            m_retiredStorage &= static_cast<uint8_t>(~bit); // back in use
+            continue;
+        }
+        if ((m_retiredStorage & bit) == 0) {
+            // readers pinned after this increment already see the mode change
+            m_retiredStorage |= bit;
+            m_storageRetiredEpoch[slot] = s_storageEpoch.fetch_add(1, std::memory_order_seq_cst);
+            continue;
+        }
+        if (!scanned) {
+            oldestPinned = oldestPinnedStorageEpoch();
+            scanned = true;
+        }
+        if (oldestPinned > m_storageRetiredEpoch[slot]) {
+            m_storageBuffers[slot].store(nullptr, std::memory_order_relaxed);
+            delete[] buffer;
+            m_retiredStorage &= static_cast<uint8_t>(~bit);
+            freedBytes += (static_cast<size_t>(CHUNK_VOLUME) / 8) << slot;
+        }
+    }
+    return freedBytes;
+}
+
+size_t ServerChunk::releaseRetiredStorage() {
+    std::unique_lock<std::shared_mutex> lk(m_mutex);
+    if (m_retiredStorage == 0) return 0;
+    // bracketed like any other storage change so a reader on a stale view retries
+    beginStorageWriteLocked();
+    const size_t freedBytes = updateRetiredStorageLocked();
+    endStorageWriteLocked();
+    return freedBytes;
+}
+
+std::atomic<uint8_t>* ServerChunk::storageBufferLocked(StorageMode mode) {
+    auto& slot = m_storageBuffers[storageBufferSlot(mode)];
+    std::atomic<uint8_t>* buffer = slot.load(std::memory_order_relaxed);
+    if (!buffer) {
+        const size_t bytes = (static_cast<size_t>(CHUNK_VOLUME) * static_cast<size_t>(mode)) / 8;
+        buffer = new std::atomic<uint8_t>[bytes]();
+        slot.store(buffer, std::memory_order_release);
+    }
+    return buffer;
+}
+
+void ServerChunk::writeBlockLocked(int index, BlockID id) {
+    StorageMode mode = m_storageMode.load(std::memory_order_relaxed);
+    if (mode == StorageMode::Dense) {
+        storageBufferLocked(mode)[static_cast<size_t>(index)].store(static_cast<uint8_t>(id), std::memory_order_relaxed);
+        return;
+    }
+
+    auto findSlot = [this](BlockID block) -> int {
+        for (int i = 0; i < m_paletteSize; ++i) {
+            if (m_palette[i].load(std::memory_order_relaxed) == block) return i;
+        }
+        return -1;
+    };
+
+    int slot = findSlot(id);
+    if (slot < 0) {
+        const int capacity = 1 << static_cast<int>(mode);
+        if (m_paletteSize < capacity) {
+            slot = m_paletteSize++;
+            m_palette[slot].store(id, std::memory_order_relaxed);
+        }
+        else {
+            // Palette is full: re-encode, which drops entries no longer referenced and widens the
+            // indices (or goes dense) only if the new block still does not fit.
+            // (applyEdit already accounted for this write in m_nonAirCount; keep its value)
+            const uint16_t nonAirCount = m_nonAirCount.load(std::memory_order_relaxed);
+            std::array<BlockID, CHUNK_VOLUME> blocks;
+            decodeBlocksLocked(blocks.data());
+            encodeBlocksLocked(blocks.data(), id);
+            m_nonAirCount.store(nonAirCount, std::memory_order_relaxed);
+            mode = m_storageMode.load(std::memory_order_relaxed);
+            if (mode == StorageMode::Dense) {
+                storageBufferLocked(mode)[static_cast<size_t>(index)].store(static_cast<uint8_t>(id), std::memory_order_relaxed);
+                return;
+            }
+            slot = findSlot(id);
+        }
+    }
+
+    const unsigned bits = static_cast<unsigned>(mode);
+    const unsigned bitOffset = static_cast<unsigned>(index) * bits;
+    const unsigned shift = bitOffset & 7u;
+    const uint8_t mask = static_cast<uint8_t>(((1u << bits) - 1u) << shift);
+    std::atomic<uint8_t>& byte = storageBufferLocked(mode)[bitOffset >> 3];
+    const uint8_t current = byte.load(std::memory_order_relaxed);
+    byte.store(static_cast<uint8_t>((current & ~mask) | ((static_cast<unsigned>(slot) << shift) & mask)), std::memory_order_relaxed);
+}
+
+void ServerChunk::encodeBlocksLocked(const BlockID* blocks, std::optional<BlockID> extra) {
+    std::array<int, 256> slotOf;
+    slotOf.fill(-1);
+    std::array<BlockID, 16> palette{};
+    int paletteSize = 0;
+    uint16_t nonAir = 0;
+    bool fitsPalette = true;
+
+    auto addToPalette = [&](BlockID block) {
+        int& slot = slotOf[static_cast<uint8_t>(block)];
+        if (slot >= 0) return;
+        if (paletteSize < static_cast<int>(palette.size())) {
+            slot = paletteSize;
+            palette[paletteSize++] = block;
+        }
+        else {
+            fitsPalette = false;
+        }
+    };
+
+    for (int i = 0; i < CHUNK_VOLUME; ++i) {
+        if (blocks[i] != static_cast<BlockID>(0)) ++nonAir;
+        if (fitsPalette) addToPalette(blocks[i]);
+    }
+    if (extra && fitsPalette) addToPalette(*extra);
+    m_nonAirCount.store(nonAir, std::memory_order_relaxed);
+    m_brickOccupancy.store(Shared::Voxel::ComputeBrickOccupancy([blocks](int x, int y, int z) {
+        return blocks[idx(x, y, z)] != static_cast<BlockID>(0);
+    }), std::memory_order_relaxed);
+
+    StorageMode mode = StorageMode::Dense;
+    if (fitsPalette) {
+        if (paletteSize <= 1) mode = StorageMode::Uniform;
+        else if (paletteSize <= 2) mode = StorageMode::Palette1;
+        else if (paletteSize <= 4) mode = StorageMode::Palette2;
+        else mode = StorageMode::Palette4;
+    }
+    m_storageMode.store(mode, std::memory_order_relaxed);
+
+    if (mode == StorageMode::Dense) {
+        m_paletteSize = 0;
+        std::atomic<uint8_t>* buffer = storageBufferLocked(mode);
+        for (int i = 0; i < CHUNK_VOLUME; ++i) {
+            buffer[i].store(static_cast<uint8_t>(blocks[i]), std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    for (int i = 0; i < paletteSize; ++i) {
+        m_palette[i].store(palette[i], std::memory_order_relaxed);
+    }
+    m_paletteSize = static_cast<uint8_t>(paletteSize);
+    if (mode == StorageMode::Uniform) {
+        return;
+    }
+
+    const unsigned bits = static_cast<unsigned>(mode);
+    const unsigned blocksPerByte = 8u / bits;
+    std::atomic<uint8_t>* buffer = storageBufferLocked(mode);
+    const size_t byteCount = (static_cast<size_t>(CHUNK_VOLUME) * bits) / 8;
+    for (size_t byteIndex = 0; byteIndex < byteCount; ++byteIndex) {
+        uint8_t packed = 0;
+        for (unsigned j = 0; j < blocksPerByte; ++j) {
+            const BlockID block = blocks[byteIndex * blocksPerByte + j];
+            packed = static_cast<uint8_t>(packed | (slotOf[static_cast<uint8_t>(block)] << (j * bits)));
+        }
+        buffer[byteIndex].store(packed, std::memory_order_relaxed);
+    }
+}
+
+void ServerChunk::decodeBlocksLocked(BlockID* outBlocks) const noexcept {
+    for (int i = 0; i < CHUNK_VOLUME; ++i) {
+        outBlocks[i] = readBlockRelaxed(i);
+    }
+}
+
+ServerChunk::SharedBytes ServerChunk::cachedWireBytes() const {
+    std::lock_guard<std::mutex> lk(m_wireCacheMutex);
+    if (m_wireCache && m_wireCacheVersion == m_version.load(std::memory_order_acquire)) {
+        return m_wireCache;
+    }
+    return nullptr;
+}
+
+void ServerChunk::storeWireBytes(int64_t builtFromVersion, SharedBytes bytes) {
+    std::lock_guard<std::mutex> lk(m_wireCacheMutex);
+    if (builtFromVersion != m_version.load(std::memory_order_acquire)) return;
+    m_wireCache = std::move(bytes);
+    m_wireCacheVersion = builtFromVersion;
+}
+
+void ServerChunk::dropWireCache() noexcept {
+    SharedBytes released;
+    {
+        std::lock_guard<std::mutex> lk(m_wireCacheMutex);
+        released = std::move(m_wireCache);
+        m_wireCacheVersion = -1;
+    }
+}
+
 // ---- diff generation -----------------------------------------------------------
 std::optional<std::vector<EditOp>> ServerChunk::diffSince(int64_t knownVersion, size_t maxOps) const {
     std::shared_lock<std::shared_mutex> lk(m_mutex);
-    touchLockedAtomic();
+    touchAccess();
 
     // If no edits, and knownVersion == current, return empty vector (no change)
     if (m_editLog.empty()) {
@@ -114,13 +492,13 @@ std::optional<std::vector<EditOp>> ServerChunk::diffSince(int64_t knownVersion,
 void ServerChunk::addSubscriber(ClientId id) {
     std::unique_lock<std::shared_mutex> lk(m_mutex);
     m_subscribers.insert(id);
-    touchLockedAtomic();
+    touchAccess();
 }
 
 void ServerChunk::removeSubscriber(ClientId id) {
     std::unique_lock<std::shared_mutex> lk(m_mutex);
     m_subscribers.erase(id);
-    touchLockedAtomic();
+    touchAccess();
 }
 
 std::vector<ClientId> ServerChunk::getSubscribers() const {
@@ -135,7 +513,7 @@ void ServerChunk::fillRawVoxelBytes(uint8_t* outBuf, size_t bufSize) const {
     if (bufSize < need) return;
     // safe copy under shared lock for consistency
     std::shared_lock<std::shared_mutex> lk(m_mutex);
-    std::memcpy(outBuf, m_blocks.data(), need);
+    decodeBlocksLocked(reinterpret_cast<BlockID*>(outBuf));
 }
 
 void ServerChunk::loadRawVoxelBytes(const uint8_t* data, size_t bufSize) {
@@ -143,13 +521,10 @@ void ServerChunk::loadRawVoxelBytes(const uint8_t* data, size_t bufSize) {
     if (bufSize < need) return;
     // must hold exclusive lock when mutating
     std::unique_lock<std::shared_mutex> lk(m_mutex);
-    std::memcpy(m_blocks.data(), data, need);
-    // recompute nonAirCount
-    uint16_t count = 0;
-    for (size_t i = 0; i < CHUNK_VOLUME; ++i) {
-        if (m_blocks[i] != static_cast<BlockID>(0)) ++count;
-    }
-    m_nonAirCount = count;
+    // re-encoding also recomputes nonAirCount
+    beginStorageWriteLocked();
+    encodeBlocksLocked(reinterpret_cast<const BlockID*>(data));
+    endStorageWriteLocked();
 }
 
 // Note: for production replace compressBlob/decompressBlob with LZ4 (fast) or similar
@@ -174,11 +549,11 @@ std::vector<uint8_t> ServerChunk::decompressBlob(const uint8_t* data, size_t siz
 std::vector<uint8_t> ServerChunk::serializeCompressed() const {
     // use shared lock to snapshot blocks & version (shared read is OK)
     std::shared_lock<std::shared_mutex> lk(m_mutex);
-    touchLockedAtomic();
+    touchAccess();
 
     const size_t rawSize = CHUNK_VOLUME * sizeof(BlockID);
     std::vector<uint8_t> raw(rawSize);
-    std::memcpy(raw.data(), m_blocks.data(), rawSize);
+    decodeBlocksLocked(reinterpret_cast<BlockID*>(raw.data()));
 
     // compress (stub)
     std::vector<uint8_t> c = compressBlob(raw.data(), rawSize);
@@ -247,20 +622,15 @@ bool ServerChunk::deserializeCompressed(const std::vector<uint8_t>& blob) {
     {
         std::unique_lock<std::shared_mutex> lk(m_mutex);
         position = glm::ivec3(cx, cy, cz);
-        const size_t rawSize = CHUNK_VOLUME * sizeof(BlockID);
-        std::memcpy(m_blocks.data(), decompressed.data(), rawSize);
-        uint16_t count = 0;
-        for (size_t i = 0; i < CHUNK_VOLUME; ++i) {
-            if (m_blocks[i] != static_cast<BlockID>(0)) {
-                ++count;
-            }
-        }
-        m_nonAirCount = count;
+        beginStorageWriteLocked();
+        encodeBlocksLocked(reinterpret_cast<const BlockID*>(decompressed.data()));
+        endStorageWriteLocked();
         m_version.store(version, std::memory_order_release);
         m_dirty.store(false, std::memory_order_relaxed);
         // note: we do not populate editLog from serialization; editLog is for runtime edits. clear it.
         m_editLog.clear();
-        touchLockedAtomic();
+        dropWireCache();
+        touchAccess();
     }
     return true;
 }
@@ -12,6 +12,8 @@
 #include <cstring>
 #include <atomic>
 #include <algorithm>
+#include <memory>
+#include <mutex>
 
 #include "Voxel.hpp"
 #include <glm/vec3.hpp>
@@ -33,14 +35,34 @@ using ClientId = uint64_t; // or whatever type you use to identify connections
 class ServerChunk {
 public:
     ServerChunk(glm::ivec3 pos = glm::ivec3(0));
+    ~ServerChunk();
 
-    // Thread-safe accessors. These lock internally.
+    // Thread-safe accessors. Block reads are lock-free (seqlock); everything else locks internally.
     BlockID getBlock(int x, int y, int z) const noexcept;
     BlockID getBlockUnchecked(int x, int y, int z) const noexcept;
     // Apply edit and return resulting version. Validates coordinates.
     int64_t applyEdit(int x, int y, int z, BlockID id);
+    // Bulk replace for world generation (blocks indexed by blockIndex). Bumps the version once and
+    // records no edit log entries; the caller decides whether the chunk is dirty.
+    void assignBlocks(const std::array<BlockID, CHUNK_VOLUME>& blocks);
 
     bool isCompletelyAir() const noexcept;
+    // Frees the block buffers of storage widths the chunk has left, once no lock-free reader that
+    // could still see them remains. Called at the save boundary; returns the bytes freed.
+    size_t releaseRetiredStorage();
+
+    // Pins the calling thread as a lock-free block reader. getBlock pins on its own; callers doing
+    // many reads in a row can hold one scope around them so the pin is paid once. Nests.
+    class ReadScope {
+    public:
+        ReadScope() noexcept;
+        ~ReadScope();
+        ReadScope(const ReadScope&) = delete;
+        ReadScope& operator=(const ReadScope&) = delete;
+    };
+    // Bit Shared::Voxel::BrickIndex(x, y, z) is set when that 4x4x4 brick holds a non-air block.
+    // Lock-free; may lag a concurrent edit like any other unlocked read.
+    uint64_t brickOccupancy() const noexcept;
 
     // Return diffs since version (empty optional => too old to compute diff; request full chunk)
     std::optional<std::vector<EditOp>> diffSince(int64_t knownVersion, size_t maxOps = 1024) const;
@@ -52,6 +74,14 @@ public:
     // deserializeCompressed returns true on success (data becomes authoritative)
     bool deserializeCompressed(const std::vector<uint8_t>& blob);
 
+    // Encoded network form of this chunk (built by the streaming layer), shared by every connection
+    // that is sent the same version. applyEdit/deserializeCompressed drop it.
+    using SharedBytes = std::shared_ptr<const std::vector<uint8_t>>;
+    // Returns nullptr unless the cached bytes were built from the current version.
+    SharedBytes cachedWireBytes() const;
+    // Keeps bytes only if builtFromVersion is still current (an edit raced the build otherwise).
+    void storeWireBytes(int64_t builtFromVersion, SharedBytes bytes);
+
     // persistence helpers (implement per your storage backend)
     bool loadFromDisk(const std::string& path);
     bool saveToDisk(const std::string& path) const;
@@ -65,15 +95,48 @@ public:
     glm::ivec3 position;     // chunk coords
     int64_t version() const noexcept { return m_version.load(std::memory_order_acquire); }
     bool dirty() const noexcept { return m_dirty.load(std::memory_order_relaxed); }
-    void markDirty() noexcept { m_dirty.store(true, std::memory_order_relaxed); }
+    void markDirty() noexcept {
+        if (!m_dirty.exchange(true, std::memory_order_relaxed) && m_dirtyCallback) {
+            m_dirtyCallback(m_dirtyContext, position, m_version.load(std::memory_order_acquire));
+        }
+    }
     void clearDirty() noexcept { m_dirty.store(false, std::memory_order_relaxed); }
 
-    // Return last access as steady_clock::time_point (constructed from stored ns)
-    std::chrono::steady_clock::time_point getLastAccess() const noexcept {
-        uint64_t ns = m_lastAccessNs.load(std::memory_order_relaxed);
-        return std::chrono::steady_clock::time_point(std::chrono::nanoseconds(ns));
+    // Whether world generation's decoration pass has been applied (persisted alongside the chunk).
+    bool decorated() const noexcept { return m_decoration.load(std::memory_order_acquire) == kDecorated; }
+    void setDecorated(bool decorated) noexcept {
+        m_decoration.store(decorated ? kDecorated : kUndecorated, std::memory_order_release);
+        m_decoration.notify_all();
+    }
+    // The decoration pass also writes into neighbours, so exactly one thread may run it. Returns true
+    // for the caller that claimed it, which must then call finishDecoration(); others get false and
+    // can waitForDecoration().
+    bool tryBeginDecoration() noexcept {
+        uint8_t expected = kUndecorated;
+        return m_decoration.compare_exchange_strong(expected, kDecorating, std::memory_order_acq_rel, std::memory_order_acquire);
+    }
+    void finishDecoration() noexcept { setDecorated(true); }
+    void waitForDecoration() const noexcept {
+        uint8_t state = m_decoration.load(std::memory_order_acquire);
+        while (state == kDecorating) {
+            m_decoration.wait(state, std::memory_order_acquire);
+            state = m_decoration.load(std::memory_order_acquire);
+        }
     }
 
+    // Invoked on every clean -> dirty transition (from the editing thread, possibly under the chunk lock)
+    // with the chunk version at that point. Install before the chunk is published to other threads.
+    using DirtyCallback = void (*)(void* context, const glm::ivec3& chunkPos, int64_t version);
+    void setDirtyCallback(DirtyCallback callback, void* context) noexcept {
+        m_dirtyCallback = callback;
+        m_dirtyContext = context;
+    }
+
+    // Coarse access tracking for eviction heuristics: the server publishes its tick as the access
+    // epoch, and each chunk remembers the last epoch it was touched in.
+    static void setAccessEpoch(uint32_t epoch) noexcept { s_accessEpoch.store(epoch, std::memory_order_relaxed); }
+    uint32_t lastAccessEpoch() const noexcept { return m_lastAccessEpoch.load(std::memory_order_relaxed); }
+
     // helpers to get world coordinates of chunk origin
     glm::ivec3 getWorldPosition() const noexcept { return position * CHUNK_SIZE; }
 
@@ -81,6 +144,8 @@ public:
     static inline constexpr bool inBounds(int x, int y, int z) noexcept {
         return (unsigned)x < CHUNK_SIZE && (unsigned)y < CHUNK_SIZE && (unsigned)z < CHUNK_SIZE;
     }
+    // layout of raw voxel bytes (serialization and assignBlocks)
+    static inline constexpr int blockIndex(int x, int y, int z) noexcept { return idx(x, y, z); }
 
 private:
     // internal index arithmetic (same as client)
@@ -88,23 +153,62 @@ private:
         return x + CHUNK_SIZE * (y + CHUNK_SIZE * z);
     }
 
-    // helper to get steady_clock now in ns (inline for header)
-    static inline uint64_t nowNs() noexcept {
-        return static_cast<uint64_t>(
-            std::chrono::duration_cast<std::chrono::nanoseconds>(
-                std::chrono::steady_clock::now().time_since_epoch()
-            ).count()
-            );
+    // Block storage uses the smallest representation that holds the chunk's distinct blocks:
+    // a single uniform block, 1/2/4-bit indices into m_palette, or one byte per block.
+    // Enum values are bits per block.
+    //
+    // Writers hold m_mutex exclusively and bracket every storage change with an odd m_storageSeq;
+    // point readers take no lock and retry when the sequence was odd or moved. Each non-uniform
+    // mode owns a fixed-size buffer allocated on first use. When the chunk moves to another mode
+    // the old buffer is retired, not freed: a reader on a torn view may still load it. Readers pin
+    // a global storage epoch (ReadScope) and retiring bumps it, so a retired buffer is freed only
+    // once every reader pinned at or before its retire epoch has left. A reader stalled inside a
+    // scope delays frees but never sees freed memory. All fields a reader can see are atomics
+    // accessed relaxed; the sequence provides the ordering.
+    enum class StorageMode : uint8_t { Uniform = 0, Palette1 = 1, Palette2 = 2, Palette4 = 4, Dense = 8 };
+    static constexpr size_t kStorageBufferCount = 4; // Palette1, Palette2, Palette4, Dense
+    std::atomic<uint32_t> m_storageSeq{ 0 };
+    std::atomic<StorageMode> m_storageMode{ StorageMode::Uniform };
+    uint8_t m_paletteSize = 1; // writer-only
+    std::array<std::atomic<BlockID>, 16> m_palette{}; // m_palette[0] is the block of a Uniform chunk
+    std::array<std::atomic<std::atomic<uint8_t>*>, kStorageBufferCount> m_storageBuffers{};
+    uint8_t m_retiredStorage = 0; // writer-only; bit per slot whose buffer the current mode does not use
+    std::array<uint64_t, kStorageBufferCount> m_storageRetiredEpoch{}; // writer-only; storage epoch
+    std::atomic<uint16_t> m_nonAirCount{ 0 }; // modified under write-lock
+    std::atomic<uint64_t> m_brickOccupancy{ 0 }; // modified under write-lock
+
+    static constexpr size_t storageBufferSlot(StorageMode mode) noexcept {
+        return mode == StorageMode::Palette1 ? 0 : mode == StorageMode::Palette2 ? 1 : mode == StorageMode::Palette4 ? 2 : 3;
     }
-
-    // Raw voxel data (same memory layout as client). Using BlockID so server and client wire format match.
-    std::array<BlockID, CHUNK_VOLUME> m_blocks;
-    uint16_t m_nonAirCount = 0; // modified under write-lock
+    BlockID readBlock(int index) const noexcept;
+    // No sequence check: callers either hold m_mutex or validate with m_storageSeq.
+    BlockID readBlockRelaxed(int index) const noexcept;
+    void beginStorageWriteLocked() noexcept;
+    void endStorageWriteLocked() noexcept;
+    std::atomic<uint8_t>* storageBufferLocked(StorageMode mode);
+    // Retires buffers the current mode does not use and frees those no pinned reader can still hold.
+    size_t updateRetiredStorageLocked() noexcept;
+    void writeBlockLocked(int index, BlockID id);
+    // Re-encodes from dense voxels, optionally reserving a palette slot for `extra`.
+    void encodeBlocksLocked(const BlockID* blocks, std::optional<BlockID> extra = std::nullopt);
+    void decodeBlocksLocked(BlockID* outBlocks) const noexcept;
 
     // authority metadata
-    mutable std::shared_mutex m_mutex; // shared for readers, exclusive for writers
+    mutable std::shared_mutex m_mutex; // exclusive for writers, shared for bulk readers (serialize/diffs)
     std::atomic<int64_t> m_version{ 0 };  // increment on every applied edit (atomic for lock-free reads)
     std::atomic<bool> m_dirty{ false };
+    static constexpr uint8_t kUndecorated = 0;
+    static constexpr uint8_t kDecorating = 1;
+    static constexpr uint8_t kDecorated = 2;
+    std::atomic<uint8_t> m_decoration{ kUndecorated };
+    DirtyCallback m_dirtyCallback = nullptr;
+    void* m_dirtyContext = nullptr;
+
+    // wire bytes cache; lock order is m_mutex -> m_wireCacheMutex
+    mutable std::mutex m_wireCacheMutex;
+    SharedBytes m_wireCache;
+    int64_t m_wireCacheVersion = -1;
+    void dropWireCache() noexcept;
 
     // bounded edit log to support diffs. Keep it reasonably sized.
     std::deque<EditOp> m_editLog;
@@ -113,11 +217,17 @@ private:
     // subscribers: set of client ids who should receive diffs/edits for this chunk
     std::unordered_set<ClientId> m_subscribers;
 
-    // last access for eviction heuristics: store as atomic nanoseconds from steady_clock epoch
-    mutable std::atomic<uint64_t> m_lastAccessNs{ nowNs() };
+    inline static std::atomic<uint32_t> s_accessEpoch{ 0 };
+    mutable std::atomic<uint32_t> m_lastAccessEpoch{ 0 };
 
-    // update access time (can be called under shared_lock or unique_lock)
-    void touchLockedAtomic() const noexcept { m_lastAccessNs.store(nowNs(), std::memory_order_relaxed); }
+    // Only stores when the epoch moved, so concurrent readers of a hot chunk do not keep
+    // bouncing its cache line. Safe with or without m_mutex held.
+    void touchAccess() const noexcept {
+        const uint32_t epoch = s_accessEpoch.load(std::memory_order_relaxed);
+        if (m_lastAccessEpoch.load(std::memory_order_relaxed) != epoch) {
+            m_lastAccessEpoch.store(epoch, std::memory_order_relaxed);
+        }
+    }
 
     // compression helpers: prefer LZ4; here we provide placeholder wrapper signatures
     static std::vector<uint8_t> compressBlob(const uint8_t* data, size_t size);
@@ -379,12 +379,22 @@ void App::processShooting(Runtime& runtime) {
     const glm::vec3 shootDir = glm::normalize(cam.front);
     const glm::vec3 shootPos = cam.position;
     const uint32_t shotId = runtime.nextClientShotId++;
-    const uint32_t clientTick = runtime.hasAppliedServerTick ? runtime.lastAppliedServerTick : 0u;
+    // Tag the shot with the moment remote players were drawn at, so the server rewinds to what
+    // we actually aimed at rather than to the newest snapshot.
+    uint32_t clientTick = runtime.hasAppliedServerTick ? runtime.lastAppliedServerTick : 0u;
+    uint8_t clientTickFraction = 0;
+    uint32_t renderTick = 0;
+    uint8_t renderFraction = 0;
+    if (runtime.snapshotInterpolator.GetRenderTick(renderTick, renderFraction)) {
+        clientTick = renderTick;
+        clientTickFraction = renderFraction;
+    }
     const uint32_t seed = shotId ^ (clientTick * 2654435761u);
 
     if (runtime.clientNet.SendShootRequest(
         shotId,
         clientTick,
+        clientTickFraction,
         runtime.equippedGun->getWeaponId(),
         shootPos,
         shootDir,
@@ -802,16 +812,29 @@ void App::processChunkStreaming(Runtime& runtime, bool prioritizeMovement) {
         ).count();
         return elapsedUs < chunkApplyBudgetUs;
     };
-    size_t chunkDataApplied = 0;
 
+    // Decode and chunk construction run on the worker pool; this thread only hands packets off and
+    // swaps finished chunks in, before deltas so they land on the freshest snapshot.
     ChunkData chunkData;
+    size_t chunkDataSubmitted = 0;
     while (
-        chunkDataApplied < Runtime::MaxChunkDataApplyPerFrame &&
-        withinChunkApplyBudget() &&
+        chunkDataSubmitted < Runtime::MaxChunkDataSubmitPerFrame &&
+        runtime.chunkManager->pendingNetworkChunkCount() < Runtime::MaxChunkDataDecodesInFlight &&
         runtime.clientNet.PopChunkData(chunkData)
     ) {
-        runtime.chunkManager->applyNetworkChunkData(chunkData);
-        ++chunkDataApplied;
+        runtime.chunkManager->submitNetworkChunkData(std::move(chunkData));
+        ++chunkDataSubmitted;
+    }
+
+    std::vector<glm::ivec3> chunkResyncs;
+    const int64_t chunkInstallBudgetUs = chunkApplyBudgetUs - std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - chunkApplyStart
+    ).count();
+    if (chunkInstallBudgetUs > 0) {
+        runtime.chunkManager->installNetworkChunks(Runtime::MaxChunkDataInstallPerFrame, chunkInstallBudgetUs, chunkResyncs);
+    }
+    for (const glm::ivec3& chunkPos : chunkResyncs) {
+        requestChunkResync(chunkPos, false);
     }
 
     ChunkDelta chunkDelta;
@@ -1344,7 +1367,7 @@ void App::processFrame(Runtime& runtime) {
     const ClientNetwork::ChunkQueueDepths queueDepths = runtime.clientNet.GetChunkQueueDepths();
     const bool frameUnderPressure = GameData::deltaTime > (Runtime::LocalPredictionStep * 1.2);
     const bool chunkBacklog =
-        queueDepths.chunkData > (Runtime::MaxChunkDataApplyPerFrame * 3) ||
+        queueDepths.chunkData > (Runtime::MaxChunkDataSubmitPerFrame * 3) ||
         queueDepths.chunkDelta > (Runtime::MaxChunkDeltaApplyPerFrame * 3) ||
         queueDepths.chunkUnload > (Runtime::MaxChunkUnloadApplyPerFrame * 3);
     const bool prioritizeMovement = (localPredictionSteps > 1) || frameUnderPressure || chunkBacklog;
@@ -0,0 +1,614 @@
+// Offline chunk mesher benchmark.
+//
+// Meshes every non-air chunk of a corpus with ChunkMeshBuilder the way ChunkManager's mesh
+// workers do: one builder per thread, neighbours taken from the corpus (absent ones count as air)
+// and sun heights from column tops precomputed like ChunkManager::rebuildColumnSunCache. Reports
+// chunks/sec, vertices and indices per chunk, and p50/p99 of each phase from
+// ChunkMeshBuilder::getLastBuildTimes().
+//
+// The corpus is either a server world directory (the r.<x>.<y>.<z>.vrg region files ChunkStore
+// writes, read back the way ChunkStore::loadChunk does) or, without --corpus, terrain generated
+// with the same noise, layers and trees as the client WorldGen::generateChunkAt.
+//
+// usage: ChunkMeshBench [--corpus=<dir>] [--radius=6] [--seed=1337] [--ao=on|off|both]
+//                       [--shadows=on|off|both] [--threads=1,4] [--mode=binary|greedy|both] [--reps=5]
+
+#include "../graphics/ChunkMeshBuilder.hpp"
+#include "../graphics/TextureAtlas.hpp"
+#include "../voxels/Chunk.hpp"
+#include "../ExternLibs/FastNoiseLite.h"
+#include "../../VoxelOps-Headless/network/CompressChunk.hpp"
+#include "../../VoxelOps-Headless/network/RegionFile.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// Same vertical extent as ChunkManager.hpp; the benchmark does not pull in ChunkManager.
+constexpr int kWorldMinY = -16;
+constexpr int kWorldMaxY = 32;
+
+constexpr glm::ivec3 kNeighborOffsets[6] = {
+    { 1, 0, 0 }, { -1, 0, 0 },
+    { 0, 1, 0 }, { 0, -1, 0 },
+    { 0, 0, 1 }, { 0, 0, -1 }
+};
+
+struct IVec3Hash {
+    size_t operator()(const glm::ivec3& v) const noexcept {
+        return (size_t(uint32_t(v.x)) * 73856093u) ^ (size_t(uint32_t(v.y)) * 19349663u) ^ (size_t(uint32_t(v.z)) * 83492791u);
+    }
+};
+
+struct Corpus {
+    std::unordered_map<glm::ivec3, std::unique_ptr<Chunk>, IVec3Hash> chunks;
+    // Highest non-air world Y per block column over [minX, minX + sizeX) x [minZ, minZ + sizeZ).
+    int minX = 0;
+    int minZ = 0;
+    int sizeX = 0;
+    int sizeZ = 0;
+    std::vector<int> columnTop;
+
+    int topOccluderY(int worldX, int worldZ) const {
+        const int x = worldX - minX;
+        const int z = worldZ - minZ;
+        if (x < 0 || z < 0 || x >= sizeX || z >= sizeZ) {
+            return kWorldMinY - 1;
+        }
+        return columnTop[size_t(z) * size_t(sizeX) + size_t(x)];
+    }
+};
+
+struct MeshTarget {
+    glm::ivec3 pos{ 0 };
+    const Chunk* center = nullptr;
+    const Chunk* neighbors[6] = {};
+};
+
+struct Options {
+    std::string corpusDir;
+    int radius = 6;
+    int seed = 1337;
+    std::vector<bool> aoModes{ false, true };
+    std::vector<bool> shadowModes{ false, true };
+    std::vector<unsigned> threadCounts{ 1u };
+    std::vector<ChunkMeshingMode> meshingModes{ ChunkMeshingMode::Binary };
+    int reps = 5;
+};
+
+int FloorDiv(int v, int d) {
+    return (v >= 0) ? (v / d) : -((-v + d - 1) / d);
+}
+
+Chunk* FindChunk(Corpus& corpus, const glm::ivec3& pos) {
+    auto it = corpus.chunks.find(pos);
+    return (it != corpus.chunks.end()) ? it->second.get() : nullptr;
+}
+
+BlockID GetWorldBlock(Corpus& corpus, const glm::ivec3& world) {
+    const glm::ivec3 chunkPos(FloorDiv(world.x, CHUNK_SIZE), FloorDiv(world.y, CHUNK_SIZE), FloorDiv(world.z, CHUNK_SIZE));
+    const Chunk* chunk = FindChunk(corpus, chunkPos);
+    if (chunk == nullptr) {
+        return BlockID::Air;
+    }
+    const glm::ivec3 local = world - chunkPos * CHUNK_SIZE;
+    return chunk->getBlockUnchecked(local.x, local.y, local.z);
+}
+
+void SetWorldBlock(Corpus& corpus, const glm::ivec3& world, BlockID block) {
+    const glm::ivec3 chunkPos(FloorDiv(world.x, CHUNK_SIZE), FloorDiv(world.y, CHUNK_SIZE), FloorDiv(world.z, CHUNK_SIZE));
+    Chunk* chunk = FindChunk(corpus, chunkPos);
+    if (chunk == nullptr) {
+        return;
+    }
+    const glm::ivec3 local = world - chunkPos * CHUNK_SIZE;
+    chunk->setBlock(local.x, local.y, local.z, block);
+}
+
+// WorldGen::placeTree in world coordinates.
+void PlaceTree(Corpus& corpus, const glm::ivec3& base, std::mt19937& gen) {
+    std::uniform_int_distribution<> trunkHeightDist(10, 14);
+    std::uniform_real_distribution<float> holeChance(0.0f, 1.0f);
+    const int trunkHeight = trunkHeightDist(gen);
+    const int topY = base.y + trunkHeight - 1;
+    constexpr int kCrownRadius = 4;
+    constexpr int kCrownThickness = 2;
+
+    const auto placeTrunk = [&]() {
+        for (int i = 0; i < trunkHeight; ++i) {
+            for (int t = 0; t < 4; ++t) {
+                SetWorldBlock(corpus, base + glm::ivec3(t & 1, i, t >> 1), BlockID::Log);
+            }
+        }
+    };
+    placeTrunk();
+
+    for (int dy = 0; dy < kCrownThickness; ++dy) {
+        for (int dx = -kCrownRadius; dx <= kCrownRadius; ++dx) {
+            for (int dz = -kCrownRadius; dz <= kCrownRadius; ++dz) {
+                const float dist = std::sqrt(float(dx * dx + dz * dz));
+                if (dist > kCrownRadius + 0.25f) {
+                    continue;
+                }
+                const float edge = std::clamp((dist / float(kCrownRadius) - 0.7f) / 0.3f, 0.0f, 1.0f);
+                float skipProb = edge * edge * (3.0f - 2.0f * edge) * 0.65f;
+                if (dy == 0) skipProb *= 0.55f;
+                if (holeChance(gen) < skipProb) {
+                    continue;
+                }
+                const glm::ivec3 leaf(base.x + dx, topY + dy, base.z + dz);
+                if (GetWorldBlock(corpus, leaf) == BlockID::Air) {
+                    SetWorldBlock(corpus, leaf, BlockID::Leaves);
+                }
+            }
+        }
+    }
+
+    const int taperRadius = std::max(1, kCrownRadius - 2);
+    for (int dx = -taperRadius; dx <= taperRadius; ++dx) {
+        for (int dz = -taperRadius; dz <= taperRadius; ++dz) {
+            const float dist = std::sqrt(float(dx * dx + dz * dz));
+            if (dist > taperRadius + 0.25f) {
+                continue;
+            }
+            const glm::ivec3 leaf(base.x + dx, topY + kCrownThickness, base.z + dz);
+            if (GetWorldBlock(corpus, leaf) == BlockID::Air) {
+                if (dist > (taperRadius - 0.5f) && holeChance(gen) < 0.25f) continue;
+                SetWorldBlock(corpus, leaf, BlockID::Leaves);
+            }
+        }
+    }
+
+    placeTrunk();
+}
+
+// Terrain and trees of WorldGen::generateChunkAt over a (2 * radius + 1)^2 column square.
+void GenerateCorpus(Corpus& corpus, int radius, int seed) {
+    FastNoiseLite noise;
+    noise.SetNoiseType(FastNoiseLite::NoiseType_Perlin);
+    noise.SetFrequency(0.009f);
+    noise.SetSeed(seed);
+    std::mt19937 gen(static_cast<uint32_t>(seed));
+    std::uniform_real_distribution<> chance(0.0, 1.0);
+
+    const int minChunkY = kWorldMinY / CHUNK_SIZE;
+    const int maxChunkY = kWorldMaxY / CHUNK_SIZE;
+    for (int cz = -radius; cz <= radius; ++cz) {
+        for (int cx = -radius; cx <= radius; ++cx) {
+            for (int cy = minChunkY; cy <= maxChunkY; ++cy) {
+                corpus.chunks.emplace(glm::ivec3(cx, cy, cz), std::make_unique<Chunk>(glm::ivec3(cx, cy, cz)));
+            }
+        }
+    }
+
+    for (int cz = -radius; cz <= radius; ++cz) {
+        for (int cx = -radius; cx <= radius; ++cx) {
+            for (int z = 0; z < CHUNK_SIZE; ++z) {
+                for (int x = 0; x < CHUNK_SIZE; ++x) {
+                    const int worldX = cx * CHUNK_SIZE + x;
+                    const int worldZ = cz * CHUNK_SIZE + z;
+                    float n = 0.0f;
+                    float frequency = 1.01f;
+                    float amplitude = 0.8f;
+                    float maxAmplitude = 0.0f;
+                    for (int octave = 0; octave < 6; ++octave) {
+                        n += noise.GetNoise(worldX * frequency, worldZ * frequency) * amplitude;
+                        maxAmplitude += amplitude;
+                        frequency *= 2.0f;
+                        amplitude *= 0.5f;
+                    }
+                    n /= maxAmplitude;
+                    const int height = kWorldMinY + static_cast<int>((n + 1.0f) * 0.5f * (kWorldMaxY - kWorldMinY));
+
+                    for (int worldY = kWorldMinY; worldY < (maxChunkY + 1) * CHUNK_SIZE; ++worldY) {
+                        BlockID block = BlockID::Air;
+                        if (worldY == kWorldMinY) block = BlockID::Bedrock;
+                        else if (worldY < height - 2) block = BlockID::Stone;
+                        else if (worldY < height - 1) block = BlockID::Dirt;
+                        else if (worldY < height) block = BlockID::Grass;
+                        if (block != BlockID::Air) {
+                            SetWorldBlock(corpus, glm::ivec3(worldX, worldY, worldZ), block);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Trees go in after all terrain, chunk by chunk, from the topmost grass block of each chunk column.
+    for (int cz = -radius; cz <= radius; ++cz) {
+        for (int cx = -radius; cx <= radius; ++cx) {
+            for (int cy = minChunkY; cy <= maxChunkY; ++cy) {
+                const Chunk* chunk = FindChunk(corpus, glm::ivec3(cx, cy, cz));
+                for (int z = 0; z < CHUNK_SIZE; ++z) {
+                    for (int x = 0; x < CHUNK_SIZE; ++x) {
+                        int topY = -1;
+                        for (int y = CHUNK_SIZE - 1; y >= 0; --y) {
+                            if (chunk->getBlockUnchecked(x, y, z) == BlockID::Grass) {
+                                topY = y;
+                                break;
+                            }
+                        }
+                        if (topY != -1 && chance(gen) < 0.003) {
+                            const glm::ivec3 base = glm::ivec3(cx, cy, cz) * CHUNK_SIZE + glm::ivec3(x, topY - 4, z);
+                            PlaceTree(corpus, base, gen);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ServerChunk::serializeCompressed() layout:
+// [int32 cx][int32 cy][int32 cz][int64 version][uint8 flags][int32 dataSize][raw BlockIDs]
+bool AdoptChunkBlob(const std::vector<uint8_t>& blob, const glm::ivec3& expectedPos, Corpus& corpus) {
+    constexpr size_t kHeaderBytes = 4 + 4 + 4 + 8 + 1 + 4;
+    if (blob.size() < kHeaderBytes) {
+        return false;
+    }
+    const auto read32 = [&blob](size_t offset) -> int32_t {
+        return int32_t(uint32_t(blob[offset]) | (uint32_t(blob[offset + 1]) << 8) | (uint32_t(blob[offset + 2]) << 16) | (uint32_t(blob[offset + 3]) << 24));
+    };
+    const glm::ivec3 pos(read32(0), read32(4), read32(8));
+    const uint8_t flags = blob[20];
+    const int32_t dataSize = read32(21);
+    if (pos != expectedPos || (flags & 1u) != 0u) {
+        return false;
+    }
+    if (dataSize < int32_t(sizeof(ChunkBlockBuffer)) || blob.size() < kHeaderBytes + size_t(dataSize)) {
+        return false;
+    }
+
+    auto blocks = std::make_shared<ChunkBlockBuffer>();
+    std::memcpy(blocks->data(), blob.data() + kHeaderBytes, sizeof(ChunkBlockBuffer));
+    for (BlockID& block : *blocks) {
+        if (uint8_t(block) >= uint8_t(BlockID::COUNT)) {
+            block = BlockID::Air;
+        }
+    }
+    auto chunk = std::make_unique<Chunk>(pos);
+    chunk->adoptBlocks(std::move(blocks));
+    corpus.chunks[pos] = std::move(chunk);
+    return true;
+}
+
+// Loads every chunk stored in one region file; chunks that fail to read, decompress or parse
+// are counted in `skipped`. Returns false if the file is not a region file.
+bool LoadRegionFile(const std::filesystem::path& path, Corpus& corpus, size_t& skipped) {
+    glm::ivec3 regionPos(0);
+    const std::string name = path.filename().string();
+    if (path.extension() != ".vrg" ||
+        std::sscanf(name.c_str(), "r.%d.%d.%d.vrg", &regionPos.x, &regionPos.y, &regionPos.z) != 3) {
+        return false;
+    }
+    RegionFile region(path);
+    if (!region.open(false)) {
+        std::fprintf(stderr, "%s: not a readable region file\n", name.c_str());
+        return false;
+    }
+
+    std::vector<uint8_t> payload;
+    std::vector<uint8_t> blob;
+    for (int local = 0; local < REGION_CHUNK_COUNT; ++local) {
+        if (!region.hasChunk(local)) {
+            continue;
+        }
+        const glm::ivec3 chunkPos = regionPos * REGION_SIZE +
+            glm::ivec3(local % REGION_SIZE, (local / REGION_SIZE) % REGION_SIZE, local / (REGION_SIZE * REGION_SIZE));
+        uint32_t flags = 0;
+        if (!region.readChunk(local, payload, flags) ||
+            !DecompressChunkPayload((flags & RegionFile::kFlagCompressed) != 0, payload, blob) ||
+            !AdoptChunkBlob(blob, chunkPos, corpus)) {
+            ++skipped;
+        }
+    }
+    return true;
+}
+
+void BuildColumnTops(Corpus& corpus) {
+    if (corpus.chunks.empty()) {
+        return;
+    }
+    int minCX = INT32_MAX, maxCX = INT32_MIN, minCZ = INT32_MAX, maxCZ = INT32_MIN;
+    for (const auto& [pos, chunk] : corpus.chunks) {
+        minCX = std::min(minCX, pos.x);
+        maxCX = std::max(maxCX, pos.x);
+        minCZ = std::min(minCZ, pos.z);
+        maxCZ = std::max(maxCZ, pos.z);
+    }
+    corpus.minX = minCX * CHUNK_SIZE;
+    corpus.minZ = minCZ * CHUNK_SIZE;
+    corpus.sizeX = (maxCX - minCX + 1) * CHUNK_SIZE;
+    corpus.sizeZ = (maxCZ - minCZ + 1) * CHUNK_SIZE;
+    corpus.columnTop.assign(size_t(corpus.sizeX) * size_t(corpus.sizeZ), kWorldMinY - 1);
+
+    for (const auto& [pos, chunk] : corpus.chunks) {
+        if (chunk->isCompletelyAir()) {
+            continue;
+        }
+        for (int z = 0; z < CHUNK_SIZE; ++z) {
+            for (int x = 0; x < CHUNK_SIZE; ++x) {
+                for (int y = CHUNK_SIZE - 1; y >= 0; --y) {
+                    if (chunk->getBlockUnchecked(x, y, z) != BlockID::Air) {
+                        int& top = corpus.columnTop[size_t(pos.z * CHUNK_SIZE + z - corpus.minZ) * size_t(corpus.sizeX) + size_t(pos.x * CHUNK_SIZE + x - corpus.minX)];
+                        top = std::max(top, pos.y * CHUNK_SIZE + y);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+std::vector<MeshTarget> CollectTargets(Corpus& corpus) {
+    std::vector<MeshTarget> targets;
+    for (const auto& [pos, chunk] : corpus.chunks) {
+        if (chunk->isCompletelyAir()) {
+            continue;
+        }
+        MeshTarget target;
+        target.pos = pos;
+        target.center = chunk.get();
+        for (int i = 0; i < 6; ++i) {
+            target.neighbors[i] = FindChunk(corpus, pos + kNeighborOffsets[i]);
+        }
+        targets.push_back(target);
+    }
+    // Deterministic order, so runs over the same corpus mesh chunks in the same sequence.
+    std::sort(targets.begin(), targets.end(), [](const MeshTarget& a, const MeshTarget& b) {
+        if (a.pos.y != b.pos.y) return a.pos.y < b.pos.y;
+        if (a.pos.z != b.pos.z) return a.pos.z < b.pos.z;
+        return a.pos.x < b.pos.x;
+    });
+    return targets;
+}
+
+struct ChunkSample {
+    MeshBuildPhaseTimes times;
+    uint32_t vertices = 0;
+    uint32_t indices = 0;
+};
+
+// Meshes every target once on `threadCount` threads; returns wall-clock seconds.
+double MeshPass(
+    const std::vector<MeshTarget>& targets,
+    const Corpus& corpus,
+    const TextureAtlas& atlas,
+    ChunkMeshingMode mode,
+    bool enableAO,
+    bool enableShadows,
+    unsigned threadCount,
+    std::vector<ChunkSample>& outSamples
+) {
+    outSamples.assign(targets.size(), ChunkSample{});
+    std::atomic<size_t> next{ 0 };
+    const ChunkMeshBuilder::SunTopGetter sunTop = [&corpus](int wx, int wz) { return corpus.topOccluderY(wx, wz); };
+
+    const auto worker = [&]() {
+        ChunkMeshBuilder builder;
+        builder.setMeshingMode(mode);
+        for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < targets.size(); i = next.fetch_add(1, std::memory_order_relaxed)) {
+            const MeshTarget& target = targets[i];
+            const Chunk* neighbors[6];
+            std::copy(std::begin(target.neighbors), std::end(target.neighbors), neighbors);
+            const BuiltChunkMesh built = builder.buildChunkMesh(*target.center, neighbors, target.pos, atlas, enableAO, enableShadows, sunTop);
+            ChunkSample& sample = outSamples[i];
+            sample.times = builder.getLastBuildTimes();
+            sample.vertices = uint32_t(built.vertices.size());
+            sample.indices = uint32_t(built.indices.size());
+        }
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Nearest-rank percentile in microseconds; sorts `values`.
+double PercentileUs(std::vector<uint64_t>& values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    const size_t rank = size_t(std::ceil(p * double(values.size())));
+    return double(values[std::min(values.size() - 1, rank > 0 ? rank - 1 : 0)]) / 1000.0;
+}
+
+void RunCase(
+    const std::vector<MeshTarget>& targets,
+    const Corpus& corpus,
+    const TextureAtlas& atlas,
+    ChunkMeshingMode mode,
+    bool enableAO,
+    bool enableShadows,
+    unsigned threadCount,
+    int reps
+) {
+    std::vector<ChunkSample> samples;
+    MeshPass(targets, corpus, atlas, mode, enableAO, enableShadows, threadCount, samples); // warm-up
+
+    constexpr size_t kPhaseCount = 7;
+    std::array<std::vector<uint64_t>, kPhaseCount> phases;
+    for (auto& phase : phases) {
+        phase.reserve(targets.size() * size_t(reps));
+    }
+    double seconds = 0.0;
+    uint64_t vertices = 0;
+    uint64_t indices = 0;
+    for (int rep = 0; rep < reps; ++rep) {
+        seconds += MeshPass(targets, corpus, atlas, mode, enableAO, enableShadows, threadCount, samples);
+        for (const ChunkSample& sample : samples) {
+            const MeshBuildPhaseTimes& t = sample.times;
+            phases[0].push_back(t.totalNs);
+            phases[1].push_back(t.blockGridNs);
+            phases[2].push_back(t.solidCacheNs);
+            phases[3].push_back(t.sunlightPrepNs);
+            phases[4].push_back(t.aoPrepNs);
+            phases[5].push_back(t.maskTransitionNs + t.maskLightingNs);
+            phases[6].push_back(t.greedyEmitNs);
+            vertices += sample.vertices;
+            indices += sample.indices;
+        }
+    }
+
+    const double meshed = double(targets.size()) * double(reps);
+    std::printf(
+        "%-6s %2s %3s %3u %10.0f %8.0f %8.0f",
+        (mode == ChunkMeshingMode::Binary) ? "binary" : "greedy",
+        enableAO ? "on" : "-",
+        enableShadows ? "on" : "-",
+        threadCount,
+        meshed / std::max(seconds, 1e-9),
+        double(vertices) / std::max(meshed, 1.0),
+        double(indices) / std::max(meshed, 1.0)
+    );
+    for (auto& phase : phases) {
+        const double p50 = PercentileUs(phase, 0.50);
+        const double p99 = PercentileUs(phase, 0.99);
+        std::printf(" %6.1f/%-6.1f", p50, p99);
+    }
+    std::printf("\n");
+}
+
+std::vector<bool> ParseToggle(const std::string& value) {
+    if (value == "on") return { true };
+    if (value == "off") return { false };
+    return { false, true };
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const size_t eq = arg.find('=');
+        if (arg.rfind("--", 0) != 0 || eq == std::string::npos) {
+            return false;
+        }
+        const std::string key = arg.substr(2, eq - 2);
+        const std::string value = arg.substr(eq + 1);
+        if (key == "corpus") {
+            options.corpusDir = value;
+        }
+        else if (key == "radius") {
+            options.radius = std::max(0, std::atoi(value.c_str()));
+        }
+        else if (key == "seed") {
+            options.seed = std::atoi(value.c_str());
+        }
+        else if (key == "ao") {
+            options.aoModes = ParseToggle(value);
+        }
+        else if (key == "shadows") {
+            options.shadowModes = ParseToggle(value);
+        }
+        else if (key == "threads") {
+            options.threadCounts.clear();
+            for (size_t begin = 0; begin <= value.size();) {
+                size_t end = value.find(',', begin);
+                if (end == std::string::npos) end = value.size();
+                const int count = std::atoi(value.substr(begin, end - begin).c_str());
+                if (count > 0) options.threadCounts.push_back(unsigned(count));
+                begin = end + 1;
+            }
+            if (options.threadCounts.empty()) {
+                return false;
+            }
+        }
+        else if (key == "mode") {
+            if (value == "binary") options.meshingModes = { ChunkMeshingMode::Binary };
+            else if (value == "greedy") options.meshingModes = { ChunkMeshingMode::Greedy };
+            else options.meshingModes = { ChunkMeshingMode::Greedy, ChunkMeshingMode::Binary };
+        }
+        else if (key == "reps") {
+            options.reps = std::max(1, std::atoi(value.c_str()));
+        }
+        else {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::fprintf(stderr,
+            "usage: ChunkMeshBench [--corpus=<dir>] [--radius=6] [--seed=1337] [--ao=on|off|both]\n"
+            "                      [--shadows=on|off|both] [--threads=1,4] [--mode=binary|greedy|both] [--reps=5]\n");
+        return 1;
+    }
+
+    Corpus corpus;
+    if (!options.corpusDir.empty()) {
+        size_t regions = 0;
+        size_t skipped = 0;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(options.corpusDir, ec)) {
+            if (entry.is_regular_file() && LoadRegionFile(entry.path(), corpus, skipped)) {
+                ++regions;
+            }
+        }
+        if (ec) {
+            std::fprintf(stderr, "cannot read corpus directory %s: %s\n", options.corpusDir.c_str(), ec.message().c_str());
+            return 1;
+        }
+        if (regions == 0) {
+            std::fprintf(stderr, "no region files (r.<x>.<y>.<z>.vrg) in %s\n", options.corpusDir.c_str());
+            return 1;
+        }
+        std::printf("corpus=%s regions=%zu chunks=%zu skipped=%zu\n", options.corpusDir.c_str(), regions, corpus.chunks.size(), skipped);
+    }
+    else {
+        GenerateCorpus(corpus, options.radius, options.seed);
+        std::printf("corpus=generated radius=%d seed=%d chunks=%zu\n", options.radius, options.seed, corpus.chunks.size());
+    }
+    BuildColumnTops(corpus);
+
+    const std::vector<MeshTarget> targets = CollectTargets(corpus);
+    if (targets.empty()) {
+        std::fprintf(stderr, "corpus has no non-air chunks\n");
+        return 1;
+    }
+
+    const TextureAtlas atlas{ TextureAtlas::TilesOnly{} };
+    std::printf("meshed chunks=%zu reps=%d, phase columns are p50/p99 us\n", targets.size(), options.reps);
+    std::printf(
+        "%-6s %2s %3s %3s %10s %8s %8s %13s %13s %13s %13s %13s %13s %13s\n",
+        "mode", "ao", "sun", "thr", "chunks/s", "verts", "indices",
+        "total", "blockGrid", "solidCache", "sunlight", "ao", "mask", "emit"
+    );
+    for (const ChunkMeshingMode mode : options.meshingModes) {
+        for (const bool ao : options.aoModes) {
+            for (const bool shadows : options.shadowModes) {
+                for (const unsigned threads : options.threadCounts) {
+                    RunCase(targets, corpus, atlas, mode, ao, shadows, threads, options.reps);
+                }
+            }
+        }
+    }
+    return 0;
+}
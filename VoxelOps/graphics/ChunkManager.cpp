@@ -66,6 +66,20 @@ uint32_t fnv1a32(const uint8_t* data, size_t size)
     }
     return h;
 }
+
+void logStaleChunkData(const glm::ivec3& chunkPos, uint64_t incomingVersion, uint64_t knownVersion)
+{
+    static uint64_t staleChunkDataCount = 0;
+    ++staleChunkDataCount;
+    if (staleChunkDataCount <= 20 || (staleChunkDataCount % 100) == 0) {
+        std::cerr
+            << "[chunk/apply] stale ChunkData ignored chunk=("
+            << chunkPos.x << "," << chunkPos.y << "," << chunkPos.z << ")"
+            << " incomingVersion=" << incomingVersion
+            << " knownVersion=" << knownVersion
+            << " count=" << staleChunkDataCount << "\n";
+    }
+}
 }
 
 constexpr double kChunkMeshBuildLogThresholdMs = 2.0;
@@ -190,6 +204,7 @@ void ChunkManager::updateDirtyChunks(size_t maxChunksPerCall, int64_t maxBudgetU
         if (it != chunkMap.end()) {
             const auto ticketIt = m_chunkBuildTickets.find(ready.chunkPos);
             if (ticketIt == m_chunkBuildTickets.end() || ticketIt->second != ready.buildTicket) {
+                m_meshBufferPool.release(std::move(ready.vertices), std::move(ready.indices));
                 continue;
             }
 
@@ -213,6 +228,7 @@ void ChunkManager::updateDirtyChunks(size_t maxChunksPerCall, int64_t maxBudgetU
                 m_dirtyChunkQueue.push_back(ready.chunkPos);
             }
         }
+        m_meshBufferPool.release(std::move(ready.vertices), std::move(ready.indices));
     }
 
     while (!m_dirtyChunkQueue.empty() && !outOfBudget()) {
@@ -318,21 +334,53 @@ void ChunkManager::updateChunks(const glm::ivec3& playerWorldPos, int renderDist
     }
 }
 
-bool ChunkManager::applyNetworkChunkData(const ChunkData& packet) {
+void ChunkManager::submitNetworkChunkData(ChunkData packet) {
+    const glm::ivec3 chunkPos(packet.chunkX, packet.chunkY, packet.chunkZ);
+    auto knownVersionIt = m_networkChunkVersions.find(chunkPos);
+    if (knownVersionIt != m_networkChunkVersions.end() && packet.version <= knownVersionIt->second) {
+        logStaleChunkData(chunkPos, packet.version, knownVersionIt->second);
+        return;
+    }
+    auto pendingIt = m_pendingNetworkChunkDecodes.find(chunkPos);
+    if (pendingIt != m_pendingNetworkChunkDecodes.end() && packet.version <= pendingIt->second.version) {
+        logStaleChunkData(chunkPos, packet.version, pendingIt->second.version);
+        return;
+    }
+
+    PendingNetworkChunkDecode& pending = m_pendingNetworkChunkDecodes[chunkPos];
+    pending.decodeTicket = m_nextNetworkChunkDecodeTicket++;
+    pending.version = packet.version;
+
+    meshPool.enqueue([this, packet = std::move(packet), decodeTicket = pending.decodeTicket]() mutable {
+        this->decodeNetworkChunkWorker(std::move(packet), decodeTicket);
+    });
+}
+
+void ChunkManager::decodeNetworkChunkWorker(ChunkData packet, uint64_t decodeTicket) {
+    NetworkChunkDecodeResult ready;
+    ready.chunkPos = glm::ivec3(packet.chunkX, packet.chunkY, packet.chunkZ);
+    ready.decodeTicket = decodeTicket;
+
+    const auto publish = [this, &ready]() {
+        std::lock_guard<std::mutex> lock(m_readyNetworkChunksMutex);
+        m_readyNetworkChunks.push_back(std::move(ready));
+    };
+
     std::vector<uint8_t> decodedPayload;
     if (!DecompressChunkPayload(packet.flags, packet.payload, decodedPayload)) {
         std::cerr
             << "[chunk/apply] failed to decode payload flags=" << static_cast<int>(packet.flags)
             << " chunk=(" << packet.chunkX << "," << packet.chunkY << "," << packet.chunkZ << ")"
             << " payloadBytes=" << packet.payload.size() << "\n";
-        return false;
+        publish();
+        return;
     }
 
     const std::vector<uint8_t>& payload = decodedPayload;
     const uint32_t payloadHash = fnv1a32(packet.payload.data(), packet.payload.size());
     const size_t rawBlockBytes = CHUNK_VOLUME * sizeof(BlockID);
     const uint8_t* raw = nullptr;
-    glm::ivec3 chunkPos(packet.chunkX, packet.chunkY, packet.chunkZ);
+    const glm::ivec3 chunkPos = ready.chunkPos;
     uint64_t incomingVersion = packet.version;
 
     // payload format mirrors ServerChunk::serializeCompressed():
@@ -381,7 +429,8 @@ bool ChunkManager::applyNetworkChunkData(const ChunkData& packet) {
                     << packet.chunkX << "," << packet.chunkY << "," << packet.chunkZ
                     << ") payload=("
                     << payloadX << "," << payloadY << "," << payloadZ << ")\n";
-                return false;
+                publish();
+                return;
             }
 
             if (payloadVersion < 0) {
@@ -389,7 +438,8 @@ bool ChunkManager::applyNetworkChunkData(const ChunkData& packet) {
                     << "[chunk/apply] invalid negative payload version chunk=("
                     << packet.chunkX << "," << packet.chunkY << "," << packet.chunkZ << ")"
                     << " version=" << payloadVersion << "\n";
-                return false;
+                publish();
+                return;
             }
             incomingVersion = static_cast<uint64_t>(payloadVersion);
             if (incomingVersion != packet.version) {
@@ -398,7 +448,8 @@ bool ChunkManager::applyNetworkChunkData(const ChunkData& packet) {
                     << packet.chunkX << "," << packet.chunkY << "," << packet.chunkZ << ")"
                     << " packetVersion=" << packet.version
                     << " payloadVersion=" << incomingVersion << "\n";
-                return false;
+                publish();
+                return;
             }
             raw = payload.data() + offset;
         }
@@ -411,7 +462,8 @@ bool ChunkManager::applyNetworkChunkData(const ChunkData& packet) {
                 << "[chunk/apply] invalid ChunkData payload size="
                 << payload.size() << " expected=" << rawBlockBytes
                 << " chunk=(" << packet.chunkX << "," << packet.chunkY << "," << packet.chunkZ << ")\n";
-            return false;
+            publish();
+            return;
         }
         std::cerr
             << "[chunk/apply] using raw fallback payload for chunk=("
@@ -419,39 +471,13 @@ bool ChunkManager::applyNetworkChunkData(const ChunkData& packet) {
         raw = payload.data();
     }
 
-    auto knownVersionIt = m_networkChunkVersions.find(chunkPos);
-    if (knownVersionIt != m_networkChunkVersions.end() && incomingVersion <= knownVersionIt->second) {
-        static uint64_t staleChunkDataCount = 0;
-        ++staleChunkDataCount;
-        if (staleChunkDataCount <= 20 || (staleChunkDataCount % 100) == 0) {
-            std::cerr
-                << "[chunk/apply] stale ChunkData ignored chunk=("
-                << chunkPos.x << "," << chunkPos.y << "," << chunkPos.z << ")"
-                << " incomingVersion=" << incomingVersion
-                << " knownVersion=" << knownVersionIt->second
-                << " count=" << staleChunkDataCount << "\n";
-        }
-        return true;
-    }
-
-    removeChunkMesh(chunkPos);
-    chunkMap.erase(chunkPos);
-    m_chunkBuildTickets.erase(chunkPos);
-    auto [chunkIt, inserted] = chunkMap.try_emplace(chunkPos, chunkPos);
-    (void)inserted;
-  
-    Chunk& chunk = chunkIt->second;
+    auto blockBuffer = std::make_shared<ChunkBlockBuffer>();
+    ChunkBlockBuffer& blocks = *blockBuffer;
     size_t nonAirCount = 0;
-    for (int z = 0; z < CHUNK_SIZE; ++z) {
-        for (int y = 0; y < CHUNK_SIZE; ++y) {
-            for (int x = 0; x < CHUNK_SIZE; ++x) {
-                const size_t i = static_cast<size_t>(x + CHUNK_SIZE * (y + CHUNK_SIZE * z));
-                const BlockID id = static_cast<BlockID>(raw[i]);
-                if (id != BlockID::Air) {
-                    chunk.setBlock(x, y, z, id);
-                    ++nonAirCount;
-                }
-            }
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        blocks[i] = static_cast<BlockID>(raw[i]);
+        if (blocks[i] != BlockID::Air) {
+            ++nonAirCount;
         }
     }
 
@@ -465,7 +491,96 @@ bool ChunkManager::applyNetworkChunkData(const ChunkData& packet) {
             << " payloadBytes=" << payload.size() << "\n";
     }
 
-    rebuildColumnSunCache(chunkPos.x, chunkPos.z);
+    const int chunkWorldMinY = chunkPos.y * CHUNK_SIZE;
+    for (int x = 0; x < CHUNK_SIZE; ++x) {
+        for (int z = 0; z < CHUNK_SIZE; ++z) {
+            int top = WORLD_MIN_Y - 1;
+            for (int y = CHUNK_SIZE - 1; y >= 0; --y) {
+                if (blocks[static_cast<size_t>(x + CHUNK_SIZE * (y + CHUNK_SIZE * z))] != BlockID::Air) {
+                    top = chunkWorldMinY + y;
+                    break;
+                }
+            }
+            ready.columnTopY[x][z] = int8_t(top);
+        }
+    }
+
+    // Built in a throwaway map so the render thread can splice the node into chunkMap as is.
+    std::unordered_map<glm::ivec3, Chunk, IVec3Hash> staging;
+    auto [chunkIt, inserted] = staging.try_emplace(chunkPos, chunkPos);
+    (void)inserted;
+    chunkIt->second.adoptBlocks(std::move(blockBuffer));
+    ready.chunkNode = staging.extract(chunkIt);
+    ready.version = incomingVersion;
+    ready.decoded = true;
+    publish();
+}
+
+size_t ChunkManager::installNetworkChunks(size_t maxInstalls, int64_t maxBudgetUs, std::vector<glm::ivec3>& outResyncChunks) {
+    const auto start = std::chrono::steady_clock::now();
+    size_t installed = 0;
+    while (maxInstalls == 0 || installed < maxInstalls) {
+        if (maxBudgetUs > 0) {
+            const int64_t elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start
+            ).count();
+            if (elapsedUs >= maxBudgetUs) {
+                break;
+            }
+        }
+
+        NetworkChunkDecodeResult ready;
+        {
+            std::lock_guard<std::mutex> lock(m_readyNetworkChunksMutex);
+            if (m_readyNetworkChunks.empty()) {
+                break;
+            }
+            ready = std::move(m_readyNetworkChunks.front());
+            m_readyNetworkChunks.pop_front();
+        }
+
+        // Superseded by a newer ChunkData or dropped by an unload while it was decoding.
+        auto pendingIt = m_pendingNetworkChunkDecodes.find(ready.chunkPos);
+        if (pendingIt == m_pendingNetworkChunkDecodes.end() || pendingIt->second.decodeTicket != ready.decodeTicket) {
+            continue;
+        }
+        m_pendingNetworkChunkDecodes.erase(pendingIt);
+
+        if (ready.decoded && installNetworkChunk(ready)) {
+            ++installed;
+        }
+        applyDeferredNetworkChunkDeltas(ready.chunkPos, outResyncChunks);
+    }
+    return installed;
+}
+
+bool ChunkManager::installNetworkChunk(NetworkChunkDecodeResult& ready) {
+    const glm::ivec3 chunkPos = ready.chunkPos;
+    auto knownVersionIt = m_networkChunkVersions.find(chunkPos);
+    if (knownVersionIt != m_networkChunkVersions.end() && ready.version <= knownVersionIt->second) {
+        logStaleChunkData(chunkPos, ready.version, knownVersionIt->second);
+        return false;
+    }
+
+    removeChunkMesh(chunkPos);
+    const bool replaced = chunkMap.erase(chunkPos) > 0;
+    m_chunkBuildTickets.erase(chunkPos);
+    chunkMap.insert(std::move(ready.chunkNode));
+
+    if (replaced) {
+        rebuildColumnSunCache(chunkPos.x, chunkPos.z);
+    }
+    else if (enableShadows) {
+        // A new chunk only adds blocks to its column, so the cached tops can only rise.
+        ChunkColumn& col = getOrCreateColumn(chunkPos.x, chunkPos.z);
+        for (int lx = 0; lx < CHUNK_SIZE; ++lx) {
+            for (int lz = 0; lz < CHUNK_SIZE; ++lz) {
+                if (ready.columnTopY[lx][lz] > col.sunLitBlocksYvalue[lx][lz]) {
+                    col.sunLitBlocksYvalue[lx][lz] = ready.columnTopY[lx][lz];
+                }
+            }
+        }
+    }
     markChunkDirty(chunkPos);
 
     static const glm::ivec3 dirs[6] = {
@@ -480,12 +595,42 @@ bool ChunkManager::applyNetworkChunkData(const ChunkData& packet) {
         }
     }
 
-    m_networkChunkVersions[chunkPos] = incomingVersion;
+    m_networkChunkVersions[chunkPos] = ready.version;
     return true;
 }
 
+void ChunkManager::applyDeferredNetworkChunkDeltas(const glm::ivec3& chunkPos, std::vector<glm::ivec3>& outResyncChunks) {
+    auto deferredIt = m_deferredNetworkChunkDeltas.find(chunkPos);
+    if (deferredIt == m_deferredNetworkChunkDeltas.end()) {
+        return;
+    }
+    const std::vector<ChunkDelta> deltas = std::move(deferredIt->second);
+    m_deferredNetworkChunkDeltas.erase(deferredIt);
+
+    for (const ChunkDelta& delta : deltas) {
+        const NetworkChunkDeltaApplyResult result = applyNetworkChunkDelta(delta);
+        if (
+            result == NetworkChunkDeltaApplyResult::MissingBaseChunk ||
+            result == NetworkChunkDeltaApplyResult::VersionGap
+        ) {
+            outResyncChunks.push_back(chunkPos);
+            return;
+        }
+    }
+}
+
+size_t ChunkManager::pendingNetworkChunkCount() const {
+    return m_pendingNetworkChunkDecodes.size();
+}
+
 NetworkChunkDeltaApplyResult ChunkManager::applyNetworkChunkDelta(const ChunkDelta& packet) {
     const glm::ivec3 chunkPos(packet.chunkX, packet.chunkY, packet.chunkZ);
+    if (m_pendingNetworkChunkDecodes.find(chunkPos) != m_pendingNetworkChunkDecodes.end()) {
+        // Applies on top of the snapshot still decoding; replayed once that snapshot is installed.
+        m_deferredNetworkChunkDeltas[chunkPos].push_back(packet);
+        return NetworkChunkDeltaApplyResult::Deferred;
+    }
+
     auto it = chunkMap.find(chunkPos);
     if (it == chunkMap.end()) {
         static uint64_t missingChunkDeltaCount = 0;
@@ -582,6 +727,8 @@ NetworkChunkDeltaApplyResult ChunkManager::applyNetworkChunkDelta(const ChunkDel
 
 void ChunkManager::applyNetworkChunkUnload(const ChunkUnload& packet) {
     const glm::ivec3 chunkPos(packet.chunkX, packet.chunkY, packet.chunkZ);
+    m_pendingNetworkChunkDecodes.erase(chunkPos);
+    m_deferredNetworkChunkDeltas.erase(chunkPos);
     auto it = chunkMap.find(chunkPos);
     if (it == chunkMap.end()) {
         m_networkChunkVersions.erase(chunkPos);
@@ -787,6 +934,14 @@ void ChunkManager::debugMemoryEstimate()
         std::cout << "  greedy emit: " << (double(p.greedyEmitUs) * invChunks) << " us (" << pct(p.greedyEmitUs) << "%)\n";
         std::cout << "  other/unprofiled: " << (double(otherUs) * invChunks) << " us (" << pct(otherUs) << "%)\n";
     }
+
+    const ChunkMeshBufferPool::Stats pool = m_meshBufferPool.stats();
+    std::cout << "Mesh buffer pool: "
+        << pool.pooledBuffers << " buffers, "
+        << (double(pool.pooledBytes) / (1024.0 * 1024.0)) << " MB pooled, "
+        << pool.reuses << "/" << pool.acquires << " acquires reused, "
+        << pool.allocations << " allocated, "
+        << pool.discards << "/" << pool.releases << " releases discarded\n";
 }
 
 
@@ -897,9 +1052,10 @@ bool ChunkManager::requestChunkRebuild(const glm::ivec3& pos) {
     m_chunkBuildTickets[pos] = job.buildTicket;
     job.enableAO = enableAO;
     job.enableShadows = enableShadows;
+    job.meshingMode = meshingMode;
     job.chunkWorldMinX = pos.x * CHUNK_SIZE;
     job.chunkWorldMinZ = pos.z * CHUNK_SIZE;
-    chunk.copyBlocks(job.centerBlocks);
+    job.center = chunk.snapshotBlocks();
 
     constexpr glm::ivec3 offsets[6] = {
         {1, 0, 0}, {-1, 0, 0},
@@ -912,8 +1068,7 @@ bool ChunkManager::requestChunkRebuild(const glm::ivec3& pos) {
         if (neighborIt == chunkMap.end()) {
             continue;
         }
-        job.neighborPresent[static_cast<size_t>(i)] = 1;
-        neighborIt->second.copyBlocks(job.neighborBlocks[static_cast<size_t>(i)]);
+        job.neighbors[static_cast<size_t>(i)] = neighborIt->second.snapshotBlocks();
     }
 
     if (!job.enableShadows) {
@@ -943,7 +1098,7 @@ void ChunkManager::buildChunkMeshWorker(ChunkMeshBuildJob job) {
     thread_local ChunkMeshBuilder workerBuilder;
 
     Chunk center(job.chunkPos);
-    center.overwriteBlocks(job.centerBlocks);
+    center.adoptBlocks(std::move(job.center));
 
     constexpr glm::ivec3 offsets[6] = {
         {1, 0, 0}, {-1, 0, 0},
@@ -954,15 +1109,17 @@ void ChunkManager::buildChunkMeshWorker(ChunkMeshBuildJob job) {
     std::array<std::optional<Chunk>, 6> neighborStorage;
     const Chunk* neighbors[6] = {};
     for (int i = 0; i < 6; ++i) {
-        if (job.neighborPresent[static_cast<size_t>(i)] == 0) {
+        if (!job.neighbors[static_cast<size_t>(i)].blocks) {
             continue;
         }
 
         neighborStorage[static_cast<size_t>(i)].emplace(job.chunkPos + offsets[i]);
-        neighborStorage[static_cast<size_t>(i)]->overwriteBlocks(job.neighborBlocks[static_cast<size_t>(i)]);
+        neighborStorage[static_cast<size_t>(i)]->adoptBlocks(std::move(job.neighbors[static_cast<size_t>(i)]));
         neighbors[i] = &neighborStorage[static_cast<size_t>(i)].value();
     }
 
+    workerBuilder.setMeshingMode(job.meshingMode);
+    workerBuilder.setBufferPool(&m_meshBufferPool);
     const auto buildStart = std::chrono::steady_clock::now();
     auto built = workerBuilder.buildChunkMesh(
         center,
@@ -1150,6 +1307,8 @@ bool ChunkManager::rebuildRegion(const glm::ivec3& regionPos, size_t reserveVert
         for (int i = 0; i < 6; ++i)
             neighbors[i] = findChunk(chunkPos + offsets[i]);
 
+        builder.setMeshingMode(meshingMode);
+        builder.setBufferPool(&m_meshBufferPool);
         auto built = builder.buildChunkMesh(
             chunk, neighbors, chunkPos, atlas, enableAO, enableShadows,
             [this](int wx, int wz) { return this->getColumnTopOccluderY(wx, wz); }
@@ -1196,6 +1355,9 @@ bool ChunkManager::rebuildRegion(const glm::ivec3& regionPos, size_t reserveVert
         }
         newMeshes.emplace(entry.chunkPos, mesh);
     }
+    for (auto& entry : rebuiltData) {
+        m_meshBufferPool.release(std::move(entry.vertices), std::move(entry.indices));
+    }
 
     oldRegion.vertexBytes = newVertexBytes;
     oldRegion.indexBytes = newIndexBytes;
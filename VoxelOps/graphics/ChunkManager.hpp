@@ -8,6 +8,7 @@
 #include "../voxels/ChunkColumn.hpp"
 
 #include "ChunkMeshBuilder.hpp"
+#include "ChunkMeshBufferPool.hpp"
 #include "Frustum.hpp"
 #include "Camera.hpp"
 #include "Mesh.hpp"
@@ -152,7 +153,8 @@ enum class NetworkChunkDeltaApplyResult {
     Applied = 0,
     MissingBaseChunk = 1,
     StaleVersion = 2,
-    VersionGap = 3
+    VersionGap = 3,
+    Deferred = 4 // the chunk's snapshot is still decoding; applied once it is installed
 };
 
 class ChunkManager{
@@ -179,7 +181,13 @@ public:
 
     void playerPlaceBlockAt(glm::ivec3 blockCoords, int faceNormal, BlockID blockType);
     void playerBreakBlockAt(const glm::ivec3& blockCoords);
-    bool applyNetworkChunkData(const ChunkData& packet);
+    // Full chunk snapshots are decoded and built on the worker pool; installNetworkChunks() swaps the
+    // finished chunks into chunkMap on the render thread.
+    void submitNetworkChunkData(ChunkData packet);
+    // Installs up to maxInstalls decoded chunks (0 = no limit). Deltas that arrived while a chunk was
+    // decoding are replayed after it; chunks whose replay needs a full resync go to outResyncChunks.
+    size_t installNetworkChunks(size_t maxInstalls, int64_t maxBudgetUs, std::vector<glm::ivec3>& outResyncChunks);
+    size_t pendingNetworkChunkCount() const;
     NetworkChunkDeltaApplyResult applyNetworkChunkDelta(const ChunkDelta& packet);
     void applyNetworkChunkUnload(const ChunkUnload& packet);
 
@@ -201,6 +209,7 @@ public:
 
     bool enableAO;
     bool enableShadows;
+    ChunkMeshingMode meshingMode = ChunkMeshingMode::Binary;
 
     TextureAtlas atlas;
 
@@ -223,11 +232,11 @@ private:
         uint64_t buildTicket = 0;
         bool enableAO = false;
         bool enableShadows = false;
+        ChunkMeshingMode meshingMode = ChunkMeshingMode::Binary;
         int chunkWorldMinX = 0;
         int chunkWorldMinZ = 0;
-        std::array<BlockID, CHUNK_VOLUME> centerBlocks{};
-        std::array<std::array<BlockID, CHUNK_VOLUME>, 6> neighborBlocks{};
-        std::array<uint8_t, 6> neighborPresent{};
+        Chunk::BlockSnapshot center;
+        std::array<Chunk::BlockSnapshot, 6> neighbors{}; // blocks == nullptr when the neighbour is not loaded
         std::array<int16_t, SunGridSize * SunGridSize> sunTopY{};
     };
 
@@ -238,6 +247,20 @@ private:
         std::vector<uint16_t> indices;
     };
 
+    struct PendingNetworkChunkDecode {
+        uint64_t decodeTicket = 0;
+        uint64_t version = 0;
+    };
+
+    struct NetworkChunkDecodeResult {
+        glm::ivec3 chunkPos{ 0 };
+        uint64_t decodeTicket = 0;
+        uint64_t version = 0;
+        bool decoded = false; // false when the payload was rejected
+        std::unordered_map<glm::ivec3, Chunk, IVec3Hash>::node_type chunkNode;
+        int8_t columnTopY[CHUNK_SIZE][CHUNK_SIZE]{}; // highest non-air world Y per [x][z], WORLD_MIN_Y - 1 if none
+    };
+
     std::unordered_map<glm::ivec3, Region, IVec3Hash> regions;
 
 
@@ -251,9 +274,17 @@ private:
     std::unordered_set<glm::ivec3, IVec3Hash, IVec3Eq> m_dirtyChunkPending;
     std::deque<ChunkMeshBuildResult> m_readyChunkMeshes;
     std::mutex m_readyChunkMeshesMutex;
+    // Vertex/index vectors recycled between mesh workers and uploads; outlives meshPool.
+    ChunkMeshBufferPool m_meshBufferPool;
     std::unordered_map<glm::ivec3, uint64_t, IVec3Hash> m_chunkBuildTickets;
     std::atomic<uint64_t> m_nextChunkBuildTicket{ 1 };
 
+    std::deque<NetworkChunkDecodeResult> m_readyNetworkChunks;
+    std::mutex m_readyNetworkChunksMutex;
+    std::unordered_map<glm::ivec3, PendingNetworkChunkDecode, IVec3Hash> m_pendingNetworkChunkDecodes;
+    std::unordered_map<glm::ivec3, std::vector<ChunkDelta>, IVec3Hash> m_deferredNetworkChunkDeltas;
+    uint64_t m_nextNetworkChunkDecodeTicket = 1;
+
 
 
 
@@ -290,6 +321,10 @@ private:
     bool requestChunkRebuild(const glm::ivec3& pos);
     void buildChunkMeshWorker(ChunkMeshBuildJob job);
 
+    void decodeNetworkChunkWorker(ChunkData packet, uint64_t decodeTicket);
+    bool installNetworkChunk(NetworkChunkDecodeResult& ready);
+    void applyDeferredNetworkChunkDeltas(const glm::ivec3& chunkPos, std::vector<glm::ivec3>& outResyncChunks);
+
 
 
     void setBlockSafe(Chunk& currentChunk, const glm::ivec3& pos, BlockID id);
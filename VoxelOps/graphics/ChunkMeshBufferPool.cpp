@@ -0,0 +1,95 @@
+#include "ChunkMeshBufferPool.hpp"
+
+#include <bit>
+
+namespace {
+constexpr size_t ClassCapacity(size_t minClassElements, size_t sizeClass) {
+    return minClassElements << sizeClass;
+}
+}
+
+template <typename T>
+std::vector<T> ChunkMeshBufferPool::take(FreeLists<T>& lists, size_t minCapacity, size_t& outReserve) {
+    ++counters.acquires;
+    outReserve = 0;
+    // Smallest class whose every buffer holds minCapacity elements.
+    size_t sizeClass = 0;
+    while (sizeClass < kClassCount && ClassCapacity(kMinClassElements, sizeClass) < minCapacity) {
+        ++sizeClass;
+    }
+    for (size_t c = sizeClass; c < kClassCount; ++c) {
+        std::vector<std::vector<T>>& list = lists[c];
+        if (!list.empty()) {
+            std::vector<T> buffer = std::move(list.back());
+            list.pop_back();
+            ++counters.reuses;
+            --counters.pooledBuffers;
+            counters.pooledBytes -= buffer.capacity() * sizeof(T);
+            return buffer;
+        }
+    }
+
+    ++counters.allocations;
+    // Round up to the class size so the buffer comes back into the class it was asked for. The
+    // caller reserves outside the lock.
+    outReserve = (sizeClass < kClassCount) ? ClassCapacity(kMinClassElements, sizeClass) : minCapacity;
+    return {};
+}
+
+template <typename T>
+void ChunkMeshBufferPool::give(FreeLists<T>& lists, std::vector<T>& buffer, std::vector<T>& outDiscard) {
+    const size_t capacity = buffer.capacity();
+    if (capacity == 0) {
+        return;
+    }
+    ++counters.releases;
+    buffer.clear();
+
+    // Largest class the buffer fully covers.
+    const size_t units = capacity / kMinClassElements;
+    const size_t sizeClass = (units > 0) ? size_t(std::bit_width(units)) - 1 : kClassCount;
+    if (sizeClass >= kClassCount || lists[sizeClass].size() >= kMaxPooledPerClass) {
+        ++counters.discards;
+        outDiscard.swap(buffer); // freed by the caller after unlocking
+        return;
+    }
+    lists[sizeClass].push_back(std::move(buffer));
+    buffer = std::vector<T>();
+    ++counters.pooledBuffers;
+    counters.pooledBytes += capacity * sizeof(T);
+}
+
+std::vector<VoxelVertex> ChunkMeshBufferPool::acquireVertices(size_t minCapacity) {
+    std::vector<VoxelVertex> buffer;
+    size_t reserve = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        buffer = take(freeVertices, minCapacity, reserve);
+    }
+    buffer.reserve(reserve);
+    return buffer;
+}
+
+std::vector<uint16_t> ChunkMeshBufferPool::acquireIndices(size_t minCapacity) {
+    std::vector<uint16_t> buffer;
+    size_t reserve = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        buffer = take(freeIndices, minCapacity, reserve);
+    }
+    buffer.reserve(reserve);
+    return buffer;
+}
+
+void ChunkMeshBufferPool::release(std::vector<VoxelVertex>&& vertices, std::vector<uint16_t>&& indices) {
+    std::vector<VoxelVertex> discardedVertices;
+    std::vector<uint16_t> discardedIndices;
+    std::lock_guard<std::mutex> lock(mutex);
+    give(freeVertices, vertices, discardedVertices);
+    give(freeIndices, indices, discardedIndices);
+}
+
+ChunkMeshBufferPool::Stats ChunkMeshBufferPool::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return counters;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "VoxelVertex.hpp"
+
+// Recycled vertex/index vectors for chunk mesh builds. Mesh workers take buffers from here through
+// ChunkMeshBuilder::setBufferPool and the render thread hands them back once the mesh is uploaded.
+// Free buffers are bucketed into power-of-two capacity classes and a request is served from the
+// smallest non-empty class that fits, so a streaming load stops allocating after warm-up.
+// Thread-safe.
+class ChunkMeshBufferPool {
+public:
+    struct Stats {
+        uint64_t acquires = 0;
+        uint64_t reuses = 0;      // served from a free list
+        uint64_t allocations = 0; // served by a fresh allocation
+        uint64_t releases = 0;
+        uint64_t discards = 0;    // released buffers freed instead of kept (class full, too small or too large)
+        size_t pooledBuffers = 0;
+        size_t pooledBytes = 0;
+    };
+
+    // Empty vector with capacity for at least minCapacity elements.
+    std::vector<VoxelVertex> acquireVertices(size_t minCapacity);
+    std::vector<uint16_t> acquireIndices(size_t minCapacity);
+
+    // Takes back a build result; either vector may be empty. Both are left empty.
+    void release(std::vector<VoxelVertex>&& vertices, std::vector<uint16_t>&& indices);
+
+    Stats stats() const;
+
+private:
+    static constexpr size_t kMinClassElements = 1024;
+    static constexpr size_t kClassCount = 7; // 1024 .. 65536 elements
+    static constexpr size_t kMaxPooledPerClass = 32;
+
+    template <typename T>
+    using FreeLists = std::array<std::vector<std::vector<T>>, kClassCount>;
+
+    template <typename T>
+    std::vector<T> take(FreeLists<T>& lists, size_t minCapacity, size_t& outReserve);
+    template <typename T>
+    void give(FreeLists<T>& lists, std::vector<T>& buffer, std::vector<T>& outDiscard);
+
+    mutable std::mutex mutex;
+    FreeLists<VoxelVertex> freeVertices;
+    FreeLists<uint16_t> freeIndices;
+    Stats counters;
+};
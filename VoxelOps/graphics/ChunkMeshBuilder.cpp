@@ -1,25 +1,29 @@
 ﻿#include "ChunkMeshBuilder.hpp"
 
+#include "ChunkMeshBufferPool.hpp"
 #include "Lighting.hpp"
 #include "../voxels/Voxel.hpp"
 #include <atomic>
 #include <chrono>
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cstring>
 #include <mutex>
 
 namespace {
     using Clock = std::chrono::steady_clock;
 
     std::atomic<uint64_t> g_profileChunks{ 0 };
-    std::atomic<uint64_t> g_profileTotalUs{ 0 };
-    std::atomic<uint64_t> g_profileBlockGridUs{ 0 };
-    std::atomic<uint64_t> g_profileSolidCacheUs{ 0 };
-    std::atomic<uint64_t> g_profileSunlightPrepUs{ 0 };
-    std::atomic<uint64_t> g_profileAoPrepUs{ 0 };
-    std::atomic<uint64_t> g_profileMaskTransitionUs{ 0 };
-    std::atomic<uint64_t> g_profileMaskLightingUs{ 0 };
-    std::atomic<uint64_t> g_profileMaskBuildUs{ 0 };
-    std::atomic<uint64_t> g_profileGreedyEmitUs{ 0 };
+    std::atomic<uint64_t> g_profileTotalNs{ 0 };
+    std::atomic<uint64_t> g_profileBlockGridNs{ 0 };
+    std::atomic<uint64_t> g_profileSolidCacheNs{ 0 };
+    std::atomic<uint64_t> g_profileSunlightPrepNs{ 0 };
+    std::atomic<uint64_t> g_profileAoPrepNs{ 0 };
+    std::atomic<uint64_t> g_profileMaskTransitionNs{ 0 };
+    std::atomic<uint64_t> g_profileMaskLightingNs{ 0 };
+    std::atomic<uint64_t> g_profileMaskBuildNs{ 0 };
+    std::atomic<uint64_t> g_profileGreedyEmitNs{ 0 };
 
     using MatIdLut = std::array<std::array<uint8_t, 6>, size_t(BlockID::COUNT)>;
 
@@ -80,6 +84,110 @@ namespace {
         });
         return lut;
     }
+
+    void recordProfileSample(const MeshBuildPhaseTimes& times) {
+        g_profileChunks.fetch_add(1, std::memory_order_relaxed);
+        g_profileTotalNs.fetch_add(times.totalNs, std::memory_order_relaxed);
+        g_profileBlockGridNs.fetch_add(times.blockGridNs, std::memory_order_relaxed);
+        g_profileSolidCacheNs.fetch_add(times.solidCacheNs, std::memory_order_relaxed);
+        g_profileSunlightPrepNs.fetch_add(times.sunlightPrepNs, std::memory_order_relaxed);
+        g_profileAoPrepNs.fetch_add(times.aoPrepNs, std::memory_order_relaxed);
+        g_profileMaskTransitionNs.fetch_add(times.maskTransitionNs, std::memory_order_relaxed);
+        g_profileMaskLightingNs.fetch_add(times.maskLightingNs, std::memory_order_relaxed);
+        g_profileMaskBuildNs.fetch_add(times.maskTransitionNs + times.maskLightingNs, std::memory_order_relaxed);
+        g_profileGreedyEmitNs.fetch_add(times.greedyEmitNs, std::memory_order_relaxed);
+    }
+
+    // Pooled when the builder has a ChunkMeshBufferPool, freshly reserved otherwise.
+    std::vector<VoxelVertex> takeVertexBuffer(ChunkMeshBufferPool* pool, size_t capacity) {
+        if (capacity == 0) {
+            return {};
+        }
+        if (pool) {
+            return pool->acquireVertices(capacity);
+        }
+        std::vector<VoxelVertex> vertices;
+        vertices.reserve(capacity);
+        return vertices;
+    }
+
+    std::vector<uint16_t> takeIndexBuffer(ChunkMeshBufferPool* pool, size_t capacity) {
+        if (capacity == 0) {
+            return {};
+        }
+        if (pool) {
+            return pool->acquireIndices(capacity);
+        }
+        std::vector<uint16_t> indices;
+        indices.reserve(capacity);
+        return indices;
+    }
+
+    uint64_t elapsedNs(Clock::time_point since) {
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - since).count());
+    }
+
+    // In-place transpose of a 16x16 bit matrix: bit j of row i swaps with bit i of row j.
+    void transposeBits16(uint16_t rows[16]) {
+        uint32_t mask = 0x00FFu;
+        for (int j = 8; j != 0; j >>= 1, mask ^= mask << j) {
+            for (int k = 0; k < 16; k = (k + j + 1) & ~j) {
+                const uint16_t t = uint16_t(((rows[k] >> j) ^ rows[k + j]) & mask);
+                rows[k] = uint16_t(rows[k] ^ (t << j));
+                rows[k + j] = uint16_t(rows[k + j] ^ t);
+            }
+        }
+    }
+
+    // Bit x is set when row[x] is not air, for a row of CHUNK_SIZE block ids. Eight ids per 64-bit
+    // word: the top bit of every non-zero byte is set, then a multiply gathers those bits into one byte.
+    uint32_t packSolidRow(const BlockID* row) {
+        static_assert(std::endian::native == std::endian::little, "packSolidRow reads block ids as little-endian words");
+        static_assert(sizeof(BlockID) == 1 && CHUNK_SIZE % 8 == 0);
+        constexpr uint64_t kLow7 = 0x7F7F7F7F7F7F7F7Full;
+        constexpr uint64_t kGather = 0x0102040810204080ull;
+        uint32_t bits = 0u;
+        for (int w = 0; w < CHUNK_SIZE / 8; ++w) {
+            uint64_t word;
+            std::memcpy(&word, row + w * 8, sizeof(word));
+            const uint64_t nonAir = (((word & kLow7) + kLow7) | word) & ~kLow7;
+            bits |= uint32_t(((nonAir >> 7) * kGather) >> 56) << (w * 8);
+        }
+        return bits;
+    }
+
+    int solidIndexPadded(int x, int y, int z) {
+        return (x + Lighting::kSolidPad) + Lighting::kSolidSize * ((y + Lighting::kSolidPad) + Lighting::kSolidSize * (z + Lighting::kSolidPad));
+    }
+
+    // Same contents as Lighting::buildSolidPadded, filled from whole block rows: this chunk, two
+    // layers of the X/Z neighbours, one layer of the Y neighbours, air everywhere else.
+    void fillSolidPadded(const ChunkBlockBuffer& blocks, const Chunk* neighbors[6], uint8_t* solidPadded) {
+        std::fill_n(solidPadded, Lighting::kSolidVolume, uint8_t(0));
+        const auto solidAt = [](const ChunkBlockBuffer& ids, int x, int y, int z) -> uint8_t {
+            return uint8_t(ids[size_t(x + CHUNK_SIZE * (y + CHUNK_SIZE * z))] != BlockID::Air ? 1 : 0);
+        };
+        for (int z = 0; z < CHUNK_SIZE; ++z) {
+            for (int y = 0; y < CHUNK_SIZE; ++y) {
+                uint8_t* row = solidPadded + solidIndexPadded(0, y, z);
+                for (int x = 0; x < CHUNK_SIZE; ++x) {
+                    row[x] = solidAt(blocks, x, y, z);
+                }
+            }
+        }
+        for (int a = 0; a < CHUNK_SIZE; ++a) {
+            for (int b = 0; b < CHUNK_SIZE; ++b) {
+                for (int layer = 1; layer <= Lighting::kSolidPad; ++layer) {
+                    if (neighbors[1]) solidPadded[solidIndexPadded(-layer, a, b)] = solidAt(neighbors[1]->blockData(), CHUNK_SIZE - layer, a, b);
+                    if (neighbors[0]) solidPadded[solidIndexPadded(CHUNK_SIZE - 1 + layer, a, b)] = solidAt(neighbors[0]->blockData(), layer - 1, a, b);
+                    if (neighbors[5]) solidPadded[solidIndexPadded(a, b, -layer)] = solidAt(neighbors[5]->blockData(), a, b, CHUNK_SIZE - layer);
+                    if (neighbors[4]) solidPadded[solidIndexPadded(a, b, CHUNK_SIZE - 1 + layer)] = solidAt(neighbors[4]->blockData(), a, b, layer - 1);
+                }
+                if (neighbors[3]) solidPadded[solidIndexPadded(a, -1, b)] = solidAt(neighbors[3]->blockData(), a, CHUNK_SIZE - 1, b);
+                if (neighbors[2]) solidPadded[solidIndexPadded(a, CHUNK_SIZE, b)] = solidAt(neighbors[2]->blockData(), a, 0, b);
+            }
+        }
+    }
 }
 
 
@@ -125,6 +233,28 @@ inline VoxelVertex packVoxelVertex(
     return { low, high };
 }
 
+// Integer-corner variant of packVoxelVertex; pos holds chunk-local corner coordinates (0..CHUNK_SIZE).
+inline VoxelVertex packVoxelVertexCell(
+    const int pos[3],
+    uint8_t face,
+    uint8_t corner,
+    uint8_t matId,
+    uint8_t ao,
+    uint8_t sun
+) {
+    const uint32_t low =
+        (uint32_t(pos[0]) & 0x1Fu)
+        | ((uint32_t(pos[1]) & 0x1Fu) << 5)
+        | ((uint32_t(pos[2]) & 0x1Fu) << 10)
+        | ((face & 0x7u) << 15)
+        | ((corner & 0x3u) << 18)
+        | ((ao & 0xFu) << 26);
+    const uint32_t high =
+        uint32_t(matId)
+        | (uint32_t(sun & 0xFu) << 8);
+    return { low, high };
+}
+
 
 
 
@@ -145,28 +275,42 @@ BuiltChunkMesh ChunkMeshBuilder::buildChunkMesh(
     bool enableShadows,
     const SunTopGetter& getSunTopY
 )
+{
+    lastBuildTimes = MeshBuildPhaseTimes{};
+    BuiltChunkMesh built = (meshingMode == ChunkMeshingMode::Binary)
+        ? buildBinaryMesh(center, neighbors, chunkPos, atlas, enableAO, enableShadows, getSunTopY)
+        : buildGreedyMesh(center, neighbors, chunkPos, atlas, enableAO, enableShadows, getSunTopY);
+    recordProfileSample(lastBuildTimes);
+    return built;
+}
+
+BuiltChunkMesh ChunkMeshBuilder::buildGreedyMesh(
+    const Chunk& center,
+    const Chunk* neighbors[6],
+    const glm::ivec3& chunkPos,
+    const TextureAtlas& atlas,
+    bool enableAO,
+    bool enableShadows,
+    const SunTopGetter& getSunTopY
+)
 {
     const auto tTotal0 = Clock::now();
-    uint64_t blockGridUs = 0;
-    uint64_t solidCacheUs = 0;
-    uint64_t sunlightPrepUs = 0;
-    uint64_t aoPrepUs = 0;
+    uint64_t blockGridNs = 0;
+    uint64_t solidCacheNs = 0;
+    uint64_t sunlightPrepNs = 0;
+    uint64_t aoPrepNs = 0;
     Clock::duration maskTransitionDur{};
     Clock::duration maskLightingDur{};
     Clock::duration greedyEmitDur{};
 
-    std::vector<VoxelVertex> vertices;
-    std::vector<uint16_t> indices;
-    vertices.reserve(4096);
-    indices.reserve(6144);
-
     if (center.isCompletelyAir()) {
-        const uint64_t totalUs = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - tTotal0).count());
-        g_profileChunks.fetch_add(1, std::memory_order_relaxed);
-        g_profileTotalUs.fetch_add(totalUs, std::memory_order_relaxed);
-        return { std::move(vertices), std::move(indices) };
+        lastBuildTimes.totalNs = elapsedNs(tTotal0);
+        return {};
     }
 
+    std::vector<VoxelVertex> vertices = takeVertexBuffer(bufferPool, 4096);
+    std::vector<uint16_t> indices = takeIndexBuffer(bufferPool, 6144);
+
     unsigned short indexOffset = 0;
 
     Lighting lighting(CHUNK_SIZE);
@@ -177,7 +321,7 @@ BuiltChunkMesh ChunkMeshBuilder::buildChunkMesh(
     if (enableAO || enableShadows) {
         const auto tSolid0 = Clock::now();
         lighting.buildSolidPadded(center, neighbors, solidPadded.data());
-        solidCacheUs = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - tSolid0).count());
+        solidCacheNs = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - tSolid0).count());
     }
 
     constexpr int gridSize = CHUNK_SIZE + 2; // coordinates in [-1 .. CHUNK_SIZE]
@@ -193,17 +337,17 @@ BuiltChunkMesh ChunkMeshBuilder::buildChunkMesh(
             }
         }
     }
-    blockGridUs = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - tGrid0).count());
+    blockGridNs = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - tGrid0).count());
 
     if (enableShadows) {
         const auto t0 = Clock::now();
         lighting.prepareChunkSunlight(center, chunkPos, neighbors, cornerSun.data(), 1.0f, getSunTopY, solidPadded.data());
-        sunlightPrepUs = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0).count());
+        sunlightPrepNs = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count());
     }
     if (enableAO) {
         const auto t0 = Clock::now();
         lighting.prepareChunkAO(center, chunkPos, neighbors, cornerAO.data(), solidPadded.data());
-        aoPrepUs = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0).count());
+        aoPrepNs = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count());
     }
 
     const MatIdLut& matIdLut = getCachedMatIdLut(atlas);
@@ -473,22 +617,430 @@ BuiltChunkMesh ChunkMeshBuilder::buildChunkMesh(
         }
     }
 
-    const uint64_t maskTransitionUs = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(maskTransitionDur).count());
-    const uint64_t maskLightingUs = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(maskLightingDur).count());
-    const uint64_t maskBuildUs = maskTransitionUs + maskLightingUs;
-    const uint64_t greedyEmitUs = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(greedyEmitDur).count());
-
-    const uint64_t totalUs = uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - tTotal0).count());
-    g_profileChunks.fetch_add(1, std::memory_order_relaxed);
-    g_profileTotalUs.fetch_add(totalUs, std::memory_order_relaxed);
-    g_profileBlockGridUs.fetch_add(blockGridUs, std::memory_order_relaxed);
-    g_profileSolidCacheUs.fetch_add(solidCacheUs, std::memory_order_relaxed);
-    g_profileSunlightPrepUs.fetch_add(sunlightPrepUs, std::memory_order_relaxed);
-    g_profileAoPrepUs.fetch_add(aoPrepUs, std::memory_order_relaxed);
-    g_profileMaskTransitionUs.fetch_add(maskTransitionUs, std::memory_order_relaxed);
-    g_profileMaskLightingUs.fetch_add(maskLightingUs, std::memory_order_relaxed);
-    g_profileMaskBuildUs.fetch_add(maskBuildUs, std::memory_order_relaxed);
-    g_profileGreedyEmitUs.fetch_add(greedyEmitUs, std::memory_order_relaxed);
+    lastBuildTimes.totalNs = elapsedNs(tTotal0);
+    lastBuildTimes.blockGridNs = blockGridNs;
+    lastBuildTimes.solidCacheNs = solidCacheNs;
+    lastBuildTimes.sunlightPrepNs = sunlightPrepNs;
+    lastBuildTimes.aoPrepNs = aoPrepNs;
+    lastBuildTimes.maskTransitionNs = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(maskTransitionDur).count());
+    lastBuildTimes.maskLightingNs = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(maskLightingDur).count());
+    lastBuildTimes.greedyEmitNs = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(greedyEmitDur).count());
+
+    return { std::move(vertices), std::move(indices) };
+}
+
+// Binary mesher. Along each axis d every (u, v) column of the chunk is an 18-bit occupancy mask
+// (bit k = coordinate k - 1 along d, so bits 0 and 17 are the neighbour chunks' border layers), and
+// the columns of the neighbours' border layers sit around them. A plane's row of visible faces is
+// then an AND-NOT of two adjacent columns of the u axis, AO for a whole row of corners is a
+// bit-sliced sum over a few such columns, and greedy merging walks the face rows with bit scans.
+// Quads come out in the same order, with the same corners and lighting, as buildGreedyMesh.
+BuiltChunkMesh ChunkMeshBuilder::buildBinaryMesh(
+    const Chunk& center,
+    const Chunk* neighbors[6],
+    const glm::ivec3& chunkPos,
+    const TextureAtlas& atlas,
+    bool enableAO,
+    bool enableShadows,
+    const SunTopGetter& getSunTopY
+)
+{
+    static_assert(CHUNK_SIZE == 16, "binary mesher packs a padded column into 18 bits of a uint32_t");
+    constexpr int kPlanes = CHUNK_SIZE + 1;
+    constexpr int kSpan = CHUNK_SIZE + 2;                            // columns -1..CHUNK_SIZE per side
+    constexpr uint32_t kInnerBits = ((1u << CHUNK_SIZE) - 1u) << 1; // coordinates 0..CHUNK_SIZE-1
+
+    const auto tTotal0 = Clock::now();
+    MeshBuildPhaseTimes& sample = lastBuildTimes;
+
+    if (center.isCompletelyAir()) {
+        sample.totalNs = elapsedNs(tTotal0);
+        return {};
+    }
+
+    // Column (i, j) of axis d runs along d at u = i, v = j, with u = (d + 1) % 3 and v = (d + 2) % 3,
+    // for i and j in -1..CHUNK_SIZE, at index (j + 1) * kSpan + (i + 1): X columns are indexed [z][y],
+    // Y columns [x][z] and Z columns [y][x]. Columns outside the chunk come from the face neighbours;
+    // cells beyond two chunk faces at once are air, as in Lighting::buildSolidPadded.
+    thread_local std::array<std::array<uint32_t, kSpan * kSpan>, 3> columns;
+    // Face rows along u of every plane of every axis, and the +d faces among them.
+    thread_local std::array<std::array<std::array<uint32_t, CHUNK_SIZE>, kPlanes>, 3> planeRows;
+    thread_local std::array<std::array<std::array<uint32_t, CHUNK_SIZE>, kPlanes>, 3> planePosRows;
+    thread_local std::array<std::array<uint64_t, CHUNK_SIZE * CHUNK_SIZE>, kPlanes> planeKeys;
+
+    const auto tGrid0 = Clock::now();
+    // X rows are packed straight from the block array; Y and Z columns are 16x16 bit transposes of them.
+    const ChunkBlockBuffer& blocks = center.blockData();
+    for (int z = 0; z < CHUNK_SIZE; ++z) {
+        for (int y = 0; y < CHUNK_SIZE; ++y) {
+            columns[0][(z + 1) * kSpan + y + 1] = packSolidRow(blocks.data() + CHUNK_SIZE * (y + CHUNK_SIZE * z)) << 1;
+        }
+    }
+    for (int a = 0; a < CHUNK_SIZE; ++a) {
+        uint16_t slice[CHUNK_SIZE];
+        // Y columns [x][z = a]: rows y of the slice z = a.
+        for (int y = 0; y < CHUNK_SIZE; ++y) {
+            slice[y] = uint16_t(columns[0][(a + 1) * kSpan + y + 1] >> 1);
+        }
+        transposeBits16(slice);
+        for (int x = 0; x < CHUNK_SIZE; ++x) {
+            columns[1][(x + 1) * kSpan + a + 1] = uint32_t(slice[x]) << 1;
+        }
+        // Z columns [y = a][x]: rows z of the slice y = a.
+        for (int z = 0; z < CHUNK_SIZE; ++z) {
+            slice[z] = uint16_t(columns[0][(z + 1) * kSpan + a + 1] >> 1);
+        }
+        transposeBits16(slice);
+        for (int x = 0; x < CHUNK_SIZE; ++x) {
+            columns[2][(a + 1) * kSpan + x + 1] = uint32_t(slice[x]) << 1;
+        }
+    }
+    // The layer of each neighbour that touches this chunk, as 16x16 bit matrices. For the layer
+    // normal to axis a, with in-plane axes b1 = (a + 1) % 3 and b2 = (a + 2) % 3,
+    // borderRows[a][side][0][n] holds bits along b1 at b2 = n, and [1][n] bits along b2 at b1 = n.
+    // Side 0 is the -a neighbour, side 1 the +a one; missing neighbours are air.
+    uint16_t borderRows[3][2][2][CHUNK_SIZE] = {};
+    for (int side = 0; side < 2; ++side) {
+        const int layer = side ? 0 : CHUNK_SIZE - 1;
+        if (const Chunk* n = neighbors[side ? 0 : 1]) {
+            const BlockID* ids = n->blockData().data();
+            for (int z = 0; z < CHUNK_SIZE; ++z) {
+                for (int y = 0; y < CHUNK_SIZE; ++y) {
+                    const uint32_t solid = ids[layer + CHUNK_SIZE * (y + CHUNK_SIZE * z)] != BlockID::Air ? 1u : 0u;
+                    borderRows[0][side][0][z] |= uint16_t(solid << y);
+                    borderRows[0][side][1][y] |= uint16_t(solid << z);
+                }
+            }
+        }
+        if (const Chunk* n = neighbors[side ? 2 : 3]) {
+            // Y layer rows run along x at each z: bits along b2 = x, indexed by b1 = z.
+            const BlockID* ids = n->blockData().data();
+            for (int z = 0; z < CHUNK_SIZE; ++z) {
+                borderRows[1][side][1][z] = uint16_t(packSolidRow(ids + CHUNK_SIZE * (layer + CHUNK_SIZE * z)));
+            }
+            std::copy_n(borderRows[1][side][1], CHUNK_SIZE, borderRows[1][side][0]);
+            transposeBits16(borderRows[1][side][0]);
+        }
+        if (const Chunk* n = neighbors[side ? 4 : 5]) {
+            // Z layer rows run along x at each y: bits along b1 = x, indexed by b2 = y.
+            const BlockID* ids = n->blockData().data();
+            for (int y = 0; y < CHUNK_SIZE; ++y) {
+                borderRows[2][side][0][y] = uint16_t(packSolidRow(ids + CHUNK_SIZE * (y + CHUNK_SIZE * layer)));
+            }
+            std::copy_n(borderRows[2][side][0], CHUNK_SIZE, borderRows[2][side][1]);
+            transposeBits16(borderRows[2][side][1]);
+        }
+    }
+    // Inner columns of axis d take their pad bits from the d layers (bit u of the row at v); the
+    // columns around them are rows of the u and v layers, moved up to make room for the low pad bit.
+    for (int d = 0; d < 3; ++d) {
+        const int u = (d + 1) % 3;
+        const int v = (d + 2) % 3;
+        uint32_t* cols = columns[d].data();
+        cols[0] = cols[kSpan - 1] = 0u;
+        cols[(kSpan - 1) * kSpan] = cols[kSpan * kSpan - 1] = 0u;
+        for (int n = 0; n < CHUNK_SIZE; ++n) {
+            const uint32_t low = borderRows[d][0][0][n];
+            const uint32_t high = borderRows[d][1][0][n];
+            uint32_t* row = cols + (n + 1) * kSpan;
+            for (int i = 0; i < CHUNK_SIZE; ++i) {
+                row[i + 1] |= ((low >> i) & 1u) | (((high >> i) & 1u) << (CHUNK_SIZE + 1));
+            }
+            row[0] = uint32_t(borderRows[u][0][1][n]) << 1;
+            row[kSpan - 1] = uint32_t(borderRows[u][1][1][n]) << 1;
+            cols[n + 1] = uint32_t(borderRows[v][0][0][n]) << 1;
+            cols[(kSpan - 1) * kSpan + n + 1] = uint32_t(borderRows[v][1][0][n]) << 1;
+        }
+    }
+    sample.blockGridNs = elapsedNs(tGrid0);
+
+    // Lighting is evaluated only at the corners of visible faces, in the merge-key pass below, so
+    // the full corner volumes that buildGreedyMesh prepares are skipped; AO needs nothing beyond the
+    // columns above.
+    Lighting lighting(CHUNK_SIZE);
+    thread_local std::array<uint8_t, Lighting::kSolidVolume> solidPadded{}; // only for Lighting's sunlight
+    thread_local std::array<uint8_t, Lighting::kPaddedVolume> cornerSun{}; // only without getSunTopY
+    std::array<int, (CHUNK_SIZE + 1) * (CHUNK_SIZE + 1)> sunTopGrid{};    // [z][x] over corner columns
+    const bool needsLight = enableAO || enableShadows;
+    const bool sunFromColumns = enableShadows && static_cast<bool>(getSunTopY);
+
+    if (enableShadows && !sunFromColumns) {
+        const auto t0 = Clock::now();
+        fillSolidPadded(blocks, neighbors, solidPadded.data());
+        sample.solidCacheNs = elapsedNs(t0);
+    }
+    if (enableShadows) {
+        const auto t0 = Clock::now();
+        if (sunFromColumns) {
+            // Same as Lighting::prepareChunkSunlight: a corner is occluded by the highest of the
+            // four block columns around it.
+            constexpr int kTopSize = CHUNK_SIZE + 2; // block columns -1..CHUNK_SIZE
+            std::array<int, kTopSize * kTopSize> columnTop;
+            const int chunkWorldMinX = chunkPos.x * CHUNK_SIZE;
+            const int chunkWorldMinZ = chunkPos.z * CHUNK_SIZE;
+            for (int z = -1; z <= CHUNK_SIZE; ++z) {
+                for (int x = -1; x <= CHUNK_SIZE; ++x) {
+                    columnTop[(z + 1) * kTopSize + (x + 1)] = getSunTopY(chunkWorldMinX + x, chunkWorldMinZ + z);
+                }
+            }
+            for (int z = 0; z <= CHUNK_SIZE; ++z) {
+                for (int x = 0; x <= CHUNK_SIZE; ++x) {
+                    const int* above = columnTop.data() + z * kTopSize + x;
+                    sunTopGrid[z * (CHUNK_SIZE + 1) + x] = std::max(
+                        std::max(above[0], above[1]),
+                        std::max(above[kTopSize], above[kTopSize + 1])
+                    );
+                }
+            }
+        }
+        else {
+            lighting.prepareChunkSunlight(center, chunkPos, neighbors, cornerSun.data(), 1.0f, getSunTopY, solidPadded.data());
+        }
+        sample.sunlightPrepNs = elapsedNs(t0);
+    }
+
+    // Plane s of axis d lies between cells s - 1 and s along d. Its row j along u holds the +d faces
+    // of solid cells at s - 1 with air at s, and the -d faces of solid cells at s with air at s - 1;
+    // only cells of this chunk emit faces. Both come from the u columns at (s - 1, j) and (s, j).
+    const auto tCull0 = Clock::now();
+    size_t faceCount = 0;
+    for (int d = 0; d < 3; ++d) {
+        const uint32_t* alongU = columns[(d + 1) % 3].data(); // indexed [d][v]
+        for (int s = 0; s < kPlanes; ++s) {
+            const uint32_t* before = alongU + s * kSpan + 1;
+            const uint32_t* after = before + kSpan;
+            const uint32_t posMask = (s > 0) ? kInnerBits : 0u;
+            const uint32_t negMask = (s < CHUNK_SIZE) ? kInnerBits : 0u;
+            // Face rows are 16 bits wide, so four share one popcount.
+            uint64_t fourRows = 0u;
+            for (int j = 0; j < CHUNK_SIZE; ++j) {
+                const uint32_t pos = before[j] & ~after[j] & posMask;
+                const uint32_t neg = after[j] & ~before[j] & negMask;
+                planePosRows[d][s][j] = pos >> 1;
+                planeRows[d][s][j] = (pos | neg) >> 1;
+                fourRows |= uint64_t((pos | neg) >> 1) << (16 * (j % 4));
+                if (j % 4 == 3) {
+                    faceCount += size_t(std::popcount(fourRows));
+                    fourRows = 0u;
+                }
+            }
+        }
+    }
+    // Every quad covers at least one face, so the face count bounds the output. Quads are written
+    // through plain pointers into per-thread scratch that only ever grows, and copied out at their
+    // final size at the end.
+    thread_local std::vector<VoxelVertex> vertexScratch;
+    thread_local std::vector<uint16_t> indexScratch;
+    if (vertexScratch.size() < faceCount * 4) {
+        vertexScratch.resize(faceCount * 4);
+        indexScratch.resize(faceCount * 6);
+    }
+    VoxelVertex* vertexOut = vertexScratch.data();
+    uint16_t* indexOut = indexScratch.data();
+    sample.maskTransitionNs = elapsedNs(tCull0);
+    Clock::duration maskLightingDur{};
+    Clock::duration greedyEmitDur{};
+
+    const MatIdLut& matIdLut = getCachedMatIdLut(atlas);
+    // Occluder counts for the corner row along u at d = s, v = q: the sum Lighting::prepareChunkAO
+    // takes for one corner, for all CHUNK_SIZE + 1 corners of the row at once, as three bit planes.
+    const auto cornerRowOcclusion = [&](const uint32_t* rowsAlongU, int s, int q, uint32_t out[3]) {
+        const uint32_t* here = rowsAlongU + (s + 1) * kSpan + (q + 1);
+        const uint32_t* below = here - kSpan; // d - 1
+        const uint32_t a = here[0];                 // cells at u - 1
+        const uint32_t b = below[0] >> 1;           // d - 1
+        const uint32_t c = here[-1] >> 1;           // v - 1
+        const uint32_t ab = a & b & below[0];
+        const uint32_t ac = a & c & here[-1];
+        const uint32_t bc = b & c & (below[-1] >> 1);
+        const uint32_t abXor = a ^ b;
+        const uint32_t singlesLow = abXor ^ c;
+        const uint32_t singlesHigh = (a & b) | (abXor & c);
+        const uint32_t pairsLow = ab ^ ac ^ bc;
+        const uint32_t pairsHigh = (ab & ac) | (ab & bc) | (ac & bc);
+        const uint32_t carry = singlesLow & pairsLow;
+        out[0] = singlesLow ^ pairsLow;
+        out[1] = singlesHigh ^ pairsHigh ^ carry;
+        out[2] = (singlesHigh & pairsHigh) | (singlesHigh & carry) | (pairsHigh & carry);
+    };
+    const auto cornerAO = [](const uint32_t occlusion[3], int i) -> uint32_t {
+        const uint32_t count = ((occlusion[0] >> i) & 1u) | (((occlusion[1] >> i) & 1u) << 1) | (((occlusion[2] >> i) & 1u) << 2);
+        return 15u - 2u * count;
+    };
+    const int chunkWorldMinY = chunkPos.y * CHUNK_SIZE;
+    const auto sunBelowTop = [](int top, int worldY) -> uint32_t {
+        const int blockedLayers = (worldY <= top) ? (top - worldY + 1) : 0;
+        return uint32_t(std::max(0, 15 - blockedLayers * 2));
+    };
+    const auto cornerSunAt = [&](const int corner[3]) -> uint32_t {
+        if (!sunFromColumns) {
+            return cornerSun[lighting.cornerIndexPadded(corner[0], corner[1], corner[2])];
+        }
+        return sunBelowTop(sunTopGrid[corner[2] * (CHUNK_SIZE + 1) + corner[0]], chunkWorldMinY + corner[1]);
+    };
+    // Per-axis strides of a coordinate in the block array, in a packed vertex position and in
+    // sunTopGrid, and its weight in world y, so the per-face loops below never index by axis.
+    constexpr int kBlockStride[3] = { 1, CHUNK_SIZE, CHUNK_SIZE * CHUNK_SIZE };
+    constexpr int kVertexStride[3] = { 1, 1 << 5, 1 << 10 };
+    constexpr int kSunTopStride[3] = { 1, 0, CHUNK_SIZE + 1 };
+    constexpr int kWorldYStride[3] = { 0, 1, 0 };
+    uint16_t indexOffset = 0;
+
+    for (int d = 0; d < 3; ++d) {
+        const int u = (d + 1) % 3;
+        const int v = (d + 2) % 3;
+
+        // Merge keys of this axis' faces: block | sign << 8 | light << 24, as in the greedy mesher.
+        const auto tKeys0 = Clock::now();
+        const uint32_t* alongU = columns[u].data(); // indexed [d][v]
+        for (int s = 0; s < kPlanes; ++s) {
+            // Corner rows j and j + 1 around face row j; row j + 1 is reused when row j + 1 has faces too.
+            uint32_t occlusionNear[3] = {};
+            uint32_t occlusionFar[3] = {};
+            int farRow = -1;
+            for (int j = 0; j < CHUNK_SIZE; ++j) {
+                uint32_t bits = planeRows[d][s][j];
+                if (bits == 0u) {
+                    continue;
+                }
+                const uint32_t posBits = planePosRows[d][s][j];
+                if (enableAO) {
+                    if (farRow == j) {
+                        std::copy_n(occlusionFar, 3, occlusionNear);
+                    }
+                    else {
+                        cornerRowOcclusion(alongU, s, j, occlusionNear);
+                    }
+                    cornerRowOcclusion(alongU, s, j + 1, occlusionFar);
+                    farRow = j + 1;
+                }
+                while (bits != 0u) {
+                    const int i = std::countr_zero(bits);
+                    bits &= bits - 1u;
+                    const uint32_t sign = (posBits >> i) & 1u;
+                    const int cell = i * kBlockStride[u] + j * kBlockStride[v] + (s - int(sign)) * kBlockStride[d];
+                    uint64_t key = uint64_t(uint8_t(blocks[size_t(cell)])) | (uint64_t(sign) << 8);
+                    if (needsLight) {
+                        uint32_t light = 0u;
+                        if (enableAO) {
+                            light |= cornerAO(occlusionNear, i) << 0;
+                            light |= cornerAO(occlusionNear, i + 1) << 4;
+                            light |= cornerAO(occlusionFar, i + 1) << 8;
+                            light |= cornerAO(occlusionFar, i) << 12;
+                        }
+                        if (sunFromColumns) {
+                            const int* top = sunTopGrid.data() + s * kSunTopStride[d] + i * kSunTopStride[u] + j * kSunTopStride[v];
+                            const int worldY = chunkWorldMinY + s * kWorldYStride[d] + i * kWorldYStride[u] + j * kWorldYStride[v];
+                            const int topU = kSunTopStride[u];
+                            const int topV = kSunTopStride[v];
+                            const int worldYU = kWorldYStride[u];
+                            const int worldYV = kWorldYStride[v];
+                            light |= sunBelowTop(top[0], worldY) << 16;
+                            light |= sunBelowTop(top[topU], worldY + worldYU) << 20;
+                            light |= sunBelowTop(top[topU + topV], worldY + worldYU + worldYV) << 24;
+                            light |= sunBelowTop(top[topV], worldY + worldYV) << 28;
+                        }
+                        else if (enableShadows) {
+                            int corner[3];
+                            corner[d] = s;
+                            corner[u] = i;
+                            corner[v] = j;
+                            light |= (cornerSunAt(corner) & 0xFu) << 16;
+                            corner[u] += 1;
+                            light |= (cornerSunAt(corner) & 0xFu) << 20;
+                            corner[v] += 1;
+                            light |= (cornerSunAt(corner) & 0xFu) << 24;
+                            corner[u] -= 1;
+                            light |= (cornerSunAt(corner) & 0xFu) << 28;
+                        }
+                        key |= uint64_t(light) << 24;
+                    }
+                    planeKeys[s][j * CHUNK_SIZE + i] = key;
+                }
+            }
+        }
+        maskLightingDur += Clock::now() - tKeys0;
+
+        const auto tEmit0 = Clock::now();
+        for (int s = 0; s < kPlanes; ++s) {
+            std::array<uint32_t, CHUNK_SIZE>& rows = planeRows[d][s];
+            const std::array<uint64_t, CHUNK_SIZE * CHUNK_SIZE>& keys = planeKeys[s];
+            for (int j = 0; j < CHUNK_SIZE; ++j) {
+                while (rows[j] != 0u) {
+                    const int i = std::countr_zero(rows[j]);
+                    const uint64_t key = keys[j * CHUNK_SIZE + i];
+
+                    // Longest run of set bits from i, then cut it at the first differing key.
+                    const int run = std::countr_zero(~(rows[j] >> i));
+                    int w = 1;
+                    while (w < run && keys[j * CHUNK_SIZE + i + w] == key) {
+                        ++w;
+                    }
+                    const uint32_t span = ((1u << w) - 1u) << i;
+
+                    int h = 1;
+                    while (j + h < CHUNK_SIZE && (rows[j + h] & span) == span) {
+                        const uint64_t* rowKeys = keys.data() + (j + h) * CHUNK_SIZE + i;
+                        int k = 0;
+                        while (k < w && rowKeys[k] == key) {
+                            ++k;
+                        }
+                        if (k != w) {
+                            break;
+                        }
+                        ++h;
+                    }
+                    for (int yy = 0; yy < h; ++yy) {
+                        rows[j + yy] &= ~span;
+                    }
+
+                    const bool positive = ((key >> 8) & 1u) != 0u;
+                    const BlockID block = BlockID(uint8_t(key));
+                    const uint32_t light = uint32_t(key >> 24);
+                    const uint8_t face = uint8_t(d * 2 + (positive ? 0 : 1));
+                    const uint8_t matId = matIdLut[size_t(block)][face];
+
+                    // Same packing as packVoxelVertexCell. Corner coordinates stay within 0..CHUNK_SIZE,
+                    // so they are summed straight into their 5-bit fields: origin, +u*w, +u*w+v*h, +v*h.
+                    const uint32_t origin = uint32_t(s * kVertexStride[d] + i * kVertexStride[u] + j * kVertexStride[v]);
+                    const uint32_t stepU = uint32_t(w * kVertexStride[u]);
+                    const uint32_t stepV = uint32_t(h * kVertexStride[v]);
+                    const uint32_t cornerPos[4] = { origin, origin + stepU, origin + stepU + stepV, origin + stepV };
+                    const uint32_t faceBits = (uint32_t(face) & 0x7u) << 15;
+                    for (int k = 0; k < 4; ++k) {
+                        const uint32_t low = cornerPos[k]
+                            | faceBits
+                            | ((uint32_t(uvRemap[face][k]) & 0x3u) << 18)
+                            | (((light >> (4 * k)) & 0xFu) << 26);
+                        const uint32_t high = uint32_t(matId) | (((light >> (16 + 4 * k)) & 0xFu) << 8);
+                        *vertexOut++ = { low, high };
+                    }
+
+                    // Same winding as buildGreedyMesh: 0,1,2 0,2,3 for +d and 0,2,1 0,3,2 for -d.
+                    const uint16_t near = positive ? 1 : 2;
+                    const uint16_t far = positive ? 2 : 1;
+                    indexOut[0] = indexOffset;
+                    indexOut[1] = uint16_t(indexOffset + near);
+                    indexOut[2] = uint16_t(indexOffset + far);
+                    indexOut[3] = indexOffset;
+                    indexOut[4] = uint16_t(indexOffset + near + 1);
+                    indexOut[5] = uint16_t(indexOffset + far + 1);
+                    indexOut += 6;
+                    indexOffset += 4;
+                }
+            }
+        }
+        greedyEmitDur += Clock::now() - tEmit0;
+    }
+
+    std::vector<VoxelVertex> vertices = takeVertexBuffer(bufferPool, size_t(vertexOut - vertexScratch.data()));
+    std::vector<uint16_t> indices = takeIndexBuffer(bufferPool, size_t(indexOut - indexScratch.data()));
+    vertices.assign(vertexScratch.data(), vertexOut);
+    indices.assign(indexScratch.data(), indexOut);
+
+    sample.maskLightingNs = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(maskLightingDur).count());
+    sample.greedyEmitNs = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(greedyEmitDur).count());
+    sample.totalNs = elapsedNs(tTotal0);
 
     return { std::move(vertices), std::move(indices) };
 }
@@ -496,29 +1048,29 @@ BuiltChunkMesh ChunkMeshBuilder::buildChunkMesh(
 MeshBuildProfileSnapshot ChunkMeshBuilder::getProfileSnapshot() {
     MeshBuildProfileSnapshot snap;
     snap.chunksMeshed = g_profileChunks.load(std::memory_order_relaxed);
-    snap.totalUs = g_profileTotalUs.load(std::memory_order_relaxed);
-    snap.blockGridUs = g_profileBlockGridUs.load(std::memory_order_relaxed);
-    snap.solidCacheUs = g_profileSolidCacheUs.load(std::memory_order_relaxed);
-    snap.sunlightPrepUs = g_profileSunlightPrepUs.load(std::memory_order_relaxed);
-    snap.aoPrepUs = g_profileAoPrepUs.load(std::memory_order_relaxed);
-    snap.maskTransitionUs = g_profileMaskTransitionUs.load(std::memory_order_relaxed);
-    snap.maskLightingUs = g_profileMaskLightingUs.load(std::memory_order_relaxed);
-    snap.maskBuildUs = g_profileMaskBuildUs.load(std::memory_order_relaxed);
-    snap.greedyEmitUs = g_profileGreedyEmitUs.load(std::memory_order_relaxed);
+    snap.totalUs = g_profileTotalNs.load(std::memory_order_relaxed) / 1000;
+    snap.blockGridUs = g_profileBlockGridNs.load(std::memory_order_relaxed) / 1000;
+    snap.solidCacheUs = g_profileSolidCacheNs.load(std::memory_order_relaxed) / 1000;
+    snap.sunlightPrepUs = g_profileSunlightPrepNs.load(std::memory_order_relaxed) / 1000;
+    snap.aoPrepUs = g_profileAoPrepNs.load(std::memory_order_relaxed) / 1000;
+    snap.maskTransitionUs = g_profileMaskTransitionNs.load(std::memory_order_relaxed) / 1000;
+    snap.maskLightingUs = g_profileMaskLightingNs.load(std::memory_order_relaxed) / 1000;
+    snap.maskBuildUs = g_profileMaskBuildNs.load(std::memory_order_relaxed) / 1000;
+    snap.greedyEmitUs = g_profileGreedyEmitNs.load(std::memory_order_relaxed) / 1000;
     return snap;
 }
 
 void ChunkMeshBuilder::resetProfileSnapshot() {
     g_profileChunks.store(0, std::memory_order_relaxed);
-    g_profileTotalUs.store(0, std::memory_order_relaxed);
-    g_profileBlockGridUs.store(0, std::memory_order_relaxed);
-    g_profileSolidCacheUs.store(0, std::memory_order_relaxed);
-    g_profileSunlightPrepUs.store(0, std::memory_order_relaxed);
-    g_profileAoPrepUs.store(0, std::memory_order_relaxed);
-    g_profileMaskTransitionUs.store(0, std::memory_order_relaxed);
-    g_profileMaskLightingUs.store(0, std::memory_order_relaxed);
-    g_profileMaskBuildUs.store(0, std::memory_order_relaxed);
-    g_profileGreedyEmitUs.store(0, std::memory_order_relaxed);
+    g_profileTotalNs.store(0, std::memory_order_relaxed);
+    g_profileBlockGridNs.store(0, std::memory_order_relaxed);
+    g_profileSolidCacheNs.store(0, std::memory_order_relaxed);
+    g_profileSunlightPrepNs.store(0, std::memory_order_relaxed);
+    g_profileAoPrepNs.store(0, std::memory_order_relaxed);
+    g_profileMaskTransitionNs.store(0, std::memory_order_relaxed);
+    g_profileMaskLightingNs.store(0, std::memory_order_relaxed);
+    g_profileMaskBuildNs.store(0, std::memory_order_relaxed);
+    g_profileGreedyEmitNs.store(0, std::memory_order_relaxed);
 }
 
 
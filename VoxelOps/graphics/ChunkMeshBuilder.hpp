@@ -1,11 +1,14 @@
 #pragma once
 #include "../voxels/Chunk.hpp"
 #include "../voxels/Voxel.hpp"
-#include "Mesh.hpp"
+#include "VoxelVertex.hpp"
 #include "../graphics/TextureAtlas.hpp"
 #include <array>
 #include <cstdint>
+#include <functional>
+#include <vector>
 
+class ChunkMeshBufferPool;
 
 
 struct QuadKey {
@@ -43,6 +46,11 @@ struct GreedyCell {
     uint64_t mergeKey = 0;
 };
 
+enum class ChunkMeshingMode : uint8_t {
+    Greedy = 0, // per-cell mask sweep over an 18^3 block grid
+    Binary = 1  // per-column occupancy bitmasks, face culling by shifts, merging by bit scans
+};
+
 struct BuiltChunkMesh {
     std::vector<VoxelVertex> vertices;
     std::vector<uint16_t> indices;
@@ -61,6 +69,18 @@ struct MeshBuildProfileSnapshot {
     uint64_t greedyEmitUs = 0;
 };
 
+// Phase timings of the last buildChunkMesh call of one builder, in nanoseconds.
+struct MeshBuildPhaseTimes {
+    uint64_t totalNs = 0;
+    uint64_t blockGridNs = 0;
+    uint64_t solidCacheNs = 0;
+    uint64_t sunlightPrepNs = 0;
+    uint64_t aoPrepNs = 0;
+    uint64_t maskTransitionNs = 0;
+    uint64_t maskLightingNs = 0;
+    uint64_t greedyEmitNs = 0;
+};
+
 
 class ChunkMeshBuilder {
 public:
@@ -80,8 +100,38 @@ public:
     static MeshBuildProfileSnapshot getProfileSnapshot();
     static void resetProfileSnapshot();
 
+    void setMeshingMode(ChunkMeshingMode mode) noexcept { meshingMode = mode; }
+    ChunkMeshingMode getMeshingMode() const noexcept { return meshingMode; }
+    const MeshBuildPhaseTimes& getLastBuildTimes() const noexcept { return lastBuildTimes; }
+    // Result buffers come from `pool` when set; the caller hands them back after uploading.
+    void setBufferPool(ChunkMeshBufferPool* pool) noexcept { bufferPool = pool; }
+
 
 private:
+    ChunkMeshingMode meshingMode = ChunkMeshingMode::Binary;
+    MeshBuildPhaseTimes lastBuildTimes;
+    ChunkMeshBufferPool* bufferPool = nullptr;
+
+    BuiltChunkMesh buildGreedyMesh(
+        const Chunk& center,
+        const Chunk* neighbors[6],
+        const glm::ivec3& chunkPos,
+        const TextureAtlas& atlas,
+        bool enableAO,
+        bool enableShadows,
+        const SunTopGetter& getSunTopY
+    );
+
+    BuiltChunkMesh buildBinaryMesh(
+        const Chunk& center,
+        const Chunk* neighbors[6],
+        const glm::ivec3& chunkPos,
+        const TextureAtlas& atlas,
+        bool enableAO,
+        bool enableShadows,
+        const SunTopGetter& getSunTopY
+    );
+
     std::unordered_map<QuadKey, uint16_t, QuadKeyHash> quadEmitMap;
     std::unordered_map<QuadKey, std::pair<std::array<uint8_t, 4>, std::array<uint8_t, 4>>, QuadKeyHash> quadMap;
 
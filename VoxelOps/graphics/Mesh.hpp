@@ -10,6 +10,7 @@
 
 #include "Renderer.hpp"
 #include "Shader.hpp"
+#include "VoxelVertex.hpp"
 
 
 
@@ -33,11 +34,6 @@ struct VertexPacked {
 };
 
 
-struct VoxelVertex {
-    uint32_t low;   // bitpacked payload
-    uint32_t high;  // low 16 bits used; remaining bits reserved
-};
-
 
 struct Texture {
     unsigned int id;
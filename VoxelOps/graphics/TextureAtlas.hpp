@@ -10,6 +10,9 @@ constexpr int TILE_RESOLUTION = 16; // each tile is 16x16 pixels
 struct TextureAtlas {
 public:
 	TextureAtlas();
+	// Tile map only: no image is loaded and no GL texture is created (offline tools).
+	struct TilesOnly {};
+	explicit TextureAtlas(TilesOnly);
 	~TextureAtlas();
 	TextureAtlas(const TextureAtlas&) = delete;
 	TextureAtlas& operator=(const TextureAtlas&) = delete;
@@ -21,4 +24,6 @@ public:
 	GLuint atlasTextureID = 0;
 	GLuint atlasTextureArrayID = 0;
 
+private:
+	void registerTiles();
 };
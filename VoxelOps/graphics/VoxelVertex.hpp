@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstdint>
+
+// Chunk mesh vertex, kept apart from Mesh.hpp so the mesher builds without the GL/assimp headers.
+struct VoxelVertex {
+    uint32_t low;   // bitpacked payload
+    uint32_t high;  // low 16 bits used; remaining bits reserved
+};
@@ -406,57 +406,6 @@ bool ParseConnectResponsePacket(const uint8_t* data, size_t size, ConnectRespons
     return true;
 }
 
-bool ParsePlayerSnapshotFramePacket(const uint8_t* data, size_t size, PlayerSnapshotFrame& out)
-{
-    constexpr size_t kSnapshotEntryBytes = 8 + (8 * 4) + 3 + 2 + 4 + 1 + 4 + 1 + 4 + 4;
-    size_t offset = 0;
-    uint8_t type = 0;
-    uint32_t playerCount = 0;
-    if (!ReadU8(data, size, offset, type) ||
-        type != static_cast<uint8_t>(PacketType::PlayerSnapshot) ||
-        !ReadU32LE(data, size, offset, out.serverTick) ||
-        !ReadU64LE(data, size, offset, out.selfPlayerId) ||
-        !ReadU32LE(data, size, offset, out.lastProcessedInputTick) ||
-        !ReadU32LE(data, size, offset, playerCount)) {
-        return false;
-    }
-
-    const size_t bytesRemaining = (offset <= size) ? (size - offset) : 0;
-    if (playerCount > (bytesRemaining / kSnapshotEntryBytes)) {
-        return false;
-    }
-
-    out.players.clear();
-    out.players.reserve(playerCount);
-    for (uint32_t i = 0; i < playerCount; ++i) {
-        PlayerSnapshot snapshot{};
-        if (!ReadU64LE(data, size, offset, snapshot.id) ||
-            !ReadF32LE(data, size, offset, snapshot.px) ||
-            !ReadF32LE(data, size, offset, snapshot.py) ||
-            !ReadF32LE(data, size, offset, snapshot.pz) ||
-            !ReadF32LE(data, size, offset, snapshot.vx) ||
-            !ReadF32LE(data, size, offset, snapshot.vy) ||
-            !ReadF32LE(data, size, offset, snapshot.vz) ||
-            !ReadF32LE(data, size, offset, snapshot.yaw) ||
-            !ReadF32LE(data, size, offset, snapshot.pitch) ||
-            !ReadU8(data, size, offset, snapshot.onGround) ||
-            !ReadU8(data, size, offset, snapshot.flyMode) ||
-            !ReadU8(data, size, offset, snapshot.allowFlyMode) ||
-            !ReadU16LE(data, size, offset, snapshot.weaponId) ||
-            !ReadF32LE(data, size, offset, snapshot.health) ||
-            !ReadU8(data, size, offset, snapshot.isAlive) ||
-            !ReadF32LE(data, size, offset, snapshot.respawnSeconds) ||
-            !ReadU8(data, size, offset, snapshot.jumpPressedLastTick) ||
-            !ReadF32LE(data, size, offset, snapshot.timeSinceGrounded) ||
-            !ReadF32LE(data, size, offset, snapshot.jumpBufferTimer)) {
-            return false;
-        }
-        out.players.push_back(snapshot);
-    }
-
-    return offset == size;
-}
-
 bool ParseChunkDataPacket(const uint8_t* data, size_t size, ChunkData& out)
 {
     size_t offset = 0;
@@ -849,6 +798,7 @@ bool ClientNetwork::ConnectTo(std::string_view host, uint16_t port) {
     m_registered = false;
     m_assignedUsername.clear();
     m_allowAutoReconnect = true;
+    ResetSnapshotBaselines();
 
     SteamNetworkingIPAddr addr;
     addr.Clear();
@@ -930,7 +880,10 @@ bool ClientNetwork::SendPlayerInput(const PlayerInput& input)
 {
     if (!IsConnected()) return false;
 
-    const std::vector<uint8_t> out = input.serialize();
+    PlayerInput withAck = input;
+    withAck.hasSnapshotAck = m_hasSnapshotAck ? 1u : 0u;
+    withAck.ackedSnapshotTick = m_snapshotAckTick;
+    const std::vector<uint8_t> out = withAck.serialize();
     const EResult r = SteamNetworkingSockets()->SendMessageToConnection(
         m_conn,
         out.data(),
@@ -1173,6 +1126,7 @@ void ClientNetwork::Shutdown() {
     }
     m_registered = false;
     m_assignedUsername.clear();
+    ResetSnapshotBaselines();
     SetConnectionStatus(ConnectionState::Disconnected, "disconnected");
 
     {
@@ -1297,8 +1251,7 @@ void ClientNetwork::OnMessage(const uint8_t* data, uint32_t size) {
 
     if (static_cast<PacketType>(t) == PacketType::PlayerSnapshot) {
         PlayerSnapshotFrame frame;
-        if (!ParsePlayerSnapshotFramePacket(data, size, frame)) {
-            std::cerr << "[net] malformed PlayerSnapshot\n";
+        if (!DecodePlayerSnapshot(data, size, frame)) {
             return;
         }
 
@@ -1471,7 +1424,7 @@ void ClientNetwork::OnMessage(const uint8_t* data, uint32_t size) {
 
 
 
-bool ClientNetwork::SendShootRequest(uint32_t clientShotId, uint32_t clientTick, uint16_t weaponId,
+bool ClientNetwork::SendShootRequest(uint32_t clientShotId, uint32_t clientTick, uint8_t clientTickFraction, uint16_t weaponId,
     const glm::vec3& pos, const glm::vec3& dir,
     uint32_t seed, uint8_t inputFlags)
 {
@@ -1480,6 +1433,7 @@ bool ClientNetwork::SendShootRequest(uint32_t clientShotId, uint32_t clientTick,
     ShootRequest req;
     req.clientShotId = clientShotId;
     req.clientTick = clientTick;
+    req.clientTickFraction = clientTickFraction;
     req.weaponId = weaponId;
     req.posX = pos.x; req.posY = pos.y; req.posZ = pos.z;
     req.dirX = dir.x; req.dirY = dir.y; req.dirZ = dir.z;
@@ -1578,6 +1532,64 @@ bool ClientNetwork::PopChunkUnload(ChunkUnload& out)
     return true;
 }
 
+bool ClientNetwork::DecodePlayerSnapshot(const uint8_t* data, uint32_t size, PlayerSnapshotFrame& out)
+{
+    namespace Codec = Shared::SnapshotCodec;
+
+    Codec::FrameHeader header;
+    if (!Codec::DecodeFrameHeader(data, size, header)) {
+        std::cerr << "[net] malformed PlayerSnapshot\n";
+        return false;
+    }
+
+    const std::vector<Codec::PlayerState>* baseline = nullptr;
+    if (header.hasBaseline) {
+        const SnapshotBaseline& entry = m_snapshotBaselines[header.baselineTick % kSnapshotBaselineFrames];
+        if (!entry.valid || entry.serverTick != header.baselineTick) {
+            // Only possible after a reconnect race; our next ack moves the server to a frame we have.
+            return false;
+        }
+        baseline = &entry.players;
+    }
+
+    if (!Codec::DecodeFrame(data, size, baseline, header, m_snapshotDecodeScratch)) {
+        std::cerr << "[net] malformed PlayerSnapshot\n";
+        return false;
+    }
+
+    // Keep the first copy of a tick: the server deltas against what it recorded first.
+    SnapshotBaseline& slot = m_snapshotBaselines[header.serverTick % kSnapshotBaselineFrames];
+    if (!slot.valid || slot.serverTick != header.serverTick) {
+        slot.valid = true;
+        slot.serverTick = header.serverTick;
+        slot.players.assign(m_snapshotDecodeScratch.begin(), m_snapshotDecodeScratch.end());
+    }
+    if (!m_hasSnapshotAck || static_cast<int32_t>(header.serverTick - m_snapshotAckTick) > 0) {
+        m_hasSnapshotAck = true;
+        m_snapshotAckTick = header.serverTick;
+    }
+
+    out.serverTick = header.serverTick;
+    out.selfPlayerId = header.selfPlayerId;
+    out.lastProcessedInputTick = header.lastProcessedInputTick;
+    out.players.clear();
+    out.players.reserve(m_snapshotDecodeScratch.size());
+    for (const Codec::PlayerState& state : m_snapshotDecodeScratch) {
+        out.players.push_back(Codec::Dequantize(state, state.id == header.selfPlayerId));
+    }
+    return true;
+}
+
+void ClientNetwork::ResetSnapshotBaselines()
+{
+    for (SnapshotBaseline& entry : m_snapshotBaselines) {
+        entry.valid = false;
+        entry.players.clear();
+    }
+    m_hasSnapshotAck = false;
+    m_snapshotAckTick = 0;
+}
+
 bool ClientNetwork::PopPlayerSnapshot(PlayerSnapshotFrame& out)
 {
     std::lock_guard<std::mutex> lk(m_chunkQueueMutex);
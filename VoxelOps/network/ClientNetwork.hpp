@@ -11,6 +11,7 @@
 #include <string_view>
 #include <cstdint>
 #include <atomic>
+#include <array>
 #include <deque>
 #include <mutex>
 #include <glm/vec3.hpp>
@@ -22,6 +23,7 @@
 #include "../../Shared/network/PacketType.hpp" //for packet types
 
 #include "../../Shared/network/Packets.hpp" //for packet types
+#include "../../Shared/network/SnapshotCodec.hpp"
 
 class ClientNetwork {
 public:
@@ -96,7 +98,7 @@ public:
     int GetPingMs() const noexcept;
 
 
-    bool SendShootRequest(uint32_t clientShotId, uint32_t clientTick, uint16_t weaponId,
+    bool SendShootRequest(uint32_t clientShotId, uint32_t clientTick, uint8_t clientTickFraction, uint16_t weaponId,
         const glm::vec3& pos, const glm::vec3& dir,
         uint32_t seed = 0, uint8_t inputFlags = 0);
 
@@ -126,6 +128,10 @@ private:
 
     // handle messages received from server
     void OnMessage(const uint8_t* data, uint32_t size);
+    // Decodes a PlayerSnapshot against the baseline it names and records it for later deltas.
+    // Returns false (leaving `out` untouched) if the frame is malformed or its baseline is gone.
+    bool DecodePlayerSnapshot(const uint8_t* data, uint32_t size, PlayerSnapshotFrame& out);
+    void ResetSnapshotBaselines();
     bool EnsureClientIdentity();
     void SetConnectionStatus(ConnectionState state, std::string text, bool allowReconnect = true);
 
@@ -138,6 +144,19 @@ private:
     bool m_allowAutoReconnect = true;
     bool m_useTransientIdentity = false;
 
+    // Decoded snapshot states by serverTick, twice the server's history so any baseline it picks
+    // is still here. Touched only from Poll() and SendPlayerInput() on the main thread.
+    struct SnapshotBaseline {
+        bool valid = false;
+        uint32_t serverTick = 0;
+        std::vector<Shared::SnapshotCodec::PlayerState> players;
+    };
+    static constexpr size_t kSnapshotBaselineFrames = 64;
+    std::array<SnapshotBaseline, kSnapshotBaselineFrames> m_snapshotBaselines;
+    std::vector<Shared::SnapshotCodec::PlayerState> m_snapshotDecodeScratch;
+    bool m_hasSnapshotAck = false;
+    uint32_t m_snapshotAckTick = 0;
+
     std::mutex m_chunkQueueMutex;
     std::deque<ChunkData> m_chunkDataQueue;
     std::deque<ChunkDelta> m_chunkDeltaQueue;
@@ -3,11 +3,13 @@
 #include "Raycast.hpp"
 #include "../graphics/ChunkManager.hpp"
 #include "../player/Hitbox.hpp"
+#include "../../Shared/voxel/VoxelRaycast.hpp"
 
 #include <glm/glm.hpp>
 #include <glm/fwd.hpp>
 #include <list>
 #include <iostream>
+#include <vector>
 
 
 
@@ -31,12 +33,33 @@ struct RayShootHit {
 	HitRegion region;         // valid if Type::Player
 };
 
+// Shared::Voxel::Raycast view of the loaded chunk map; unloaded chunks read as air.
+struct ChunkRayWorld {
+	using Chunk = ::Chunk;
+
+	const ChunkManager& chunkManager;
+
+	const Chunk* findChunk(const glm::ivec3& chunkPos) const {
+		const auto& chunks = chunkManager.getChunks();
+		const auto it = chunks.find(chunkPos);
+		return (it != chunks.end()) ? &it->second : nullptr;
+	}
+	uint64_t brickOccupancy(const Chunk& chunk) const { return chunk.brickOccupancy(); }
+	bool isSolid(const Chunk& chunk, int x, int y, int z) const { return chunk.getBlockUnchecked(x, y, z) != BlockID::Air; }
+};
+
 
 class RayManager {
 public:
 	RayManager();
 
-	RayResult rayHasBlockIntersectBatch(std::list<Ray>& rays);
+	// One result per ray, in order.
+	void rayHasBlockIntersectBatch(
+		const std::vector<Ray>& rays,
+		const ChunkManager& chunkManager,
+		float maxDistance,
+		std::vector<RayResult>& outResults
+	);
 	RayResult rayHasBlockIntersectSingle(const Ray& ray, const ChunkManager& chunkManager, float maxDistance); //for block breaking/placing
 
 
@@ -154,7 +154,9 @@ struct Runtime {
     static constexpr size_t InputRedundancyCopies = 1;
     static constexpr double ChunkRequestSendInterval = 0.5; // 2 Hz baseline + immediate on center changes
     static constexpr double ChunkRequestCenterChangeMinInterval = 1.0 / 30.0; // up to 30 Hz on border crossings
-    static constexpr size_t MaxChunkDataApplyPerFrame = 12;
+    static constexpr size_t MaxChunkDataSubmitPerFrame = 64;
+    static constexpr size_t MaxChunkDataDecodesInFlight = 256;
+    static constexpr size_t MaxChunkDataInstallPerFrame = 48;
     static constexpr size_t MaxChunkDeltaApplyPerFrame = 48;
     static constexpr size_t MaxChunkUnloadApplyPerFrame = 64;
     static constexpr int64_t ChunkApplyBudgetUs = 9000;
@@ -32,6 +32,15 @@ void SnapshotInterpolator::PushFrame(const PlayerSnapshotFrame& frame)
         m_hasLatestServerTimeSeconds = true;
     }
 
+    // Our own entry gives the distance that picks each remote player's refresh tier.
+    const auto self = std::lower_bound(
+        frame.players.begin(),
+        frame.players.end(),
+        frame.selfPlayerId,
+        [](const PlayerSnapshot& entry, PlayerID id) { return entry.id < id; }
+    );
+    const bool hasSelf = self != frame.players.end() && self->id == frame.selfPlayerId;
+
     for (const PlayerSnapshot& snapshot : frame.players) {
         if (snapshot.id == frame.selfPlayerId) {
             continue;
@@ -48,7 +57,29 @@ void SnapshotInterpolator::PushFrame(const PlayerSnapshotFrame& frame)
         remote.yawDegrees = snapshot.yaw;
         remote.weaponId = snapshot.weaponId;
         remote.serverTimeSeconds = frameServerTimeSeconds;
-        AddSnapshot(snapshot.id, remote);
+        uint32_t refreshIntervalTicks = 1;
+        if (hasSelf) {
+            const glm::vec3 delta = remote.position - glm::vec3(self->px, self->py, self->pz);
+            refreshIntervalTicks = SnapshotRefreshIntervalTicks(glm::dot(delta, delta));
+        }
+        AddSnapshot(snapshot.id, remote, refreshIntervalTicks);
+    }
+
+    // Frames only carry the players relevant to us (ascending id); anyone missing has left our
+    // area or the server.
+    for (auto it = m_history.begin(); it != m_history.end();) {
+        const auto found = std::lower_bound(
+            frame.players.begin(),
+            frame.players.end(),
+            it->first,
+            [](const PlayerSnapshot& entry, PlayerID id) { return entry.id < id; }
+        );
+        if (found == frame.players.end() || found->id != it->first) {
+            it = m_history.erase(it);
+        }
+        else {
+            ++it;
+        }
     }
 }
 
@@ -61,6 +92,19 @@ bool SnapshotInterpolator::GetRenderTime(double& outRenderTime) const
     return true;
 }
 
+bool SnapshotInterpolator::GetRenderTick(uint32_t& outTick, uint8_t& outFraction) const
+{
+    double renderTime = 0.0;
+    if (!GetRenderTime(renderTime) || renderTime <= 0.0) {
+        return false;
+    }
+    const double ticks = renderTime / kSnapshotTickSeconds;
+    const double wholeTicks = std::floor(ticks);
+    outTick = static_cast<uint32_t>(wholeTicks);
+    outFraction = static_cast<uint8_t>(std::min(255.0, std::floor((ticks - wholeTicks) * 256.0)));
+    return true;
+}
+
 bool SnapshotInterpolator::BuildRemotePlayers(double renderTime, std::vector<InterpolatedPlayer>& outPlayers) const
 {
     outPlayers.clear();
@@ -135,7 +179,7 @@ void SnapshotInterpolator::Clear()
     m_latestServerTimeSeconds = 0.0;
 }
 
-void SnapshotInterpolator::AddSnapshot(PlayerID id, const RemoteSnapshot& snapshot)
+void SnapshotInterpolator::AddSnapshot(PlayerID id, const RemoteSnapshot& snapshot, uint32_t refreshIntervalTicks)
 {
     auto& history = m_history[id];
     for (RemoteSnapshot& existing : history) {
@@ -145,6 +189,23 @@ void SnapshotInterpolator::AddSnapshot(PlayerID id, const RemoteSnapshot& snapsh
         }
     }
 
+    // Distant players are refreshed at a reduced rate and repeat their last state in between.
+    // A repeat is not a new sample; keeping it would stall interpolation at the old position.
+    // Only entries inside the refresh interval can be repeats: an identical sample after it is a
+    // player genuinely standing still, and dropping it would start their next move from a stale
+    // sample.
+    if (!history.empty()) {
+        const RemoteSnapshot& newest = history.back();
+        if (newest.serverTick < snapshot.serverTick &&
+            snapshot.serverTick - newest.serverTick < refreshIntervalTicks &&
+            newest.position == snapshot.position &&
+            newest.velocity == snapshot.velocity &&
+            newest.yawDegrees == snapshot.yawDegrees &&
+            newest.weaponId == snapshot.weaponId) {
+            return;
+        }
+    }
+
     history.push_back(snapshot);
     if (history.size() > m_maxSnapshotsPerPlayer) {
         history.pop_front();
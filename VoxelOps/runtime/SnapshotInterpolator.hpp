@@ -21,6 +21,8 @@ public:
 
     void PushFrame(const PlayerSnapshotFrame& frame);
     bool GetRenderTime(double& outRenderTime) const;
+    // Render time as a server tick plus 1/256ths of a tick, for shot lag compensation.
+    bool GetRenderTick(uint32_t& outTick, uint8_t& outFraction) const;
     bool BuildRemotePlayers(double renderTime, std::vector<InterpolatedPlayer>& outPlayers) const;
     void Clear();
 
@@ -43,5 +45,6 @@ private:
     double m_interpolationDelaySeconds = 0.100;
     size_t m_maxSnapshotsPerPlayer = 32;
 
-    void AddSnapshot(PlayerID id, const RemoteSnapshot& snapshot);
+    // refreshIntervalTicks: the server's refresh interval for this player's interest tier.
+    void AddSnapshot(PlayerID id, const RemoteSnapshot& snapshot, uint32_t refreshIntervalTicks);
 };
@@ -1,19 +1,40 @@
 #include "Chunk.hpp"
 
+#include "../../Shared/voxel/VoxelRaycast.hpp"
+
+namespace {
+const ChunkBlocksRef& sharedAirBlocks() {
+    static const ChunkBlocksRef air = std::make_shared<const ChunkBlockBuffer>(); // value-initialized: BlockID::Air
+    return air;
+}
+}
+
 Chunk::Chunk(glm::ivec3 pos)
-    : position(pos), blocks{}, nonAirCount(0), dirty(true)
+    : position(pos), blocks(sharedAirBlocks()), nonAirCount(0), dirty(true)
 {
-    blocks.fill(BlockID::Air);
 }
 
 BlockID Chunk::getBlock(int x, int y, int z) const noexcept {
     if (!inBounds(x, y, z)) return BlockID::Air;
-    return blocks[idx(x, y, z)];
+    return (*blocks)[idx(x, y, z)];
 }
 
 BlockID Chunk::getBlockUnchecked(int x, int y, int z) const noexcept {
     // caller must ensure coords are in bounds
-    return blocks[idx(x, y, z)];
+    return (*blocks)[idx(x, y, z)];
+}
+
+ChunkBlockBuffer& Chunk::mutableBlocks() {
+    // Other owners are snapshots, which only ever drop their reference from other threads, so a
+    // count of one cannot grow behind our back. The fence pairs with their release on drop.
+    if (ownedBlocks != nullptr && blocks.use_count() == 1) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return *ownedBlocks;
+    }
+    auto copy = std::make_shared<ChunkBlockBuffer>(*blocks);
+    ownedBlocks = copy.get();
+    blocks = std::move(copy);
+    return *ownedBlocks;
 }
 
 void Chunk::setBlock(int x, int y, int z, BlockID id) {
@@ -23,14 +44,15 @@ void Chunk::setBlock(int x, int y, int z, BlockID id) {
     }
 
     int i = idx(x, y, z);
-    BlockID old = blocks[i];
+    BlockID old = (*blocks)[i];
     if (old == id) return; // no-op, don't mark dirty
 
     // update nonAirCount
     if (old == BlockID::Air && id != BlockID::Air) ++nonAirCount;
     else if (old != BlockID::Air && id == BlockID::Air) --nonAirCount;
 
-    blocks[i] = id;
+    mutableBlocks()[i] = id;
+    updateBrickAfterWrite(x, y, z, id);
     dirty = true;
 }
 
@@ -44,28 +66,56 @@ BlockID Chunk::removeBlock(int x, int y, int z) {
     }
 
     int i = idx(x, y, z);
-    BlockID old = blocks[i];
+    BlockID old = (*blocks)[i];
 
     // update nonAirCount
     if (old != BlockID::Air) --nonAirCount; // if the old block is air no need to chenge the nonAirCount
 
 
-    blocks[i] = BlockID::Air;
+    if (old != BlockID::Air) {
+        mutableBlocks()[i] = BlockID::Air;
+        updateBrickAfterWrite(x, y, z, BlockID::Air);
+    }
     dirty = true;
     return old;
 }
 
-void Chunk::copyBlocks(std::array<BlockID, CHUNK_VOLUME>& out) const noexcept {
-    out = blocks;
+void Chunk::updateBrickAfterWrite(int x, int y, int z, BlockID id) noexcept {
+    const uint64_t bit = Shared::Voxel::BrickBit(x, y, z);
+    if (id != BlockID::Air) {
+        brickMask |= bit;
+        return;
+    }
+    const bool stillOccupied = Shared::Voxel::BrickHasSolid(Shared::Voxel::BrickIndex(x, y, z), [this](int bx, int by, int bz) {
+        return (*blocks)[idx(bx, by, bz)] != BlockID::Air;
+    });
+    if (!stillOccupied) brickMask &= ~bit;
 }
 
-void Chunk::overwriteBlocks(const std::array<BlockID, CHUNK_VOLUME>& in) noexcept {
-    blocks = in;
+void Chunk::adoptBlocks(BlockSnapshot snapshot) noexcept {
+    blocks = snapshot.blocks ? std::move(snapshot.blocks) : sharedAirBlocks();
+    ownedBlocks = nullptr;
+    nonAirCount = snapshot.nonAirCount;
+    brickMask = snapshot.brickMask;
+    dirty = false;
+}
+
+void Chunk::adoptBlocks(std::shared_ptr<ChunkBlockBuffer> in) noexcept {
+    if (!in) {
+        adoptBlocks(BlockSnapshot{});
+        return;
+    }
+    const ChunkBlockBuffer& ids = *in;
     nonAirCount = 0;
-    for (const BlockID block : blocks) {
+    for (const BlockID block : ids) {
         if (block != BlockID::Air) {
             ++nonAirCount;
         }
     }
+    brickMask = Shared::Voxel::ComputeBrickOccupancy([&ids](int x, int y, int z) {
+        return ids[idx(x, y, z)] != BlockID::Air;
+    });
+    ownedBlocks = in.get();
+    blocks = std::move(in);
     dirty = false;
 }
@@ -1,7 +1,9 @@
 #pragma once
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <cassert>
+#include <memory>
 #include <mutex>
 #include "Voxel.hpp"
 #include <glm/vec3.hpp>
@@ -10,6 +12,10 @@
 constexpr int CHUNK_SIZE = 16;
 constexpr int CHUNK_VOLUME = CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE;
 
+using ChunkBlockBuffer = std::array<BlockID, CHUNK_VOLUME>;
+// Never written while more than one owner holds it; Chunk copies the buffer before editing a shared one.
+using ChunkBlocksRef = std::shared_ptr<const ChunkBlockBuffer>;
+
 struct AABB {
     glm::vec3 min;
     glm::vec3 max;
@@ -36,10 +42,25 @@ public:
 
     BlockID removeBlock(int x, int y, int z);
 
-    void copyBlocks(std::array<BlockID, CHUNK_VOLUME>& out) const noexcept;
-    void overwriteBlocks(const std::array<BlockID, CHUNK_VOLUME>& in) noexcept;
+    // Voxels at one point in time. Copying it only bumps a reference count, and later edits to the
+    // chunk copy-on-write, so it can be handed to worker threads as is.
+    struct BlockSnapshot {
+        ChunkBlocksRef blocks;
+        uint16_t nonAirCount = 0;
+        uint64_t brickMask = 0;
+    };
+
+    BlockSnapshot snapshotBlocks() const noexcept { return { blocks, nonAirCount, brickMask }; }
+    // Indexed x + CHUNK_SIZE * (y + CHUNK_SIZE * z); invalidated by the next edit.
+    const ChunkBlockBuffer& blockData() const noexcept { return *blocks; }
+    // Shares the snapshot's buffer; the first later edit copies it.
+    void adoptBlocks(BlockSnapshot snapshot) noexcept;
+    // Takes over a freshly filled buffer that nothing else references and recomputes the summaries.
+    void adoptBlocks(std::shared_ptr<ChunkBlockBuffer> in) noexcept;
 
     bool isCompletelyAir() const noexcept { return nonAirCount == 0; }
+    // Bit Shared::Voxel::BrickIndex(x, y, z) is set when that 4x4x4 brick holds a non-air block.
+    uint64_t brickOccupancy() const noexcept { return brickMask; }
 
     glm::ivec3 position;
     std::atomic<bool> dirty = true;
@@ -59,8 +80,13 @@ public:
 
     int8_t sunLitBlocksYvalue[16][16];// [+x -> -x][+z -> -z]
 private:
-    std::array<BlockID, CHUNK_VOLUME> blocks;
+    ChunkBlocksRef blocks;                   // all-air chunks share one buffer until their first edit
+    ChunkBlockBuffer* ownedBlocks = nullptr; // blocks.get() when this chunk allocated the buffer, else nullptr
     uint16_t nonAirCount = 0; // max 4096 (16^3) -> fits uint16_t
+    uint64_t brickMask = 0;
+
+    ChunkBlockBuffer& mutableBlocks();
+    void updateBrickAfterWrite(int x, int y, int z, BlockID id) noexcept;
 
     static inline constexpr int idx(int x, int y, int z) noexcept {
         return x + CHUNK_SIZE * (y + CHUNK_SIZE * z);